@@ -66,6 +66,15 @@
 //---- Use legacy CRC32-adler tables (used before 1.91.6), in order to preserve old .ini data that you cannot afford to invalidate.
 //#define IMGUI_USE_LEGACY_CRC32_ADLER
 
+//---- Use an open-addressing hash index for ImGuiStorage instead of a sorted array (O(1) lookup and insertion instead of O(log N) lookup and O(N) insertion).
+// Pays off for storages holding many thousands of keys (e.g. large multi-selections, huge trees). Pairs are no longer kept sorted by key.
+//#define IMGUI_STORAGE_OPEN_ADDRESSING
+
+//---- Use MurmurHash64A for IDs (ImHashData/ImHashStr) instead of CRC32: 8 bytes per step without needing SSE 4.2.
+// Builds with SSE 4.2 (e.g. /arch:AVX, -msse4.2) already hash 8 bytes per step with CRC32 instructions and produce the same IDs as the table version.
+// This changes every ID: it will invalidate old .ini data (window positions, table settings) once.
+//#define IMGUI_USE_FAST_HASH
+
 //---- Use 32-bit for ImWchar (default is 16-bit) to support Unicode planes 1-16. (e.g. point beyond 0xFFFF like emoticons, dingbats, symbols, shapes, ancient languages, etc...)
 //#define IMGUI_USE_WCHAR32
 
@@ -100,6 +109,13 @@
 // The only purpose of this define is if you want force compilation of the stb_truetype backend ALONG with the FreeType backend.
 //#define IMGUI_ENABLE_STB_TRUETYPE
 
+//---- Rasterize glyphs on worker threads (std::thread) when many are loaded at once, e.g. a legacy backend preloading all glyph ranges, or ImFontAtlasBakedLoadGlyphs().
+// Applies to stb_truetype sources. ImFontAtlas::RasterizerThreads sets the thread count. The atlas comes out identical to a single-threaded build.
+// Also makes ImFontAtlasFlags_AsyncGlyphBaking available, to rasterize glyphs first needed mid-frame on a worker thread.
+// Allocator functions passed to ImGui::SetAllocatorFunctions() must be thread-safe.
+// Enabled here because main.cpp sets ImFontAtlasFlags_AsyncGlyphBaking.
+#define IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER
+
 //---- Define constructor and implicit cast operators to convert back<>forth between your math types and ImVec2/ImVec4.
 // This will be inlined as part of ImVec2 and ImVec4 class declarations.
 /*
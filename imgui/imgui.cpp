@@ -1198,6 +1198,15 @@ IMPLEMENTING SUPPORT for ImGuiBackendFlags_RendererHasTextures:
 #include <TargetConditionals.h>
 #endif
 
+// [Posix] OS specific includes (optional), for ImFileMapReadOnly()
+#if !defined(_WIN32) && !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS) && (defined(__unix__) || defined(__APPLE__))
+#define IMGUI_ENABLE_POSIX_FILE_MAPPING
+#include <fcntl.h>          // open
+#include <sys/mman.h>       // mmap, munmap
+#include <sys/stat.h>       // fstat
+#include <unistd.h>         // close
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (disable: 4127)             // condition expression is constant
@@ -1260,6 +1269,12 @@ static const float NAV_ACTIVATE_HIGHLIGHT_TIMER             = 0.10f;    // Time
 static const float WINDOWS_RESIZE_FROM_EDGES_FEEDBACK_TIMER = 0.04f;    // Reduce visual noise by only highlighting the border after a certain time.
 static const float WINDOWS_MOUSE_WHEEL_SCROLL_LOCK_TIMER    = 0.70f;    // Lock scrolled window (so it doesn't pick child windows that are scrolling through) for a certain time, unless mouse moved.
 
+// CalcTextSize() cache (see ImGuiTextSizeCache)
+static const int TEXT_SIZE_CACHE_MIN_LENGTH                 = 8;        // Shorter text is measured faster than it is hashed and compared
+static const int TEXT_SIZE_CACHE_MAX_ENTRIES                = 16384;    // Stop adding until the next compaction, so text changing every frame can't grow it without bounds
+static const int TEXT_SIZE_CACHE_MAX_UNUSED_FRAMES          = 120;      // Entries unused for longer are dropped...
+static const int TEXT_SIZE_CACHE_COMPACT_FRAMES             = 60;       // ...by a compaction pass running this often
+
 // Tooltip offset
 static const ImVec2 TOOLTIP_DEFAULT_OFFSET_MOUSE = ImVec2(16, 10);      // Multiplied by g.Style.MouseCursorScale
 static const ImVec2 TOOLTIP_DEFAULT_OFFSET_TOUCH = ImVec2(0, -20);      // Multiplied by g.Style.MouseCursorScale
@@ -1338,6 +1353,7 @@ static void             UpdateKeyRoutingTable(ImGuiKeyRoutingTable* rt);
 static void             UpdateFontsNewFrame();
 static void             UpdateFontsEndFrame();
 static void             UpdateTexturesNewFrame();
+static void             UpdateTextSizeCacheNewFrame();
 static void             UpdateTexturesEndFrame();
 static void             UpdateSettings();
 static int              UpdateWindowManualResize(ImGuiWindow* window, int* border_hovered, int* border_held, int resize_grip_count, ImU32 resize_grip_col[4], const ImRect& visibility_rect);
@@ -2288,7 +2304,7 @@ void ImFormatStringToTempBufferV(const char** out_buf, const char** out_buf_end,
     }
 }
 
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
+#if !defined(IMGUI_ENABLE_SSE4_2_CRC) && !defined(IMGUI_USE_FAST_HASH)
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
@@ -2336,6 +2352,47 @@ static const ImU32 GCrc32LookupTable[256] =
 
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+// MurmurHash64A (Austin Appleby, public domain), 8 bytes per step, folded to 32 bits.
+// Used for IDs with IMGUI_USE_FAST_HASH, and regardless for keys over large or throwaway data (e.g. CalcTextSize() cache, font files).
+ImU32 ImHashMurmur64A(const void* data_p, size_t data_size, ImU32 seed)
+{
+    const ImU64 m = 0xC6A4A7935BD1E995ULL;
+    const int r = 47;
+    ImU64 h = (((ImU64)seed << 32) | seed) ^ ((ImU64)data_size * m);
+    const unsigned char* data = (const unsigned char*)data_p;
+    const unsigned char* data_end = data + (data_size & ~(size_t)7);
+    for (; data != data_end; data += 8)
+    {
+        ImU64 k;
+        memcpy(&k, data, 8);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+    if (data_size & 7)
+    {
+        ImU64 tail = 0;
+        memcpy(&tail, data, data_size & 7);
+        h ^= tail;
+        h *= m;
+    }
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return (ImU32)(h ^ (h >> 32));
+}
+
+#ifdef IMGUI_USE_FAST_HASH
+// See imconfig.h. Hashing nothing returns the seed, same as the CRC32 version, so GetID("") is still the parent ID.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
+{
+    if (data_size == 0)
+        return seed;
+    return ImHashMurmur64A(data_p, data_size, seed);
+}
+#else
 // FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
 ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 {
@@ -2348,6 +2405,17 @@ ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
         crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
     return ~crc;
 #else
+#if defined(__x86_64__) || defined(_M_X64)
+    // CRC32 of 8 bytes at once is the same as 8 steps of 1 byte: IDs don't change.
+    ImU64 crc64 = crc;
+    for (; data + 8 <= data_end; data += 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc64 = _mm_crc32_u64(crc64, v);
+    }
+    crc = (ImU32)crc64;
+#endif
     while (data + 4 <= data_end)
     {
         crc = _mm_crc32_u32(crc, *(ImU32*)data);
@@ -2358,9 +2426,32 @@ ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
     return ~crc;
 #endif
 }
+#endif
 
 // Zero-terminated string hash, with support for ### to reset back to seed value
 // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+#if defined(IMGUI_ENABLE_SSE4_2_CRC) || defined(IMGUI_USE_FAST_HASH)
+// Resetting to the seed at each ### means only the part from the last ### contributes, and that part is hashed the same way
+// as ImHashData() does it. So we find the last ### (memchr() to skip to each '#') and hash the rest 8 bytes at a time.
+ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
+{
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const char* data = data_p;
+    const char* data_end = data_p + data_size;
+    const char* contributing = data;
+    while (data_end - data >= 3)
+    {
+        const char* p = (const char*)memchr(data, '#', (size_t)(data_end - data - 2));
+        if (p == NULL)
+            break;
+        if (p[1] == '#' && p[2] == '#')
+            contributing = p;
+        data = p + 1;
+    }
+    return ImHashData(contributing, (size_t)(data_end - contributing), seed);
+}
+#else
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
 // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
@@ -2370,9 +2461,7 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
     seed = ~seed;
     ImU32 crc = seed;
     const unsigned char* data = (const unsigned char*)data_p;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
     const ImU32* crc32_lut = GCrc32LookupTable;
-#endif
     if (data_size != 0)
     {
         while (data_size-- != 0)
@@ -2380,11 +2469,7 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
             unsigned char c = *data++;
             if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
                 crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-#else
-            crc = _mm_crc32_u8(crc, c);
-#endif
         }
     }
     else
@@ -2393,15 +2478,12 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
         {
             if (c == '#' && data[0] == '#' && data[1] == '#')
                 crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-#else
-            crc = _mm_crc32_u8(crc, c);
-#endif
         }
     }
     return ~crc;
 }
+#endif
 
 // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
 // FIXME-OPT: This is not designed to be optimal. Use with care.
@@ -2494,6 +2576,65 @@ void*   ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_f
     return file_data;
 }
 
+// Helper: Map file content read-only, for large files which are only read once (e.g. ImFontAtlasBakedLoadFromFile())
+// Falls back to ImFileLoadToMemory() where the OS doesn't support it. Release with ImFileUnmap().
+const void* ImFileMapReadOnly(const char* filename, size_t* out_file_size)
+{
+    IM_ASSERT(filename && out_file_size);
+    *out_file_size = 0;
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS)
+    const int filename_wsize = ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, NULL, 0);
+    ImVector<wchar_t> filename_wbuf;
+    filename_wbuf.resize(filename_wsize);
+    ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, filename_wbuf.Data, filename_wsize);
+    HANDLE file = ::CreateFileW(filename_wbuf.Data, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+    LARGE_INTEGER file_size;
+    const void* data = NULL;
+    if (::GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0 && (ImU64)file_size.QuadPart <= (ImU64)(size_t)-1)
+        if (HANDLE mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL))
+        {
+            data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            ::CloseHandle(mapping); // The view keeps the mapping alive
+        }
+    ::CloseHandle(file);
+    if (data != NULL)
+        *out_file_size = (size_t)file_size.QuadPart;
+    return data;
+#elif defined(IMGUI_ENABLE_POSIX_FILE_MAPPING)
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    void* data = NULL;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        if ((data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED)
+            data = NULL;
+    close(fd); // The mapping stays valid after closing
+    if (data != NULL)
+        *out_file_size = (size_t)st.st_size;
+    return data;
+#else
+    return ImFileLoadToMemory(filename, "rb", out_file_size);
+#endif
+}
+
+void ImFileUnmap(const void* data, size_t file_size)
+{
+    if (data == NULL)
+        return;
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS)
+    IM_UNUSED(file_size);
+    ::UnmapViewOfFile(data);
+#elif defined(IMGUI_ENABLE_POSIX_FILE_MAPPING)
+    munmap((void*)data, file_size);
+#else
+    IM_UNUSED(file_size);
+    IM_FREE((void*)data);
+#endif
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (ImText* functions)
 //-----------------------------------------------------------------------------
@@ -2556,6 +2697,27 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return wanted;
 }
 
+// Skip printable ASCII (0x20..0x7F), 16 or 32 bytes at a time. Stops at the first control character or UTF-8 lead/continuation byte.
+// Text layout and rendering use this to handle runs of plain ASCII without decoding them or checking for \n and \r.
+const char* ImTextFindNonPrintableAscii(const char* in_text, const char* in_text_end)
+{
+    const char* p = in_text;
+#if defined(__AVX2__)
+    const __m256i limit_32 = _mm256_set1_epi8(0x1F);
+    while (in_text_end - p >= 32 && _mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_loadu_si256((const __m256i*)(const void*)p), limit_32)) == -1)
+        p += 32;
+#endif
+#ifdef IMGUI_ENABLE_SSE
+    // Signed compare: bytes >= 0x80 are negative so they fail along with control characters.
+    const __m128i limit_16 = _mm_set1_epi8(0x1F);
+    while (in_text_end - p >= 16 && _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)(const void*)p), limit_16)) == 0xFFFF)
+        p += 16;
+#endif
+    while (p < in_text_end && (unsigned char)(*p - 0x20) < 0x60)
+        p++;
+    return p;
+}
+
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
@@ -2836,14 +2998,158 @@ static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
 void ImGuiStorage::BuildSortByKey()
 {
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), PairComparerByID);
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    BuildIndex();
+#endif
+}
+
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+// Open-addressing index, SwissTable-style:
+// - Slots are grouped by 16. Each slot has a control byte holding 7 bits of the key hash (or 0x80 when empty) and an index into Data.
+// - A lookup compares the 16 control bytes of a group at once (one SSE2 compare) and only reads Data for bytes that match.
+// - Groups are probed in triangular order (+1, +2, +3...), which visits every group as the group count is a power of two.
+// - ImGuiStorage never removes a single key so there are no tombstones. Load factor is kept at or below 7/8.
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // _BitScanForward
+#endif
+
+static const ImU8 ImGuiStorageCtrl_Empty = 0x80;
+
+static inline ImU32 ImGuiStorageHash(ImGuiID key)
+{
+    // Keys are often hashes already, but not always (e.g. indices stored by ImGuiSelectionBasicStorage): mix them.
+    ImU32 h = key * 0x9E3779B1u;
+    return h ^ (h >> 15);
+}
+
+static inline int ImGuiStorageCountTrailingZeros(ImU32 mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long n;
+    _BitScanForward(&n, mask);
+    return (int)n;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int n = 0;
+    while ((mask & 1) == 0) { mask >>= 1; n++; }
+    return n;
+#endif
+}
+
+// Bit N set when ctrl[N] == v
+static inline ImU32 ImGuiStorageMatchGroup(const ImU8* ctrl, ImU8 v)
+{
+#ifdef IMGUI_ENABLE_SSE
+    return (ImU32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(const void*)ctrl), _mm_set1_epi8((char)v)));
+#else
+    ImU32 mask = 0;
+    for (int n = 0; n < 16; n++)
+        if (ctrl[n] == v)
+            mask |= 1u << n;
+    return mask;
+#endif
+}
+
+// Return index of key in Data, or -1. When missing, *out_free_slot receives the slot an insertion should use (-1 when the index is unallocated).
+static int ImGuiStorageFindIndex(const ImGuiStorage* storage, ImGuiID key, int* out_free_slot)
+{
+    *out_free_slot = -1;
+    if (storage->_Ctrl.Size == 0)
+        return -1;
+    IM_ASSERT(storage->_Slots.Size == storage->_Ctrl.Size && "Data was edited directly without calling BuildIndex()?");
+    const ImU32 hash = ImGuiStorageHash(key);
+    const ImU8 h2 = (ImU8)(hash & 0x7F);
+    const int group_mask = (storage->_Ctrl.Size >> 4) - 1;
+    int group = (int)(hash >> 7) & group_mask;
+    for (int step = 1; ; step++)
+    {
+        const ImU8* ctrl = storage->_Ctrl.Data + group * 16;
+        for (ImU32 match = ImGuiStorageMatchGroup(ctrl, h2); match != 0; match &= match - 1)
+        {
+            const int idx = storage->_Slots.Data[group * 16 + ImGuiStorageCountTrailingZeros(match)];
+            if (storage->Data.Data[idx].key == key)
+                return idx;
+        }
+        if (ImU32 empty = ImGuiStorageMatchGroup(ctrl, ImGuiStorageCtrl_Empty))
+        {
+            *out_free_slot = group * 16 + ImGuiStorageCountTrailingZeros(empty);
+            return -1;
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+static void ImGuiStorageBuildIndex(ImGuiStorage* storage, int slots_count)
+{
+    storage->_Ctrl.resize(slots_count);
+    storage->_Slots.resize(slots_count);
+    memset(storage->_Ctrl.Data, ImGuiStorageCtrl_Empty, (size_t)slots_count);
+    for (int idx = 0; idx < storage->Data.Size; idx++)
+    {
+        const ImGuiID key = storage->Data.Data[idx].key;
+        int slot;
+        if (ImGuiStorageFindIndex(storage, key, &slot) != -1)
+            continue; // Duplicate key pushed directly into Data: first one wins, as it would for a lookup.
+        storage->_Ctrl.Data[slot] = (ImU8)(ImGuiStorageHash(key) & 0x7F);
+        storage->_Slots.Data[slot] = idx;
+    }
+}
+
+// Rebuild the index from Data. Keeps the current slot count unless Data outgrew it.
+void ImGuiStorage::BuildIndex()
+{
+    int slots_count = ImMax(_Ctrl.Size, 16);
+    while (Data.Size * 8 > slots_count * 7)
+        slots_count *= 2;
+    ImGuiStorageBuildIndex(this, slots_count);
+}
+
+ImGuiStoragePair* ImStorageFind(ImGuiStorage* storage, ImGuiID key)
+{
+    int free_slot;
+    const int idx = ImGuiStorageFindIndex(storage, key, &free_slot);
+    return (idx != -1) ? &storage->Data.Data[idx] : NULL;
 }
 
+// Return pair for key, appending 'new_pair' if missing.
+static ImGuiStoragePair* ImStorageFindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& new_pair)
+{
+    int free_slot;
+    const int idx = ImGuiStorageFindIndex(storage, new_pair.key, &free_slot);
+    if (idx != -1)
+        return &storage->Data.Data[idx];
+    if (free_slot == -1 || (storage->Data.Size + 1) * 8 > storage->_Ctrl.Size * 7)
+    {
+        ImGuiStorageBuildIndex(storage, storage->_Ctrl.Size ? storage->_Ctrl.Size * 2 : 16);
+        ImGuiStorageFindIndex(storage, new_pair.key, &free_slot);
+    }
+    storage->_Ctrl.Data[free_slot] = (ImU8)(ImGuiStorageHash(new_pair.key) & 0x7F);
+    storage->_Slots.Data[free_slot] = storage->Data.Size;
+    storage->Data.push_back(new_pair);
+    return &storage->Data.back();
+}
+#else
+ImGuiStoragePair* ImStorageFind(ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + storage->Data.Size, key);
+    return (it != storage->Data.Data + storage->Data.Size && it->key == key) ? it : NULL;
+}
+
+// Return pair for key, inserting 'new_pair' at its sorted position if missing.
+static ImGuiStoragePair* ImStorageFindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& new_pair)
+{
+    ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + storage->Data.Size, new_pair.key);
+    if (it == storage->Data.Data + storage->Data.Size || it->key != new_pair.key)
+        it = storage->Data.insert(it, new_pair);
+    return it;
+}
+#endif
+
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = ImStorageFind(const_cast<ImGuiStorage*>(this), key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2853,27 +3159,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = ImStorageFind(const_cast<ImGuiStorage*>(this), key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = ImStorageFind(const_cast<ImGuiStorage*>(this), key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &ImStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2883,28 +3182,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &ImStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &ImStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_i = val;
+    ImStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2914,20 +3202,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_f = val;
+    ImStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_p = val;
+    ImStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -4541,6 +4821,7 @@ void ImGui::GcCompactTransientMiscBuffers()
     g.MultiSelectTempDataStacked = 0;
     g.MultiSelectTempData.clear_destruct();
     TableGcCompactSettings();
+    g.TextSizeCache.Clear();
     for (ImFontAtlas* atlas : g.FontAtlases)
         atlas->CompactCache();
 }
@@ -5438,6 +5719,7 @@ void ImGui::NewFrame()
     // Setup current font and draw list shared data
     SetupDrawListSharedData();
     UpdateFontsNewFrame();
+    UpdateTextSizeCacheNewFrame();
 
     g.WithinFrameScope = true;
 
@@ -6063,6 +6345,22 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
+
+    // Most labels are the same as last frame: look them up first
+    ImGuiTextSizeCache& cache = g.TextSizeCache;
+    ImGuiID cache_key = 0;
+    if (cache.Enabled)
+    {
+        if (text_display_end == NULL)
+            text_display_end = text + ImStrlen(text);
+        if (text_display_end - text >= TEXT_SIZE_CACHE_MIN_LENGTH)
+        {
+            cache_key = TextSizeCacheKey(font, font_size, wrap_width, text, text_display_end);
+            if (const ImVec2* cached_size = TextSizeCacheFind(cache_key, font, font_size, wrap_width, text, text_display_end))
+                return *cached_size;
+        }
+    }
+
     ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
@@ -6072,9 +6370,142 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     // - https://embarkstudios.github.io/rust-gpu/api/src/libm/math/ceilf.rs.html
     text_size.x = IM_TRUNC(text_size.x + 0.99999f);
 
+    if (cache_key != 0)
+        TextSizeCacheAdd(cache_key, font, font_size, wrap_width, text, text_display_end, text_size);
     return text_size;
 }
 
+ImGuiID ImGui::TextSizeCacheKey(ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end)
+{
+    struct { ImFont* Font; float FontSize; float WrapWidth; } params;
+    memset(&params, 0, sizeof(params)); // Clear padding
+    params.Font = font;
+    params.FontSize = font_size;
+    params.WrapWidth = wrap_width;
+    return ImHashMurmur64A(text, (size_t)(text_end - text), ImHashMurmur64A(&params, sizeof(params), 0));
+}
+
+// Open addressing with linear probing over ImGuiTextSizeCache::Slots. Returns the slot holding 'key', or the empty slot ending its probe sequence.
+static int TextSizeCacheFindSlot(const ImGuiTextSizeCache& cache, ImGuiID key)
+{
+    const int mask = cache.Slots.Size - 1;
+    for (int slot = (int)(key & mask); ; slot = (slot + 1) & mask)
+    {
+        const int entry_idx = cache.Slots.Data[slot] - 1;
+        if (entry_idx < 0 || cache.Entries.Data[entry_idx].Key == key)
+            return slot;
+    }
+}
+
+// Size the index for at least 'entries_count' entries at <= 50% load, and fill it from Entries.
+static void TextSizeCacheBuildIndex(ImGuiTextSizeCache& cache, int entries_count)
+{
+    int slots_count = 64;
+    while (slots_count < entries_count * 2)
+        slots_count *= 2;
+    cache.Slots.resize(slots_count);
+    memset(cache.Slots.Data, 0, (size_t)cache.Slots.size_in_bytes());
+    for (int n = 0; n < cache.Entries.Size; n++)
+        cache.Slots[TextSizeCacheFindSlot(cache, cache.Entries[n].Key)] = n + 1;
+}
+
+// Return NULL on a miss. Counts hits and misses for the Metrics window.
+const ImVec2* ImGui::TextSizeCacheFind(ImGuiID key, ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTextSizeCache& cache = g.TextSizeCache;
+
+    // Sizes measured before glyph metrics changed can't be trusted anymore
+    ImFontAtlas* atlas = font->OwnerAtlas;
+    if (cache.Atlas != atlas || cache.AtlasMetricsVersion != atlas->MetricsVersion)
+    {
+        cache.Clear();
+        cache.Atlas = atlas;
+        cache.AtlasMetricsVersion = atlas->MetricsVersion;
+    }
+
+    const int entry_idx = cache.Slots.Size ? cache.Slots[TextSizeCacheFindSlot(cache, key)] - 1 : -1;
+    const int text_len = (int)(text_end - text);
+    if (entry_idx >= 0)
+    {
+        ImGuiTextSizeCacheEntry& entry = cache.Entries[entry_idx];
+        if (entry.Font == font && entry.FontSize == font_size && entry.WrapWidth == wrap_width && entry.TextLen == text_len && memcmp(cache.TextBuf.Data + entry.TextOffset, text, (size_t)text_len) == 0)
+        {
+            entry.LastUsedFrame = g.FrameCount;
+            cache.HitsThisFrame++;
+            return &entry.Size;
+        }
+    }
+    cache.MissesThisFrame++;
+    return NULL;
+}
+
+void ImGui::TextSizeCacheAdd(ImGuiID key, ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end, const ImVec2& size)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTextSizeCache& cache = g.TextSizeCache;
+    if (cache.Atlas != font->OwnerAtlas || cache.AtlasMetricsVersion != font->OwnerAtlas->MetricsVersion)
+        return; // Measuring just loaded glyphs which discarded something: don't store, next lookup will clear the cache.
+
+    // On a hash collision the newer text takes the entry over. Its old text stays in TextBuf until the next compaction.
+    if ((cache.Entries.Size + 1) * 2 > cache.Slots.Size)
+        TextSizeCacheBuildIndex(cache, cache.Entries.Size + 1);
+    const int slot = TextSizeCacheFindSlot(cache, key);
+    int entry_idx = cache.Slots[slot] - 1;
+    if (entry_idx < 0)
+    {
+        if (cache.Entries.Size >= TEXT_SIZE_CACHE_MAX_ENTRIES)
+            return;
+        entry_idx = cache.Entries.Size;
+        cache.Entries.push_back(ImGuiTextSizeCacheEntry());
+        cache.Slots[slot] = entry_idx + 1;
+    }
+    ImGuiTextSizeCacheEntry& entry = cache.Entries[entry_idx];
+    entry.Key = key;
+    entry.Font = font;
+    entry.FontSize = font_size;
+    entry.WrapWidth = wrap_width;
+    entry.TextOffset = cache.TextBuf.Size;
+    entry.TextLen = (int)(text_end - text);
+    entry.LastUsedFrame = g.FrameCount;
+    entry.Size = size;
+    cache.TextBuf.resize(cache.TextBuf.Size + entry.TextLen);
+    memcpy(cache.TextBuf.Data + entry.TextOffset, text, (size_t)entry.TextLen);
+}
+
+// Publish counters and periodically drop entries unused for TEXT_SIZE_CACHE_MAX_UNUSED_FRAMES.
+// Compaction rebuilds entries, text and index in one go.
+static void ImGui::UpdateTextSizeCacheNewFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTextSizeCache& cache = g.TextSizeCache;
+    cache.HitsLastFrame = cache.HitsThisFrame;
+    cache.MissesLastFrame = cache.MissesThisFrame;
+    cache.HitsTotal += (ImU64)cache.HitsThisFrame;
+    cache.MissesTotal += (ImU64)cache.MissesThisFrame;
+    cache.HitsThisFrame = cache.MissesThisFrame = 0;
+    if (!cache.Enabled && cache.Entries.Size > 0)
+        cache.Clear();
+    if (g.FrameCount - cache.LastCompactFrame < TEXT_SIZE_CACHE_COMPACT_FRAMES)
+        return;
+    cache.LastCompactFrame = g.FrameCount;
+
+    ImVector<ImGuiTextSizeCacheEntry> entries;
+    ImVector<char> text_buf;
+    for (const ImGuiTextSizeCacheEntry& entry : cache.Entries)
+    {
+        if (g.FrameCount - entry.LastUsedFrame > TEXT_SIZE_CACHE_MAX_UNUSED_FRAMES)
+            continue;
+        entries.push_back(entry);
+        entries.back().TextOffset = text_buf.Size;
+        text_buf.resize(text_buf.Size + entry.TextLen);
+        memcpy(text_buf.Data + entries.back().TextOffset, cache.TextBuf.Data + entry.TextOffset, (size_t)entry.TextLen);
+    }
+    cache.Entries.swap(entries);
+    cache.TextBuf.swap(text_buf);
+    TextSizeCacheBuildIndex(cache, cache.Entries.Size);
+}
+
 // Find window given position, search front-to-back
 // - Typically write output back to g.HoveredWindow and g.HoveredWindowUnderMovingWindow.
 // - FIXME: Note that we have an inconsequential lag here: OuterRectClipped is updated in Begin(), so windows moved programmatically
@@ -6445,7 +6876,7 @@ void ImGui::EndChild()
     g.WithinEndChildID = child_window->ID;
     ImVec2 child_size = child_window->Size;
     End();
-    if (child_window->BeginCount == 1)
+    if (child_window->BeginCount == 1 && !child_window->SkipRefresh) // A child reusing its contents has a parent doing the same, with nothing to lay out
     {
         ImGuiWindow* parent_window = g.CurrentWindow;
         ImRect bb(parent_window->DC.CursorPos, parent_window->DC.CursorPos + child_size);
@@ -7243,30 +7674,122 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
     }
 }
 
+// [EXPERIMENTAL] Hash of what a window's previous contents depend on besides its own widgets, for ImGuiWindowRefreshFlags_RefreshOnChange:
+// the window geometry and last layout, style, fonts, display size, focus, nav and popups, plus the hash of user state passed to SetNextWindowRefreshPolicy().
+static ImGuiID CalcWindowSkipRefreshHash(ImGuiWindow* window, ImGuiID content_hash)
+{
+    ImGuiContext& g = *GImGui;
+    struct
+    {
+        ImGuiID             ContentHash;
+        ImGuiWindowFlags    Flags;
+        ImVec2              Pos, SizeFull, Scroll, ScrollTarget, ContentSize, CursorMaxPos, DisplaySize;
+        ImFont*             Font;
+        float               FontSize;
+        ImTextureRef        FontTexRef;
+        ImVec2              FontTexUvScale;
+        int                 FontMetricsVersion;
+        ImGuiItemFlags      ItemFlags;
+        ImGuiID             NavId;
+        int                 OpenPopupCount;
+        bool                Collapsed, Focused, Hovered, Active, NavCursorVisible;
+    } state;
+    memset(&state, 0, sizeof(state)); // Padding is hashed too
+    state.ContentHash = content_hash;
+    state.Flags = window->Flags;
+    state.Pos = window->Pos;
+    state.SizeFull = window->SizeFull;
+    state.Scroll = window->Scroll;
+    state.ScrollTarget = window->ScrollTarget;
+    state.ContentSize = window->ContentSize;
+    state.CursorMaxPos = window->DC.CursorMaxPos - window->Pos; // Contents measured last frame: a change means the layout derived from it (scrollbars, auto-fit) needs another pass
+    state.DisplaySize = g.IO.DisplaySize;
+    state.Font = g.Font;
+    state.FontSize = g.FontSize;
+    state.FontTexRef = g.IO.Fonts->TexRef;
+    state.FontTexUvScale = g.IO.Fonts->TexUvScale;
+    state.FontMetricsVersion = g.IO.Fonts->MetricsVersion;
+    state.ItemFlags = g.CurrentItemFlags;
+    state.OpenPopupCount = g.OpenPopupStack.Size;
+    state.Collapsed = window->Collapsed;
+    state.Focused = g.NavWindow && g.NavWindow->RootWindow == window->RootWindow;
+    state.NavId = state.Focused ? g.NavId : 0;
+    state.NavCursorVisible = state.Focused && g.NavCursorVisible;
+    state.Hovered = g.HoveredWindow && (g.HoveredWindow->RootWindow == window->RootWindow || ImGui::IsWindowWithinBeginStackOf(g.HoveredWindow->RootWindow, window));
+    state.Active = (g.ActiveId != 0 && g.ActiveIdWindow && g.ActiveIdWindow->RootWindow == window->RootWindow) || (g.MovingWindow && g.MovingWindow->RootWindow == window->RootWindow);
+    return ImHashData(&g.Style, sizeof(g.Style), ImHashData(&state, sizeof(state), 0));
+}
+
+// [EXPERIMENTAL] Refresh conditions checked every frame, besides the inputs hash of ImGuiWindowRefreshFlags_RefreshOnChange.
+static bool IsWindowRefreshNeeded(ImGuiWindow* window, ImGuiWindowRefreshFlags refresh_flags)
+{
+    ImGuiContext& g = *GImGui;
+    if (window->Appearing) // If currently appearing
+        return true;
+    if (window->Hidden) // If was hidden (previous frame)
+        return true;
+    const bool hovered = g.HoveredWindow && (window->RootWindow == g.HoveredWindow->RootWindow || ImGui::IsWindowWithinBeginStackOf(g.HoveredWindow->RootWindow, window));
+    const bool focused = g.NavWindow && (window->RootWindow == g.NavWindow->RootWindow || ImGui::IsWindowWithinBeginStackOf(g.NavWindow->RootWindow, window));
+    if ((refresh_flags & ImGuiWindowRefreshFlags_RefreshOnHover) && hovered)
+        return true;
+    if ((refresh_flags & ImGuiWindowRefreshFlags_RefreshOnFocus) && focused)
+        return true;
+    if (refresh_flags & ImGuiWindowRefreshFlags_RefreshOnChange)
+    {
+        // Widgets react to mouse and keyboard without anything else changing, so refresh while the window is interacted with.
+        if (hovered || (g.ActiveId != 0 && g.ActiveIdWindow && g.ActiveIdWindow->RootWindow == window->RootWindow))
+            return true;
+        if (g.MovingWindow || g.NavWindowingTarget || g.DragDropActive || window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0)
+            return true;
+        if (focused)
+            for (const ImGuiInputEvent& e : g.InputEventsTrail)
+                if (e.Type == ImGuiInputEventType_Key || e.Type == ImGuiInputEventType_Text)
+                    return true;
+
+        // Glyphs drawn blank while rasterized by ImFontAtlasFlags_AsyncGlyphBaking need a redraw once their pixels land in the texture.
+        ImFontAtlas* atlas = g.IO.Fonts;
+        if (atlas->RendererHasTextures && ((atlas->TexData && atlas->TexData->Status == ImTextureStatus_WantUpdates) || ImFontAtlasAsyncGlyphsGetPendingCount(atlas) > 0))
+            return true;
+    }
+    return false;
+}
+
 // [EXPERIMENTAL] Called by Begin(). NextWindowData is valid at this point.
 // This is designed as a toy/test-bed for
 void ImGui::UpdateWindowSkipRefresh(ImGuiWindow* window)
 {
     ImGuiContext& g = *GImGui;
     window->SkipRefresh = false;
-    if ((g.NextWindowData.HasFlags & ImGuiNextWindowDataFlags_HasRefreshPolicy) == 0)
-        return;
-    if (g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_TryToAvoidRefresh)
+
+    // Child windows of a window that reuses its contents reuse theirs too: refreshing them would lay them out from the parent's stale cursor and register them twice.
+    if ((window->Flags & ImGuiWindowFlags_ChildWindow) && !(window->Flags & ImGuiWindowFlags_Popup) && window->ParentWindow && window->ParentWindow->SkipRefresh)
     {
-        // FIXME-IDLE: Tests for e.g. mouse clicks or keyboard while focused.
-        if (window->Appearing) // If currently appearing
-            return;
-        if (window->Hidden) // If was hidden (previous frame)
-            return;
-        if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnHover) && g.HoveredWindow)
-            if (window->RootWindow == g.HoveredWindow->RootWindow || IsWindowWithinBeginStackOf(g.HoveredWindow->RootWindow, window))
-                return;
-        if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnFocus) && g.NavWindow)
-            if (window->RootWindow == g.NavWindow->RootWindow || IsWindowWithinBeginStackOf(g.NavWindow->RootWindow, window))
-                return;
         window->DrawList = NULL;
         window->SkipRefresh = true;
+        return;
+    }
+
+    if ((g.NextWindowData.HasFlags & ImGuiNextWindowDataFlags_HasRefreshPolicy) == 0)
+        return;
+    if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_TryToAvoidRefresh) == 0 || window->BeginCount > 0)
+        return;
+
+    // The stored hash must always describe the last refreshed frame, so update it before any other test
+    bool inputs_changed = false;
+    if (g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnChange)
+    {
+        const ImGuiID hash = CalcWindowSkipRefreshHash(window, g.NextWindowData.RefreshContentHashVal);
+        inputs_changed = (hash != window->SkipRefreshHash);
+        window->SkipRefreshHash = hash;
+    }
+    if (inputs_changed || IsWindowRefreshNeeded(window, g.NextWindowData.RefreshFlagsVal))
+    {
+        window->SkipRefreshMisses++;
+        return;
     }
+    window->SkipRefreshHits++;
+    window->DrawList = NULL;
+    window->SkipRefresh = true;
 }
 
 static void SetWindowActiveForSkipRefresh(ImGuiWindow* window)
@@ -8581,11 +9104,13 @@ void ImGui::SetNextWindowBgAlpha(float alpha)
 }
 
 // This is experimental and meant to be a toy for exploring a future/wider range of features.
-void ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags)
+// With ImGuiWindowRefreshFlags_RefreshOnChange, 'content_hash' must change whenever the user state the window displays changes (e.g. hash it with ImHashData()).
+void ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags, ImGuiID content_hash)
 {
     ImGuiContext& g = *GImGui;
     g.NextWindowData.HasFlags |= ImGuiNextWindowDataFlags_HasRefreshPolicy;
     g.NextWindowData.RefreshFlagsVal = flags;
+    g.NextWindowData.RefreshContentHashVal = content_hash;
 }
 
 ImDrawList* ImGui::GetWindowDrawList()
@@ -16581,6 +17106,22 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             TreePop();
         }
 
+    // Details for CalcTextSize() cache
+    ImGuiTextSizeCache& text_size_cache = g.TextSizeCache;
+    if (TreeNode("TextSizeCache", "Text size cache (%d entries)", text_size_cache.Entries.Size))
+    {
+        Checkbox("Enabled", &text_size_cache.Enabled);
+        SameLine();
+        if (SmallButton("Clear"))
+            text_size_cache.Clear();
+        const int lookups_last_frame = text_size_cache.HitsLastFrame + text_size_cache.MissesLastFrame;
+        const ImU64 lookups_total = text_size_cache.HitsTotal + text_size_cache.MissesTotal;
+        Text("Last frame: %d hits, %d misses (%.1f%% hit rate)", text_size_cache.HitsLastFrame, text_size_cache.MissesLastFrame, lookups_last_frame ? 100.0f * text_size_cache.HitsLastFrame / lookups_last_frame : 0.0f);
+        Text("Total: %" IM_PRIu64 " hits, %" IM_PRIu64 " misses (%.1f%% hit rate)", text_size_cache.HitsTotal, text_size_cache.MissesTotal, lookups_total ? 100.0 * (double)text_size_cache.HitsTotal / (double)lookups_total : 0.0);
+        Text("Memory: %d bytes of text, %d bytes of entries", text_size_cache.TextBuf.Size, text_size_cache.Entries.size_in_bytes() + text_size_cache.Slots.size_in_bytes());
+        TreePop();
+    }
+
     // Details for Popups
     if (TreeNode("Popups", "Popups (%d)", g.OpenPopupStack.Size))
     {
@@ -17464,6 +18005,7 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
     BulletText("Scroll: (%.2f/%.2f,%.2f/%.2f) Scrollbar:%s%s", window->Scroll.x, window->ScrollMax.x, window->Scroll.y, window->ScrollMax.y, window->ScrollbarX ? "X" : "", window->ScrollbarY ? "Y" : "");
     BulletText("Active: %d/%d, WriteAccessed: %d, BeginOrderWithinContext: %d", window->Active, window->WasActive, window->WriteAccessed, (window->Active || window->WasActive) ? window->BeginOrderWithinContext : -1);
     BulletText("Appearing: %d, Hidden: %d (CanSkip %d Cannot %d), SkipItems: %d", window->Appearing, window->Hidden, window->HiddenFramesCanSkipItems, window->HiddenFramesCannotSkipItems, window->SkipItems);
+    BulletText("SkipRefresh: %d, Reused: %d frames, Redrawn: %d frames", window->SkipRefresh, window->SkipRefreshHits, window->SkipRefreshMisses);
     for (int layer = 0; layer < ImGuiNavLayer_COUNT; layer++)
     {
         ImRect r = window->NavRectRel[layer];
@@ -2772,11 +2772,22 @@ struct ImGuiStorage
 {
     // [Internal]
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    // [Internal] Open-addressing index over Data (see imconfig.h). Pairs in Data are kept in insertion order, not sorted.
+    // Code editing Data directly must call BuildIndex() afterwards.
+    ImVector<ImU8>                  _Ctrl;          // One control byte per slot: 0x80 = empty, otherwise the low 7 bits of the key hash
+    ImVector<int>                   _Slots;         // Index into Data, per slot
+    IMGUI_API void      BuildIndex();
+#endif
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N) (O(1) with IMGUI_STORAGE_OPEN_ADDRESSING)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    void                Clear() { Data.clear(); _Ctrl.clear(); _Slots.clear(); }
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -3606,6 +3617,7 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_AsyncGlyphBaking   = 1 << 3,   // Rasterize glyphs first needed during a frame on a worker thread, instead of stalling that frame. They are laid out right away but drawn blank until a following frame. Requires IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER and ImGuiBackendFlags_RendererHasTextures, ignored otherwise.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3723,6 +3735,7 @@ struct ImFontAtlas
     int                         TexMinHeight;       // Minimum desired texture height. Must be a power of two. Default to 128.
     int                         TexMaxWidth;        // Maximum desired texture width. Must be a power of two. Default to 8192.
     int                         TexMaxHeight;       // Maximum desired texture height. Must be a power of two. Default to 8192.
+    int                         RasterizerThreads;  // Threads rasterizing glyphs loaded in bulk, e.g. when a legacy backend preloads all glyph ranges. 0 = one per hardware thread. Only used with IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
 
     // Output
@@ -3748,6 +3761,7 @@ struct ImFontAtlas
     ImVec4                      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];  // UVs for baked anti-aliased lines
     int                         TexNextUniqueID;    // Next value to be stored in TexData->UniqueID
     int                         FontNextUniqueID;   // Next value to be stored in ImFont->FontID
+    int                         MetricsVersion;     // Bumped whenever glyph metrics may have changed (bakes or glyphs discarded, sources added, builder destroyed). Lets callers cache text measurements.
     ImVector<ImDrawListSharedData*> DrawListSharedDatas; // List of users for this atlas. Typically one per Dear ImGui context.
     ImFontAtlasBuilder*         Builder;            // Opaque interface to our data that doesn't need to be public and may be discarded when rebuilding.
     const ImFontLoader*         FontLoader;         // Font loader opaque interface (default to use FreeType when IMGUI_ENABLE_FREETYPE is defined, otherwise default to use stb_truetype). Use SetFontLoader() to change this at runtime.
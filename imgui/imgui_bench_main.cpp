@@ -0,0 +1,983 @@
+// Micro-benchmarks for the Dear ImGui internals the app leans on. Headless:
+// no window, device or ImGui context is created.
+//
+//   g++ -std=c++17 -O2 imgui_bench_main.cpp imgui.cpp imgui_draw.cpp imgui_widgets.cpp imgui_tables.cpp
+//       -o desainin-imgui-bench
+//
+//   desainin-imgui-bench storage [--keys 10000,100000,1000000]
+//   desainin-imgui-bench hash [--labels 1000000]
+//   desainin-imgui-bench text [--rows 5000] [--frames 300]
+//   desainin-imgui-bench layout [--mb 16]
+//   desainin-imgui-bench atlas [--font file.ttf] [--size 16] [--threads 0]
+//   desainin-imgui-bench fontcache [--font file.ttf] [--size 16] [--cache fontcache.bin]
+//   desainin-imgui-bench glyphs [--font file.ttf] [--size 16] [--frames 1000]
+//   desainin-imgui-bench convert [--vertices 200000]
+//   desainin-imgui-bench refresh [--rows 5000] [--frames 600]
+//
+// storage times ImGuiStorage at each key count: bulk build (push + sort),
+// lookups that hit and miss, Get*Ref on existing keys, and inserting 1000
+// new keys one by one into the full storage. Build once as is and once with
+// -DIMGUI_STORAGE_OPEN_ADDRESSING to compare the sorted array against the
+// hashed index; the first line says which one is running.
+//
+// hash checks ImHashStr/ImHashData and then measures them. The checks cover
+// the ### rule (only the part from the last ### counts), sized and
+// zero-terminated calls agreeing, and, for the CRC32 builds, that IDs match
+// a plain byte-at-a-time CRC32 so .ini data stays valid. Throughput is timed
+// on list-row labels against that byte-at-a-time loop, and collisions are
+// counted over --labels distinct labels of several shapes next to the number
+// a perfect 32-bit hash would give. Add -msse4.2 or -DIMGUI_USE_FAST_HASH to
+// try the other hash paths.
+//
+// text runs headless frames shaped like the editor's order list: --rows
+// Selectable() order labels in a 250 px child, most of them scrolled out of
+// view but still measured every frame. It reports ms per frame with the
+// CalcTextSize() cache off and on, plus the cache hit rate.
+//
+// layout feeds --mb megabytes of text straight to ImFont, around the text
+// size cache, and reports MB/s for CalcTextSizeA() unwrapped and wrapped to
+// 250 px, CalcWordWrapPosition() and RenderText(). The corpora are order
+// list labels, wrapped order descriptions, and the same descriptions with
+// accented and CJK words mixed in. Build it against two trees to compare
+// text layout changes.
+//
+// atlas builds a font atlas the way a backend without dynamic textures does,
+// preloading Latin, Latin Extended, punctuation, kana and CJK ideographs at
+// --size px from --font (the built-in font when omitted), first on one
+// thread and then on --threads (0: one per hardware thread). It reports the
+// best of three build times and checks both atlases are identical. Add
+// -DIMGUI_ENABLE_THREADED_GLYPH_RASTERIZER to get worker threads.
+//
+// fontcache times startup the way the app does it, with a backend that
+// creates textures on demand: context, --font at --size px, and the first
+// frames of the order list, until the texture is ready. Cold starts rasterize
+// every glyph and save the baked font to --cache; warm starts load it back
+// first. It reports the best of five of each, the cache load and save times,
+// and checks warm starts end up with the same glyphs and texture.
+//
+// glyphs runs --frames frames of the order list, paced at 250 Hz, while
+// customer names with characters not seen before keep appearing: accented
+// Latin, Greek, Cyrillic and CJK, whichever the font has. It reports frame
+// times and hitches per 1000 frames (frames over twice the median) with
+// glyphs rasterized inside the frame and with ImFontAtlasFlags_AsyncGlyphBaking,
+// plus how many glyphs were drawn blank for a frame. Add
+// -DIMGUI_ENABLE_THREADED_GLYPH_RASTERIZER to get the async mode.
+//
+// convert checks and times the DX9 backend's upload conversions from
+// imgui_impl_dx9_convert.h: ImDrawVert to the fixed-function vertex, split
+// into draw lists of random sizes so every tail length is hit, and RGBA to
+// BGRA texture rows. Both are compared bit for bit with the per-element
+// loops the backend used before, then timed against them. Build once as is
+// (SSE2), once with -mavx2 and once with -DIMGUI_DISABLE_SSE to compare the
+// paths; the first line says which one is running.
+//
+// refresh runs --frames editor menu frames, the --rows order list plus a few
+// lines, with the mouse away from the window and the selection moving every
+// 50 frames. It reports ms per frame redrawing every frame and with
+// ImGuiWindowRefreshFlags_RefreshOnChange, where the window's draw list is
+// reused while nothing it shows changed, with the window's reused and redrawn
+// frame counts. Every frame's draw data is checked to be identical in both.
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "imgui.h"
+#include "imgui_impl_dx9_convert.h"
+#include "imgui_internal.h"
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static const int InsertCount = 1000;
+static const size_t LookupsPerRound = 2000000;
+static volatile long long sink;     // keeps lookup results alive
+
+static double secondsSince(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+static bool parseCounts(const char* text, vector<int>& counts) {
+    counts.clear();
+    for (const char* p = text; *p;) {
+        char* end;
+        long n = strtol(p, &end, 10);
+        if (end == p || n <= 0) return false;
+        counts.push_back((int)n);
+        p = (*end == ',') ? end + 1 : end;
+        if (*end != ',' && *end != '\0') return false;
+    }
+    return !counts.empty();
+}
+
+// Keys look like real IDs: hashes of distinct labels. CRC32 collides now and
+// then at a million labels, so duplicates are dropped until count are unique.
+static vector<ImGuiID> makeKeys(size_t count) {
+    vector<ImGuiID> keys;
+    for (size_t i = 0; keys.size() < count; ) {
+        for (; keys.size() < count; ++i) {
+            char label[32];
+            int len = snprintf(label, sizeof(label), "item%zu", i);
+            keys.push_back(ImHashData(label, (size_t)len, 0x1234));
+        }
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    }
+    return keys;
+}
+
+// ns per operation for 'lookups' operations spread over 'keys'
+template<typename Op>
+static double timeLookups(const vector<ImGuiID>& keys, size_t lookups, Op op) {
+    Clock::time_point start = Clock::now();
+    size_t done = 0;
+    while (done < lookups) {
+        for (size_t i = 0; i < keys.size() && done < lookups; ++i, ++done) op(keys[i]);
+    }
+    return secondsSince(start) * 1e9 / (double)lookups;
+}
+
+static void benchStorage(const vector<int>& counts) {
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    cout << "ImGuiStorage: open addressing (IMGUI_STORAGE_OPEN_ADDRESSING)" << endl;
+#else
+    cout << "ImGuiStorage: sorted array" << endl;
+#endif
+    cout << "     keys   build ms   hit ns  miss ns   ref ns  insert ns" << endl;
+
+    mt19937 rng(42);
+    for (int count : counts) {
+        vector<ImGuiID> all = makeKeys((size_t)count * 2 + InsertCount);
+        shuffle(all.begin(), all.end(), rng);
+        vector<ImGuiID> keys(all.begin(), all.begin() + count);
+        vector<ImGuiID> missing(all.begin() + count, all.begin() + count * 2);
+        vector<ImGuiID> fresh(all.begin() + count * 2, all.end());
+
+        ImGuiStorage storage;
+        Clock::time_point start = Clock::now();
+        storage.Data.reserve(count);
+        for (int i = 0; i < count; ++i) storage.Data.push_back(ImGuiStoragePair(keys[i], i + 1));
+        storage.BuildSortByKey();
+        double buildMs = secondsSince(start) * 1e3;
+
+        shuffle(keys.begin(), keys.end(), rng);
+        long long sum = 0;
+        double hit = timeLookups(keys, LookupsPerRound, [&](ImGuiID key) { sum += storage.GetInt(key, 0); });
+        double miss = timeLookups(missing, LookupsPerRound, [&](ImGuiID key) { sum += storage.GetInt(key, 0); });
+        double ref = timeLookups(keys, LookupsPerRound, [&](ImGuiID key) { (*storage.GetIntRef(key, 0))++; });
+
+        start = Clock::now();
+        for (ImGuiID key : fresh) storage.SetInt(key, 1);
+        double insert = secondsSince(start) * 1e9 / InsertCount;
+
+        // Every key must still be found with its value after the inserts
+        bool ok = storage.Data.Size == count + InsertCount;
+        for (ImGuiID key : fresh) ok = ok && storage.GetInt(key, 0) == 1;
+        for (ImGuiID key : missing) ok = ok && storage.GetInt(key, -1) == -1;
+        if (!ok) {
+            cerr << "ImGuiStorage returned wrong values at " << count << " keys" << endl;
+            exit(1);
+        }
+        sink = sum;
+        printf("%9d  %9.2f  %7.1f  %7.1f  %7.1f  %9.1f\n", count, buildMs, hit, miss, ref, insert);
+    }
+}
+
+#if defined(IMGUI_USE_FAST_HASH)
+static const char* HashName = "MurmurHash64A (IMGUI_USE_FAST_HASH)";
+#elif defined(IMGUI_ENABLE_SSE4_2_CRC)
+static const char* HashName = "CRC32c, SSE 4.2, 8 bytes per step";
+#elif defined(IMGUI_USE_LEGACY_CRC32_ADLER)
+static const char* HashName = "CRC32 table (legacy)";
+#else
+static const char* HashName = "CRC32c table";
+#endif
+
+#ifdef IMGUI_USE_LEGACY_CRC32_ADLER
+static const ImU32 CrcPolynomial = 0xEDB88320;
+#else
+static const ImU32 CrcPolynomial = 0x82F63B78;
+#endif
+
+// The hash ImGui used before the wide paths: one table step per byte,
+// restarting from the seed at every ###
+struct ByteCrc {
+    ImU32 table[256];
+
+    ByteCrc() {
+        for (ImU32 i = 0; i < 256; ++i) {
+            ImU32 crc = i;
+            for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (CrcPolynomial & (0u - (crc & 1)));
+            table[i] = crc;
+        }
+    }
+
+    ImGuiID hashStr(const char* text, ImGuiID seed) const {
+        ImU32 crc = ~seed;
+        for (const unsigned char* p = (const unsigned char*)text; *p; ++p) {
+            if (p[0] == '#' && p[1] == '#' && p[2] == '#') crc = ~seed;
+            crc = (crc >> 8) ^ table[(crc & 0xFF) ^ *p];
+        }
+        return ~crc;
+    }
+};
+
+// What any ID hash must satisfy; returns the number of failures
+static int checkHashRules(const ByteCrc& byteCrc) {
+#ifdef IMGUI_USE_FAST_HASH
+    IM_UNUSED(byteCrc);     // IDs no longer match CRC32
+#endif
+    int failures = 0;
+    auto expect = [&](bool condition, const string& what) {
+        if (!condition) {
+            cerr << "FAIL: " << what << endl;
+            failures++;
+        }
+    };
+    const char* samples[] = { "", "#", "##", "###", "####", "#####", "a#", "a##", "a###", "###a", "a###b",
+                              "Save", "Save##toolbar", "##hidden", "Label###Id", "a###b###c", "x####y",
+                              "[ID:1042] Wedding album (Customer: 17) [Pending]",
+                              "[ID:1042] Wedding album (Customer: 17) [Pending]###row1042",
+                              "A label that is long enough to take several 8-byte steps##with a suffix" };
+    const ImGuiID seeds[] = { 0, 0x12345678, 0xFFFFFFFF };
+    for (const char* sample : samples) {
+        size_t len = strlen(sample);
+        const char* triple = strstr(sample, "###");
+        for (ImGuiID seed : seeds) {
+            ImGuiID id = ImHashStr(sample, 0, seed);
+            string name = "\"" + string(sample) + "\" seed " + to_string(seed);
+            if (len) expect(id == ImHashStr(sample, len, seed), name + ": sized and zero-terminated hashes differ");
+            if (!triple) expect(id == ImHashData(sample, len, seed), name + ": ImHashStr differs from ImHashData");
+            if (triple) {
+                // Only the part from the last ### counts
+                const char* last = triple;
+                for (const char* p = triple; (p = strstr(p + 1, "###")) != NULL;) last = p;
+                expect(id == ImHashStr(last, 0, seed), name + ": text before ### changed the ID");
+                expect(id == ImHashStr((string("other") + last).c_str(), 0, seed), name + ": ### did not reset to the seed");
+            }
+#ifndef IMGUI_USE_FAST_HASH
+            expect(id == byteCrc.hashStr(sample, seed), name + ": ID differs from the byte-at-a-time CRC32");
+#endif
+        }
+    }
+    expect(ImHashStr("", 0, 0x1234) == 0x1234, "empty label does not return the seed");
+    expect(ImHashStr("Save##a", 0, 0) != ImHashStr("Save##b", 0, 0), "## suffix does not contribute");
+    expect(ImHashStr("##x", 0, 0) != ImHashStr("x", 0, 0), "## prefix does not contribute");
+    expect(ImHashStr("item", 0, 1) != ImHashStr("item", 0, 2), "seed does not contribute");
+    return failures;
+}
+
+static size_t countCollisions(vector<ImGuiID>& ids) {
+    sort(ids.begin(), ids.end());
+    size_t collisions = 0;
+    for (size_t i = 1; i < ids.size(); ++i) if (ids[i] == ids[i - 1]) collisions++;
+    return collisions;
+}
+
+static void benchHash(size_t labelCount) {
+    cout << "ID hash: " << HashName << endl;
+    ByteCrc byteCrc;
+    int failures = checkHashRules(byteCrc);
+    if (failures) {
+        cerr << failures << " hash check(s) failed" << endl;
+        exit(1);
+    }
+#ifdef IMGUI_USE_FAST_HASH
+    cout << "checks: ### and sized/zero-terminated rules hold" << endl;
+#else
+    cout << "checks: ### and sized/zero-terminated rules hold, IDs match the byte-at-a-time CRC32" << endl;
+#endif
+
+    // Throughput on the labels the order list submits every frame
+    const char* names[] = { "Wedding album", "Logo refresh", "Product photos for the spring catalogue", "Reel" };
+    const char* statuses[] = { "Pending", "In Progress", "Completed" };
+    vector<string> rows;
+    size_t bytes = 0;
+    for (int i = 0; i < 4096; ++i) {
+        char label[160];
+        snprintf(label, sizeof(label), "[ID:%d] %s (Customer: %d) [%s]", 1000 + i, names[i % 4], i % 97, statuses[i % 3]);
+        rows.push_back(label);
+        bytes += rows.back().size();
+    }
+    const int rounds = 500;
+    ImU32 sum = 0;
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < rounds; ++r) for (const string& row : rows) sum += ImHashStr(row.c_str(), 0, (ImGuiID)r);
+    double wide = secondsSince(start);
+    start = Clock::now();
+    for (int r = 0; r < rounds; ++r) for (const string& row : rows) sum += byteCrc.hashStr(row.c_str(), (ImGuiID)r);
+    double narrow = secondsSince(start);
+    sink = sum;
+    double labels = (double)rows.size() * rounds;
+    printf("row labels (avg %.0f bytes)   ns/label    MB/s\n", (double)bytes / rows.size());
+    printf("  ImHashStr                %8.1f  %6.0f\n", wide * 1e9 / labels, bytes * rounds / wide / 1e6);
+    printf("  byte-at-a-time CRC32     %8.1f  %6.0f\n", narrow * 1e9 / labels, bytes * rounds / narrow / 1e6);
+
+    // Collisions among distinct IDs of the shapes the app creates
+    double expected = (double)labelCount * (labelCount - 1) / 2 / 4294967296.0;
+    printf("collisions over %zu IDs (ideal 32-bit hash: %.1f)\n", labelCount, expected);
+    vector<ImGuiID> ids(labelCount);
+    for (size_t i = 0; i < labelCount; ++i) {
+        char label[160];
+        snprintf(label, sizeof(label), "[ID:%zu] %s (Customer: %zu) [%s]", i, names[i % 4], i % 97, statuses[i % 3]);
+        ids[i] = ImHashStr(label, 0, 0x5A5A5A5A);
+    }
+    printf("  row labels               %8zu\n", countCollisions(ids));
+    for (size_t i = 0; i < labelCount; ++i) {
+        char label[32];
+        snprintf(label, sizeof(label), "##%zu", i);
+        ids[i] = ImHashStr(label, 0, 0);
+    }
+    printf("  short labels \"##n\"       %8zu\n", countCollisions(ids));
+    for (size_t i = 0; i < labelCount; ++i) {
+        int n = (int)i;
+        ids[i] = ImHashData(&n, sizeof(n), 0x5A5A5A5A);    // PushID(int)
+    }
+    printf("  PushID(int)              %8zu\n", countCollisions(ids));
+    for (size_t i = 0; i < labelCount; ++i) {
+        char parent[32];
+        snprintf(parent, sizeof(parent), "List%zu", i >> 10);
+        int n = (int)(i & 1023);
+        ids[i] = ImHashStr("Edit", 0, ImHashData(&n, sizeof(n), ImHashStr(parent, 0, 0)));  // same label in every row
+    }
+    printf("  \"Edit\" under PushID(n)   %8zu\n", countCollisions(ids));
+}
+
+static void runListFrame(const vector<string>& labels, int selected) {
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(700, 500));
+    ImGui::Begin("Editor Dashboard");
+    ImGui::BeginChild("editor_orders_list", ImVec2(0, 250), true);
+    for (size_t i = 0; i < labels.size(); ++i) ImGui::Selectable(labels[i].c_str(), (int)i == selected);
+    ImGui::EndChild();
+    ImGui::End();
+    ImGui::Render();
+}
+
+static void createHeadlessContext() {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.Fonts->AddFontDefault();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+}
+
+static void benchText(int rowCount, int frames) {
+    createHeadlessContext();
+
+    const char* names[] = { "Wedding album", "Logo refresh", "Product photos for the spring catalogue", "Reel" };
+    const char* statuses[] = { "Pending", "In Progress", "Completed" };
+    vector<string> labels;
+    for (int i = 0; i < rowCount; ++i) {
+        char label[160];
+        snprintf(label, sizeof(label), "[ID:%d] %s (Customer: %d) [%s]", 1000 + i, names[i % 4], i % 97, statuses[i % 3]);
+        labels.push_back(label);
+    }
+
+    ImGuiTextSizeCache& cache = GImGui->TextSizeCache;
+    printf("%d rows, %d frames\n", rowCount, frames);
+    printf("text size cache   ms/frame   hits/frame  misses/frame\n");
+    for (bool enabled : { false, true }) {
+        cache.Enabled = enabled;
+        cache.Clear();
+        for (int f = 0; f < 5; ++f) runListFrame(labels, f);     // warm up
+        ImU64 hits = cache.HitsTotal, misses = cache.MissesTotal;
+        Clock::time_point start = Clock::now();
+        for (int f = 0; f < frames; ++f) runListFrame(labels, f % rowCount);
+        double ms = secondsSince(start) * 1e3 / frames;
+        printf("%-15s  %9.3f  %11.0f  %12.0f\n", enabled ? "on" : "off", ms,
+               (double)(cache.HitsTotal - hits) / frames, (double)(cache.MissesTotal - misses) / frames);
+    }
+    ImGui::DestroyContext();
+}
+
+// MB/s of 'op' run over every text in turn until 'bytes' have gone through.
+// Best of three rounds, each a third of the bytes.
+template<typename Op>
+static double timeLayout(const vector<string>& texts, size_t bytes, Op op) {
+    double best = 0;
+    for (int round = 0; round < 3; ++round) {
+        size_t done = 0;
+        Clock::time_point start = Clock::now();
+        while (done < bytes / 3) {
+            for (const string& text : texts) {
+                op(text.c_str(), text.c_str() + text.size());
+                done += text.size();
+            }
+        }
+        best = max(best, (double)done / secondsSince(start) / 1e6);
+    }
+    return best;
+}
+
+static void benchLayout(int megabytes) {
+    createHeadlessContext();
+    ImGui::NewFrame();
+    ImFont* font = ImGui::GetFont();
+    const float size = ImGui::GetFontSize();
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    const size_t bytes = (size_t)megabytes << 20;
+
+    const char* names[] = { "Wedding album", "Logo refresh", "Product photos for the spring catalogue", "Reel" };
+    const char* statuses[] = { "Pending", "In Progress", "Completed" };
+    const char* words[] = { "retouch", "the", "cover", "photos,", "warmer", "tones", "and", "crop", "for", "print.",
+                            "Logo", "needs", "a", "white", "variant;", "deliver", "PNG", "by", "Friday!" };
+    const char* foreign[] = { "caf\xc3\xa9", "r\xc3\xa9sum\xc3\xa9", "\xe5\xa9\x9a\xe7\xa4\xbc", "M\xc3\xbcller", "\xe3\x83\xad\xe3\x82\xb4" };
+    vector<string> labels, descriptions, mixed;
+    mt19937 rng(44);
+    for (int i = 0; i < 1000; ++i) {
+        char label[160];
+        snprintf(label, sizeof(label), "[ID:%d] %s (Customer: %d) [%s]", 1000 + i, names[i % 4], i % 97, statuses[i % 3]);
+        labels.push_back(label);
+        string description, description_mixed;
+        for (int w = 0; w < 40; ++w) {
+            const char* word = words[rng() % 19];
+            description += word;
+            description += ' ';
+            description_mixed += (rng() % 4 == 0) ? foreign[rng() % 5] : word;
+            description_mixed += ' ';
+        }
+        descriptions.push_back(description);
+        mixed.push_back(description_mixed);
+    }
+    for (const auto& corpus : { make_pair("order labels", &labels), make_pair("descriptions", &descriptions), make_pair("mixed UTF-8", &mixed) }) {
+        // Glyphs outside the default font's range load their fallback once, here, instead of inside the timing
+        for (const string& text : *corpus.second) font->CalcTextSizeA(size, FLT_MAX, 0.0f, text.c_str(), text.c_str() + text.size());
+    }
+
+    printf("%d MB per measurement, MB/s\n", megabytes);
+    printf("corpus          CalcTextSizeA  wrapped 250px  CalcWordWrapPosition  RenderText\n");
+    for (const auto& corpus : { make_pair("order labels", &labels), make_pair("descriptions", &descriptions), make_pair("mixed UTF-8", &mixed) }) {
+        const vector<string>& texts = *corpus.second;
+        double unwrapped = timeLayout(texts, bytes, [&](const char* b, const char* e) { sink += (long long)font->CalcTextSizeA(size, FLT_MAX, 0.0f, b, e).x; });
+        double wrapped = timeLayout(texts, bytes, [&](const char* b, const char* e) { sink += (long long)font->CalcTextSizeA(size, FLT_MAX, 250.0f, b, e).y; });
+        double wrap_position = timeLayout(texts, bytes, [&](const char* b, const char* e) {
+            while (b < e) b = ImTextCalcWordWrapNextLineStart(font->CalcWordWrapPosition(size, b, e, 250.0f), e, ImDrawTextFlags_None);
+        });
+        double render = timeLayout(texts, bytes, [&](const char* b, const char* e) {
+            draw_list->_ResetForNewFrame();
+            draw_list->PushTexture(ImGui::GetIO().Fonts->TexRef);
+            draw_list->PushClipRectFullScreen();
+            font->RenderText(draw_list, size, ImVec2(0, 0), IM_COL32_WHITE, ImVec4(0, 0, 1280, 720), b, e);
+        });
+        printf("%-14s  %13.1f  %13.1f  %20.1f  %10.1f\n", corpus.first, unwrapped, wrapped, wrap_position, render);
+    }
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+}
+
+static const ImWchar AtlasRanges[] = { 0x0020, 0x024F, 0x2000, 0x206F, 0x3000, 0x30FF, 0x4E00, 0x9FAF, 0 };
+
+struct AtlasBuild {
+    double ms = 0;
+    int glyphs = 0;
+    int width = 0, height = 0;
+    ImGuiID pixelsHash = 0, glyphsHash = 0;
+};
+
+static bool buildAtlas(const string& fontFile, float size, int threads, AtlasBuild& out) {
+    ImFontAtlas atlas;
+    atlas.RasterizerThreads = threads;
+    ImFontConfig config;
+    config.SizePixels = size;
+    ImFont* font = fontFile.empty() ? atlas.AddFontDefault(&config)
+                                    : atlas.AddFontFromFileTTF(fontFile.c_str(), size, &config, AtlasRanges);
+    if (font == NULL) return false;
+    if (fontFile.empty()) atlas.Sources[0].GlyphRanges = AtlasRanges;
+    unsigned char* pixels;
+    int width, height;
+    Clock::time_point start = Clock::now();
+    atlas.GetTexDataAsAlpha8(&pixels, &width, &height);     // preloads every range: no dynamic textures here
+    out.ms = secondsSince(start) * 1e3;
+    out.width = width;
+    out.height = height;
+    out.pixelsHash = ImHashData(pixels, (size_t)width * height);
+    ImFontBaked* baked = font->GetFontBaked(size);
+    out.glyphs = baked->Glyphs.Size;
+    out.glyphsHash = ImHashData(baked->Glyphs.Data, (size_t)baked->Glyphs.Size * sizeof(ImFontGlyph));
+    return true;
+}
+
+static int benchAtlas(const string& fontFile, float size, int threads) {
+#ifndef IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER
+    printf("built without IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER: every build runs on one thread\n");
+#endif
+    AtlasBuild best[2];
+    for (int round = 0; round < 3; ++round) {
+        for (int n = 0; n < 2; ++n) {
+            AtlasBuild build;
+            if (!buildAtlas(fontFile, size, n == 0 ? 1 : threads, build)) {
+                cerr << "Cannot load " << fontFile << endl;
+                return 1;
+            }
+            if (round == 0 || build.ms < best[n].ms) best[n] = build;
+        }
+    }
+    printf("%s, %.0f px, %d glyphs, %dx%d texture\n", fontFile.empty() ? "built-in font" : fontFile.c_str(), size,
+           best[0].glyphs, best[0].width, best[0].height);
+    printf("threads   build ms\n");
+    printf("%-8s  %8.2f\n", "1", best[0].ms);
+    printf("%-8s  %8.2f\n", threads > 0 ? to_string(threads).c_str() : "auto", best[1].ms);
+    bool identical = best[0].pixelsHash == best[1].pixelsHash && best[0].glyphsHash == best[1].glyphsHash &&
+                     best[0].width == best[1].width && best[0].height == best[1].height;
+    printf("atlases identical: %s\n", identical ? "yes" : "NO");
+    return identical ? 0 : 1;
+}
+
+// What the backend would do with texture requests
+static void acceptTextureRequests() {
+    for (ImTextureData* tex : ImGui::GetPlatformIO().Textures) {
+        if (tex->Status == ImTextureStatus_WantCreate) tex->SetTexID((ImTextureID)1);
+        if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates) tex->SetStatus(ImTextureStatus_OK);
+        else if (tex->Status == ImTextureStatus_WantDestroy) {
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->SetStatus(ImTextureStatus_Destroyed);
+        }
+    }
+}
+
+struct Startup {
+    double ms = 0, cacheMs = 0;
+    bool cacheLoaded = false;
+    int glyphs = 0;
+    ImGuiID pixelsHash = 0, glyphsHash = 0;
+};
+
+// Context creation to the end of the second frame, when the texture is
+// complete. loadCache is tried before the first frame, as the app does on
+// every start; saveCache is written after the clock stops.
+static bool startApp(const string& fontFile, float size, const vector<string>& labels, const char* loadCache,
+                     const char* saveCache, Startup& out) {
+    Clock::time_point start = Clock::now();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    ImFontConfig config;
+    config.SizePixels = size;
+    ImFont* font = fontFile.empty() ? io.Fonts->AddFontDefault(&config) : io.Fonts->AddFontFromFileTTF(fontFile.c_str(), size, &config);
+    if (font == NULL) {
+        ImGui::DestroyContext();
+        return false;
+    }
+    ImFontBaked* baked = font->GetFontBaked(size);
+    if (loadCache) {
+        Clock::time_point cacheStart = Clock::now();
+        out.cacheLoaded = ImFontAtlasBakedLoadFromFile(io.Fonts, baked, loadCache);
+        out.cacheMs = secondsSince(cacheStart) * 1e3;
+    }
+    for (int f = 0; f < 2; ++f) {
+        runListFrame(labels, 0);
+        acceptTextureRequests();
+    }
+    out.ms = secondsSince(start) * 1e3;
+
+    ImTextureData* tex = io.Fonts->TexData;
+    out.glyphs = baked->Glyphs.Size;
+    out.pixelsHash = ImHashData(tex->Pixels, (size_t)tex->GetSizeInBytes());
+    out.glyphsHash = ImHashData(baked->Glyphs.Data, (size_t)baked->Glyphs.Size * sizeof(ImFontGlyph));
+    if (saveCache) {
+        Clock::time_point cacheStart = Clock::now();
+        ImFontAtlasBakedSaveToFile(io.Fonts, baked, saveCache);
+        out.cacheMs = secondsSince(cacheStart) * 1e3;
+    }
+    ImGui::DestroyContext();
+    return true;
+}
+
+static int benchFontCache(const string& fontFile, float size, const string& cacheFile) {
+    const char* names[] = { "Wedding album", "Logo refresh", "Product photos for the spring catalogue", "Reel" };
+    const char* statuses[] = { "Pending", "In Progress", "Completed" };
+    vector<string> labels;
+    for (int i = 0; i < 200; ++i) {
+        char label[160];
+        snprintf(label, sizeof(label), "[ID:%d] %s (Customer: %d) [%s]", 1000 + i, names[i % 4], i % 97, statuses[i % 3]);
+        labels.push_back(label);
+    }
+    labels.push_back("ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz 0123456789 !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~");
+
+    Startup cold, warm;
+    for (int round = 0; round < 5; ++round) {
+        remove(cacheFile.c_str());
+        Startup run;
+        if (!startApp(fontFile, size, labels, cacheFile.c_str(), cacheFile.c_str(), run)) {
+            cerr << "Cannot load " << fontFile << endl;
+            return 1;
+        }
+        if (run.cacheLoaded) {
+            cerr << "Loaded a cache that was just deleted" << endl;
+            return 1;
+        }
+        if (round == 0 || run.ms < cold.ms) cold = run;
+    }
+    for (int round = 0; round < 5; ++round) {
+        Startup run;
+        startApp(fontFile, size, labels, cacheFile.c_str(), NULL, run);
+        if (!run.cacheLoaded) {
+            cerr << "Cannot load " << cacheFile << endl;
+            return 1;
+        }
+        if (round == 0 || run.ms < warm.ms) warm = run;
+    }
+    printf("%s, %.0f px, %d glyphs\n", fontFile.empty() ? "built-in font" : fontFile.c_str(), size, cold.glyphs);
+    printf("startup   to first frame ms   cache ms\n");
+    printf("cold      %18.2f   %8.2f (save)\n", cold.ms, cold.cacheMs);
+    printf("warm      %18.2f   %8.2f (load)\n", warm.ms, warm.cacheMs);
+    bool identical = cold.glyphs == warm.glyphs && cold.pixelsHash == warm.pixelsHash && cold.glyphsHash == warm.glyphsHash;
+    printf("same glyphs and texture: %s\n", identical ? "yes" : "NO");
+    return identical ? 0 : 1;
+}
+
+struct GlyphRun {
+    double medianMs = 0, p99Ms = 0, maxMs = 0;
+    int hitches = 0, glyphs = 0, blankGlyphFrames = 0;
+};
+
+static bool runNewGlyphFrames(const string& fontFile, float size, int frames, bool async, GlyphRun& out) {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 250.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    if (async) io.Fonts->Flags |= ImFontAtlasFlags_AsyncGlyphBaking;
+    ImFontConfig config;
+    config.SizePixels = size;
+    ImFont* font = fontFile.empty() ? io.Fonts->AddFontDefault(&config) : io.Fonts->AddFontFromFileTTF(fontFile.c_str(), size, &config);
+    if (font == NULL) {
+        ImGui::DestroyContext();
+        return false;
+    }
+
+    // Characters the font has beyond ASCII, fed a few per new name
+    vector<unsigned int> fresh;
+    const unsigned int ranges[][2] = { { 0x00C0, 0x017F }, { 0x0391, 0x03C9 }, { 0x0410, 0x044F }, { 0x4E00, 0x4FFF } };
+    for (const auto& range : ranges)
+        for (unsigned int c = range[0]; c <= range[1]; ++c)
+            if (font->IsGlyphInFont((ImWchar)c)) fresh.push_back(c);
+    vector<string> labels;
+    for (int i = 0; i < 40; ++i) labels.push_back("[ID:" + to_string(1000 + i) + "] Order for customer " + to_string(i));
+    for (int f = 0; f < 5; ++f) {   // load ASCII before timing
+        runListFrame(labels, 0);
+        acceptTextureRequests();
+    }
+
+    vector<double> ms(frames);
+    size_t next = 0;
+    const chrono::microseconds period(4000);
+    Clock::time_point tick = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        if (f % 10 == 0 && next < fresh.size()) {   // someone types a new name
+            string name = "Customer ";
+            for (int n = 0; n < 6 && next < fresh.size(); ++n) {
+                char utf8[5];
+                ImTextCharToUtf8(utf8, fresh[next++]);
+                name += utf8;
+            }
+            labels[f / 10 % labels.size()] = name;
+        }
+        Clock::time_point start = Clock::now();
+        runListFrame(labels, 0);
+        acceptTextureRequests();
+        ms[f] = secondsSince(start) * 1e3;
+        out.blankGlyphFrames += ImFontAtlasAsyncGlyphsGetPendingCount(io.Fonts);
+        tick += period;
+        while (Clock::now() < tick) this_thread::sleep_for(chrono::microseconds(200));  // vsync stand-in
+    }
+    out.glyphs = font->GetFontBaked(size)->Glyphs.Size;
+    ImGui::DestroyContext();
+
+    vector<double> sorted = ms;
+    sort(sorted.begin(), sorted.end());
+    out.medianMs = sorted[sorted.size() / 2];
+    out.p99Ms = sorted[sorted.size() * 99 / 100];
+    out.maxMs = sorted.back();
+    for (double t : ms) out.hitches += t > 2 * out.medianMs;
+    return true;
+}
+
+static int benchGlyphs(const string& fontFile, float size, int frames) {
+#ifndef IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER
+    printf("built without IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER: async mode rasterizes inside the frame too\n");
+#endif
+    GlyphRun runs[2];
+    for (int n = 0; n < 2; ++n) {
+        if (!runNewGlyphFrames(fontFile, size, frames, n == 1, runs[n])) {
+            cerr << "Cannot load " << fontFile << endl;
+            return 1;
+        }
+    }
+    printf("%s, %.0f px, %d frames, %d glyphs loaded\n", fontFile.empty() ? "built-in font" : fontFile.c_str(), size, frames, runs[0].glyphs);
+    printf("glyph baking   median ms   p99 ms   max ms   hitches/1000   blank glyph-frames\n");
+    for (int n = 0; n < 2; ++n)
+        printf("%-13s  %9.3f  %7.3f  %7.3f  %13.1f  %19d\n", n == 0 ? "in frame" : "async", runs[n].medianMs, runs[n].p99Ms,
+               runs[n].maxMs, runs[n].hitches * 1000.0 / frames, runs[n].blankGlyphFrames);
+    return 0;
+}
+
+#if !defined(IMGUI_IMPL_DX9_ENABLE_SSE2)
+static const char* ConvertName = "scalar";
+#elif defined(__AVX2__)
+static const char* ConvertName = "AVX2 colors, SSE2 vertices";
+#else
+static const char* ConvertName = "SSE2";
+#endif
+
+// The loops the DX9 backend ran before the kernels, written out per byte
+static void referenceVertices(ImGui_ImplDX9_Vertex* dst, const ImDrawVert* src, int count) {
+    for (int i = 0; i < count; ++i) {
+        const unsigned char* c = (const unsigned char*)&src[i].col;
+        dst[i].pos[0] = src[i].pos.x;
+        dst[i].pos[1] = src[i].pos.y;
+        dst[i].pos[2] = 0.0f;
+#ifdef IMGUI_USE_BGRA_PACKED_COLOR
+        dst[i].col = src[i].col;
+#else
+        dst[i].col = (ImU32)c[3] << 24 | (ImU32)c[0] << 16 | (ImU32)c[1] << 8 | c[2];
+#endif
+        dst[i].uv[0] = src[i].uv.x;
+        dst[i].uv[1] = src[i].uv.y;
+    }
+}
+
+static void referenceColors(ImU32* dst, const ImU32* src, int count) {
+    for (int i = 0; i < count; ++i) {
+        const unsigned char* c = (const unsigned char*)&src[i];
+#ifdef IMGUI_USE_BGRA_PACKED_COLOR
+        dst[i] = src[i];
+#else
+        dst[i] = (ImU32)c[3] << 24 | (ImU32)c[0] << 16 | (ImU32)c[1] << 8 | c[2];
+#endif
+    }
+}
+
+// Best of five, in ns per element; runs over the whole input each time
+template<typename Op>
+static double timeConvert(size_t elements, Op op) {
+    double best = DBL_MAX;
+    for (int round = 0; round < 5; ++round) {
+        Clock::time_point start = Clock::now();
+        int passes = 0;
+        do {
+            op();
+            passes++;
+        } while (secondsSince(start) < 0.2);
+        best = min(best, secondsSince(start) * 1e9 / ((double)elements * passes));
+    }
+    return best;
+}
+
+static int benchConvert(int vertexCount) {
+    cout << "DX9 conversion: " << ConvertName << endl;
+    mt19937 rng(48);
+    uniform_real_distribution<float> coord(-100.0f, 2000.0f);
+    vector<ImDrawVert> vertices(vertexCount);
+    for (ImDrawVert& v : vertices) {
+        v.pos = ImVec2(coord(rng), coord(rng));
+        v.uv = ImVec2(coord(rng) / 2000.0f, coord(rng) / 2000.0f);
+        v.col = (ImU32)rng();
+    }
+    // Draw list sizes like a frame's: mostly small windows, a few large ones
+    vector<int> lists;
+    for (int left = vertexCount; left > 0;) {
+        int n = min(left, (int)(rng() % 8 == 0 ? 1 + rng() % 20000 : 1 + rng() % 600));
+        lists.push_back(n);
+        left -= n;
+    }
+    const int texWidth = 1024, texHeight = 1024;
+    vector<ImU32> pixels((size_t)texWidth * texHeight);
+    for (ImU32& p : pixels) p = (ImU32)rng();
+
+    // Every count up to 40, at every start offset, then the real lists
+    vector<ImGui_ImplDX9_Vertex> expected(vertexCount), got(vertexCount);
+    vector<ImU32> expectedPixels(pixels.size()), gotPixels(pixels.size());
+    int failures = 0;
+    for (int offset = 0; offset < 4; ++offset) {
+        for (int n = 0; n <= 40; ++n) {
+            memset(got.data(), 0xCD, (n + 1) * sizeof(ImGui_ImplDX9_Vertex));
+            referenceVertices(expected.data(), &vertices[offset], n);
+            ImGui_ImplDX9_ConvertVertices(got.data(), &vertices[offset], n);
+            unsigned char guard = *(unsigned char*)&got[n];
+            failures += memcmp(expected.data(), got.data(), n * sizeof(ImGui_ImplDX9_Vertex)) != 0 || guard != 0xCD;
+            gotPixels[n] = 0xCDCDCDCD;
+            referenceColors(expectedPixels.data(), &pixels[offset], n);
+            ImGui_ImplDX9_ConvertColors(gotPixels.data(), &pixels[offset], n);
+            failures += memcmp(expectedPixels.data(), gotPixels.data(), n * sizeof(ImU32)) != 0 || gotPixels[n] != 0xCDCDCDCD;
+        }
+    }
+    referenceVertices(expected.data(), vertices.data(), vertexCount);
+    size_t at = 0;
+    for (int n : lists) {
+        ImGui_ImplDX9_ConvertVertices(&got[at], &vertices[at], n);
+        at += n;
+    }
+    failures += memcmp(expected.data(), got.data(), vertexCount * sizeof(ImGui_ImplDX9_Vertex)) != 0;
+    referenceColors(expectedPixels.data(), pixels.data(), (int)pixels.size());
+    ImGui_ImplDX9_ConvertColors(gotPixels.data(), pixels.data(), (int)pixels.size());
+    failures += memcmp(expectedPixels.data(), gotPixels.data(), pixels.size() * sizeof(ImU32)) != 0;
+    if (failures) {
+        cerr << failures << " conversion check(s) failed" << endl;
+        return 1;
+    }
+    cout << "checks: output matches the per-element loops for every tail and offset" << endl;
+
+    auto convertLists = [&](void (*convert)(ImGui_ImplDX9_Vertex*, const ImDrawVert*, int)) {
+        size_t offset = 0;
+        for (int n : lists) {
+            convert(&got[offset], &vertices[offset], n);
+            offset += n;
+        }
+    };
+    // Texture rows as UpdateTexture() copies them: 512-pixel updates
+    auto convertRows = [&](void (*convert)(ImU32*, const ImU32*, int)) {
+        for (int y = 0; y < texHeight; ++y)
+            for (int x = 0; x < texWidth; x += 512) convert(&gotPixels[(size_t)y * texWidth + x], &pixels[(size_t)y * texWidth + x], 512);
+    };
+    double vtxOld = timeConvert(vertexCount, [&] { convertLists(referenceVertices); });
+    double vtxNew = timeConvert(vertexCount, [&] { convertLists(ImGui_ImplDX9_ConvertVertices); });
+    double colOld = timeConvert(pixels.size(), [&] { convertRows(referenceColors); });
+    double colNew = timeConvert(pixels.size(), [&] { convertRows(ImGui_ImplDX9_ConvertColors); });
+    sink = got[vertexCount / 2].col + gotPixels[pixels.size() / 2];
+    printf("%d vertices in %zu draw lists, %dx%d texture\n", vertexCount, lists.size(), texWidth, texHeight);
+    printf("                    ns/element   output GB/s   per-element loop ns   speedup\n");
+    printf("  vertices          %10.3f  %12.2f  %20.3f  %7.2fx\n", vtxNew, sizeof(ImGui_ImplDX9_Vertex) / vtxNew, vtxOld, vtxOld / vtxNew);
+    printf("  texture pixels    %10.3f  %12.2f  %20.3f  %7.2fx\n", colNew, sizeof(ImU32) / colNew, colOld, colOld / colNew);
+    return 0;
+}
+
+// Editor menu shaped frame. With 'reuse' the window is only redrawn when the selection
+// changes. Returns a hash of the frame's draw data.
+static ImGuiID runMenuFrame(const vector<string>& labels, int selected, bool reuse) {
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(700, 500));
+    if (reuse)
+        ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags_TryToAvoidRefresh | ImGuiWindowRefreshFlags_RefreshOnChange,
+                                          ImHashData(&selected, sizeof(selected)));
+    ImGui::Begin("Editor Menu");
+    ImGui::Text("Logged in as: editor (Editor, ID: 2)");
+    ImGui::Separator();
+    ImGui::Text("All Orders:");
+    ImGui::BeginChild("editor_orders_list", ImVec2(0, 250), true);
+    for (size_t i = 0; i < labels.size(); ++i) ImGui::Selectable(labels[i].c_str(), (int)i == selected);
+    ImGui::EndChild();
+    ImGui::Separator();
+    ImGui::Text("Deadlines:");
+    ImGui::BulletText("[ID:%d] %s - %d day(s) left", 1000 + selected, labels[selected].c_str(), selected % 7);
+    ImGui::Button("Refresh##editor", ImVec2(150, 0));
+    ImGui::SameLine();
+    ImGui::Button("Auto-assign##editor", ImVec2(150, 0));
+    ImGui::End();
+    ImGui::Render();
+
+    ImGuiID hash = 0;
+    ImDrawData* drawData = ImGui::GetDrawData();
+    for (ImDrawList* list : drawData->CmdLists) {
+        hash = ImHashData(list->VtxBuffer.Data, list->VtxBuffer.size_in_bytes(), hash);
+        hash = ImHashData(list->IdxBuffer.Data, list->IdxBuffer.size_in_bytes(), hash);
+        for (const ImDrawCmd& cmd : list->CmdBuffer) {
+            hash = ImHashData(&cmd.ClipRect, sizeof(cmd.ClipRect), hash);
+            ImU32 offsets[3] = { cmd.VtxOffset, cmd.IdxOffset, cmd.ElemCount };
+            hash = ImHashData(offsets, sizeof(offsets), hash);
+        }
+    }
+    return hash;
+}
+
+static int benchRefresh(int rowCount, int frames) {
+    const char* names[] = { "Wedding album", "Logo refresh", "Product photos for the spring catalogue", "Reel" };
+    const char* statuses[] = { "Pending", "In Progress", "Completed" };
+    vector<string> labels;
+    for (int i = 0; i < rowCount; ++i) {
+        char label[160];
+        snprintf(label, sizeof(label), "[ID:%d] %s (Customer: %d) [%s]", 1000 + i, names[i % 4], i % 97, statuses[i % 3]);
+        labels.push_back(label);
+    }
+
+    printf("%d rows, %d frames, selection moving every 50 frames\n", rowCount, frames);
+    printf("window contents   ms/frame   reused   redrawn\n");
+    vector<ImGuiID> expected(frames);
+    int mismatches = 0;
+    for (bool reuse : { false, true }) {
+        createHeadlessContext();
+        Clock::time_point start = Clock::now();
+        for (int f = 0; f < frames; ++f) {
+            ImGuiID hash = runMenuFrame(labels, (f / 50) % rowCount, reuse);
+            if (!reuse) expected[f] = hash;
+            else mismatches += hash != expected[f];
+        }
+        double ms = secondsSince(start) * 1e3 / frames;
+        ImGuiWindow* window = ImGui::FindWindowByName("Editor Menu");
+        printf("%-16s  %8.3f  %7d  %8d\n", reuse ? "reused" : "redrawn", ms, window->SkipRefreshHits, reuse ? window->SkipRefreshMisses : frames);
+        ImGui::DestroyContext();
+    }
+    if (mismatches) {
+        cerr << mismatches << " frame(s) drew differently with reused contents" << endl;
+        return 1;
+    }
+    cout << "checks: every frame's draw data matches the redrawn run" << endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    vector<int> counts = { 10000, 100000, 1000000 };
+    size_t labels = 1000000;
+    int rows = 5000, frames = 0, megabytes = 16, threads = 0, vertices = 200000;     // frames: 300 for text, 1000 for glyphs, 600 for refresh
+    float fontSize = 16.0f;
+    string fontFile, cacheFile = "fontcache.bin";
+    string command = argc >= 2 ? argv[1] : "";
+    bool ok = command == "storage" || command == "hash" || command == "text" || command == "layout" || command == "atlas" ||
+              command == "fontcache" || command == "glyphs" || command == "convert" || command == "refresh";
+    bool fontCommand = command == "atlas" || command == "fontcache" || command == "glyphs";
+    for (int i = 2; ok && i < argc; i += 2) {
+        if (i + 1 >= argc) ok = false;
+        else if (command == "storage" && strcmp(argv[i], "--keys") == 0) ok = parseCounts(argv[i + 1], counts);
+        else if (command == "hash" && strcmp(argv[i], "--labels") == 0) ok = (labels = strtoul(argv[i + 1], NULL, 10)) > 1;
+        else if ((command == "text" || command == "refresh") && strcmp(argv[i], "--rows") == 0) ok = (rows = atoi(argv[i + 1])) > 0;
+        else if ((command == "text" || command == "glyphs" || command == "refresh") && strcmp(argv[i], "--frames") == 0) ok = (frames = atoi(argv[i + 1])) > 0;
+        else if (command == "layout" && strcmp(argv[i], "--mb") == 0) ok = (megabytes = atoi(argv[i + 1])) > 0;
+        else if (fontCommand && strcmp(argv[i], "--font") == 0) fontFile = argv[i + 1];
+        else if (fontCommand && strcmp(argv[i], "--size") == 0) ok = (fontSize = (float)atof(argv[i + 1])) > 0;
+        else if (command == "atlas" && strcmp(argv[i], "--threads") == 0) ok = (threads = atoi(argv[i + 1])) >= 0;
+        else if (command == "fontcache" && strcmp(argv[i], "--cache") == 0) cacheFile = argv[i + 1];
+        else if (command == "convert" && strcmp(argv[i], "--vertices") == 0) ok = (vertices = atoi(argv[i + 1])) > 0;
+        else ok = false;
+    }
+    if (!ok) {
+        cerr << "Usage: desainin-imgui-bench storage [--keys 10000,100000,1000000]" << endl;
+        cerr << "       desainin-imgui-bench hash [--labels 1000000]" << endl;
+        cerr << "       desainin-imgui-bench text [--rows 5000] [--frames 300]" << endl;
+        cerr << "       desainin-imgui-bench layout [--mb 16]" << endl;
+        cerr << "       desainin-imgui-bench atlas [--font file.ttf] [--size 16] [--threads 0]" << endl;
+        cerr << "       desainin-imgui-bench fontcache [--font file.ttf] [--size 16] [--cache fontcache.bin]" << endl;
+        cerr << "       desainin-imgui-bench glyphs [--font file.ttf] [--size 16] [--frames 1000]" << endl;
+        cerr << "       desainin-imgui-bench convert [--vertices 200000]" << endl;
+        cerr << "       desainin-imgui-bench refresh [--rows 5000] [--frames 600]" << endl;
+        return 1;
+    }
+    if (command == "storage") benchStorage(counts);
+    else if (command == "hash") benchHash(labels);
+    else if (command == "text") benchText(rows, frames ? frames : 300);
+    else if (command == "layout") benchLayout(megabytes);
+    else if (command == "atlas") return benchAtlas(fontFile, fontSize, threads);
+    else if (command == "fontcache") return benchFontCache(fontFile, fontSize, cacheFile);
+    else if (command == "glyphs") return benchGlyphs(fontFile, fontSize, frames ? frames : 1000);
+    else if (command == "convert") return benchConvert(vertices);
+    else return benchRefresh(rows, frames ? frames : 600);
+    return 0;
+}
@@ -15,6 +15,9 @@ Index of this file:
 // [SECTION] ImFontConfig
 // [SECTION] ImFontAtlas, ImFontAtlasBuilder
 // [SECTION] ImFontAtlas: backend for stb_truetype
+// [SECTION] ImFontAtlas: bulk glyph loading
+// [SECTION] ImFontAtlas: baked font cache
+// [SECTION] ImFontAtlas: asynchronous glyph baking
 // [SECTION] ImFontAtlas: glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
 // [SECTION] ImFont
@@ -41,6 +44,12 @@ Index of this file:
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <stdint.h>     // intptr_t
+#ifdef IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER
+#include <atomic>       // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <mutex>        // std::mutex
+#include <thread>       // std::thread
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -135,10 +144,14 @@ namespace IMGUI_STB_NAMESPACE
 #endif
 
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
+// Glyphs rasterized on worker threads set stbtt_fontinfo::userdata to one of these: IM_ALLOC() also updates the context's debug counters, which is not thread-safe.
+struct ImFontAtlasThreadAllocator { ImGuiMemAllocFunc AllocFunc; ImGuiMemFreeFunc FreeFunc; void* UserData; };
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+static void*    ImStbTrueTypeAlloc(size_t size, void* user_data) { const ImFontAtlasThreadAllocator* a = (const ImFontAtlasThreadAllocator*)user_data; return a ? a->AllocFunc(size, a->UserData) : IM_ALLOC(size); }
+static void     ImStbTrueTypeFree(void* ptr, void* user_data)    { const ImFontAtlasThreadAllocator* a = (const ImFontAtlasThreadAllocator*)user_data; if (a) a->FreeFunc(ptr, a->UserData); else IM_FREE(ptr); }
+#define STBTT_malloc(x,u)   ImStbTrueTypeAlloc(x,u)
+#define STBTT_free(x,u)     ImStbTrueTypeFree(x,u)
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -2573,6 +2586,11 @@ void ImTextureData::DestroyPixels()
 // - ImFontAtlasDebugLogTextureRequests()
 //-----------------------------------------------------------------------------
 // - ImFontAtlasGetFontLoaderForStbTruetype()
+// - ImFontAtlasBakedLoadGlyphs()
+// - ImFontAtlasBakedSaveToFile()
+// - ImFontAtlasBakedLoadFromFile()
+// - ImFontAtlasAsyncGlyphsUpdate()
+// - ImFontAtlasAsyncGlyphsFlush()
 //-----------------------------------------------------------------------------
 
 // A work of art lies ahead! (. = white layer, X = black layer, others are blank)
@@ -2839,6 +2857,9 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
             tex_n--;
         }
     }
+
+    // Copy glyphs rasterized by the async worker since last frame (after the status update, which drops last frame's uploads)
+    ImFontAtlasAsyncGlyphsUpdate(atlas);
 }
 
 void ImFontAtlasTextureBlockConvert(const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch, unsigned char* dst_pixels, ImTextureFormat dst_fmt, int dst_pitch, int w, int h)
@@ -3433,20 +3454,23 @@ void ImFontAtlasBuildSetupFontLoader(ImFontAtlas* atlas, const ImFontLoader* fon
 void ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas)
 {
     atlas->Builder->PreloadedAllGlyphsRanges = true;
+    ImVector<ImWchar> codepoints;
     for (ImFont* font : atlas->Fonts)
     {
         ImFontBaked* baked = font->GetFontBaked(font->LegacySize);
+        codepoints.resize(0);
         if (font->FallbackChar != 0)
-            baked->FindGlyph(font->FallbackChar);
+            codepoints.push_back(font->FallbackChar);
         if (font->EllipsisChar != 0)
-            baked->FindGlyph(font->EllipsisChar);
+            codepoints.push_back(font->EllipsisChar);
         for (ImFontConfig* src : font->Sources)
         {
             const ImWchar* ranges = src->GlyphRanges ? src->GlyphRanges : atlas->GetGlyphRangesDefault();
             for (; ranges[0]; ranges += 2)
                 for (unsigned int c = ranges[0]; c <= ranges[1] && c <= IM_UNICODE_CODEPOINT_MAX; c++) //-V560
-                    baked->FindGlyph((ImWchar)c);
+                    codepoints.push_back((ImWchar)c);
         }
+        ImFontAtlasBakedLoadGlyphs(atlas, baked, codepoints.Data, codepoints.Size);
     }
 }
 
@@ -3601,6 +3625,7 @@ bool ImFontAtlasFontInitOutput(ImFontAtlas* atlas, ImFont* font)
 // Keep source/input FontData
 void ImFontAtlasFontDestroyOutput(ImFontAtlas* atlas, ImFont* font)
 {
+    ImFontAtlasAsyncGlyphsFlush(atlas);
     font->ClearOutputData();
     for (ImFontConfig* src : font->Sources)
     {
@@ -3630,12 +3655,13 @@ void ImFontAtlasFontSourceAddToFont(ImFontAtlas* atlas, ImFont* font, ImFontConf
         IM_ASSERT(font->Sources[0] == src);
     }
     atlas->TexIsBuilt = false; // For legacy backends
+    atlas->MetricsVersion++;
     ImFontAtlasBuildSetupFontSpecialGlyphs(atlas, font, src);
 }
 
 void ImFontAtlasFontDestroySourceData(ImFontAtlas* atlas, ImFontConfig* src)
 {
-    IM_UNUSED(atlas);
+    ImFontAtlasAsyncGlyphsFlush(atlas);
     // IF YOU GET A CRASH IN THE IM_FREE() CALL HERE AND USED AddFontFromMemoryTTF():
     // - DUE TO LEGACY REASON AddFontFromMemoryTTF() TRANSFERS MEMORY OWNERSHIP BY DEFAULT.
     // - IT WILL THEREFORE CRASH WHEN PASSED DATA WHICH MAY NOT BE FREEED BY IMGUI.
@@ -3662,6 +3688,7 @@ static ImFontGlyph* ImFontAtlasBuildSetupFontBakedEllipsis(ImFontAtlas* atlas, I
         dot_glyph = baked->FindGlyphNoFallback((ImWchar)0xFF0E);
     if (dot_glyph == NULL)
         return NULL;
+    ImFontAtlasAsyncGlyphsFlush(atlas); // We copy the dot's texels below
     ImFontAtlasRectId dot_r_id = dot_glyph->PackId; // Deep copy to avoid invalidation of glyphs and rect pointers
     ImTextureRect* dot_r = ImFontAtlasPackGetRect(atlas, dot_r_id);
     const int dot_spacing = 1;
@@ -3771,6 +3798,7 @@ void ImFontAtlasBuildSetupFontSpecialGlyphs(ImFontAtlas* atlas, ImFont* font, Im
 
 void ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked, ImFontGlyph* glyph)
 {
+    ImFontAtlasAsyncGlyphsFlush(atlas);
     if (glyph->PackId != ImFontAtlasRectId_Invalid)
     {
         ImFontAtlasPackDiscardRect(atlas, glyph->PackId);
@@ -3782,6 +3810,7 @@ void ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBa
     IM_UNUSED(font);
     baked->IndexLookup[c] = IM_FONTGLYPH_INDEX_UNUSED;
     baked->IndexAdvanceX[c] = baked->FallbackAdvanceX;
+    atlas->MetricsVersion++;
 }
 
 ImFontBaked* ImFontAtlasBakedAdd(ImFontAtlas* atlas, ImFont* font, float font_size, float font_rasterizer_density, ImGuiID baked_id)
@@ -3846,6 +3875,7 @@ ImFontBaked* ImFontAtlasBakedGetClosestMatch(ImFontAtlas* atlas, ImFont* font, f
 
 void ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked)
 {
+    ImFontAtlasAsyncGlyphsFlush(atlas);
     ImFontAtlasBuilder* builder = atlas->Builder;
     IMGUI_DEBUG_LOG_FONT("[font] Discard baked %.2f for \"%s\"\n", baked->Size, font->GetDebugName());
 
@@ -3868,6 +3898,7 @@ void ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* bake
     }
     builder->BakedMap.SetVoidPtr(baked->BakedId, NULL);
     builder->BakedDiscardedCount++;
+    atlas->MetricsVersion++;
     baked->ClearOutputData();
     baked->WantDestroy = true;
     font->LastBaked = NULL;
@@ -4241,8 +4272,11 @@ void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 }
 
 // Destroy builder and all cached glyphs. Do not destroy actual fonts.
+static void ImFontAtlasAsyncGlyphsShutdown(ImFontAtlas* atlas);
 void ImFontAtlasBuildDestroy(ImFontAtlas* atlas)
 {
+    if (atlas->Builder)
+        ImFontAtlasAsyncGlyphsShutdown(atlas);
     for (ImFont* font : atlas->Fonts)
         ImFontAtlasFontDestroyOutput(atlas, font);
     if (atlas->Builder && atlas->FontLoader && atlas->FontLoader->LoaderShutdown)
@@ -4252,6 +4286,7 @@ void ImFontAtlasBuildDestroy(ImFontAtlas* atlas)
     }
     IM_DELETE(atlas->Builder);
     atlas->Builder = NULL;
+    atlas->MetricsVersion++;
 }
 
 void ImFontAtlasPackInit(ImFontAtlas * atlas)
@@ -4596,6 +4631,7 @@ static bool ImGui_ImplStbTrueType_FontSrcInit(ImFontAtlas* atlas, ImFontConfig*
         IM_ASSERT_USER_ERROR(0, "stbtt_InitFont(): failed to parse FontData. It is correct and complete? Check FontDataSize.");
         return false;
     }
+    bd_font_data->FontInfo.userdata = NULL; // Passed to STBTT_malloc()
     src->FontLoaderData = bd_font_data;
 
     const float ref_size = src->DstFont->Sources[0]->SizePixels;
@@ -4649,6 +4685,40 @@ static bool ImGui_ImplStbTrueType_FontBakedInit(ImFontAtlas* atlas, ImFontConfig
     return true;
 }
 
+// Register glyph position once its bitmap is rendered
+// r->x r->y are coordinates inside texture (in pixels)
+// glyph.X0, glyph.Y0 are drawing coordinates from base text position, and accounting for oversampling.
+static void ImGui_ImplStbTrueType_PlaceGlyph(ImFontConfig* src, ImFontBaked* baked, ImFontGlyph* glyph, const ImTextureRect* r, int x0, int y0, float sub_x, float sub_y, int oversample_h, int oversample_v)
+{
+    const float rasterizer_density = src->RasterizerDensity * baked->RasterizerDensity;
+    const float ref_size = baked->OwnerFont->Sources[0]->SizePixels;
+    const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
+    float font_off_x = (src->GlyphOffset.x * offsets_scale);
+    float font_off_y = (src->GlyphOffset.y * offsets_scale);
+    if (src->PixelSnapH) // Snap scaled offset. This is to mitigate backward compatibility issues for GlyphOffset, but a better design would be welcome.
+        font_off_x = IM_ROUND(font_off_x);
+    if (src->PixelSnapV)
+        font_off_y = IM_ROUND(font_off_y);
+    font_off_x += sub_x;
+    font_off_y += sub_y + IM_ROUND(baked->Ascent);
+    float recip_h = 1.0f / (oversample_h * rasterizer_density);
+    float recip_v = 1.0f / (oversample_v * rasterizer_density);
+
+    glyph->X0 = x0 * recip_h + font_off_x;
+    glyph->Y0 = y0 * recip_v + font_off_y;
+    glyph->X1 = (x0 + (int)r->w) * recip_h + font_off_x;
+    glyph->Y1 = (y0 + (int)r->h) * recip_v + font_off_y;
+    glyph->Visible = true;
+}
+
+// Same as the sub_x/sub_y output of stbtt_MakeGlyphBitmapSubpixelPrefilter(), known without rasterizing
+static float ImGui_ImplStbTrueType_OversampleShift(int oversample)
+{
+    return (oversample > 1) ? -(float)(oversample - 1) / (2.0f * (float)oversample) : 0.0f;
+}
+
+static bool ImFontAtlasAsyncGlyphsQueue(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, int glyph_index, ImFontAtlasRectId pack_id, int w, int h, int oversample_h, int oversample_v, float scale_for_raster_x, float scale_for_raster_y);
+
 static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void*, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x)
 {
     // Search for first font which has the glyph
@@ -4702,6 +4772,15 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
 
         // Render
         stbtt_GetGlyphBitmapBox(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, &x0, &y0, &x1, &y1);
+
+        // With ImFontAtlasFlags_AsyncGlyphBaking: register it blank, a worker thread renders it for a later frame
+        if (ImFontAtlasAsyncGlyphsQueue(atlas, src, baked, glyph_index, pack_id, w, h, oversample_h, oversample_v, scale_for_raster_x, scale_for_raster_y))
+        {
+            ImGui_ImplStbTrueType_PlaceGlyph(src, baked, out_glyph, r, x0, y0, ImGui_ImplStbTrueType_OversampleShift(oversample_h), ImGui_ImplStbTrueType_OversampleShift(oversample_v), oversample_h, oversample_v);
+            out_glyph->PackId = pack_id;
+            return true;
+        }
+
         ImFontAtlasBuilder* builder = atlas->Builder;
         builder->TempBuffer.resize(w * h * 1);
         unsigned char* bitmap_pixels = builder->TempBuffer.Data;
@@ -4713,27 +4792,7 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
         stbtt_MakeGlyphBitmapSubpixelPrefilter(&bd_font_data->FontInfo, bitmap_pixels, w, h, w,
             scale_for_raster_x, scale_for_raster_y, 0, 0, oversample_h, oversample_v, &sub_x, &sub_y, glyph_index);
 
-        const float ref_size = baked->OwnerFont->Sources[0]->SizePixels;
-        const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
-        float font_off_x = (src->GlyphOffset.x * offsets_scale);
-        float font_off_y = (src->GlyphOffset.y * offsets_scale);
-        if (src->PixelSnapH) // Snap scaled offset. This is to mitigate backward compatibility issues for GlyphOffset, but a better design would be welcome.
-            font_off_x = IM_ROUND(font_off_x);
-        if (src->PixelSnapV)
-            font_off_y = IM_ROUND(font_off_y);
-        font_off_x += sub_x;
-        font_off_y += sub_y + IM_ROUND(baked->Ascent);
-        float recip_h = 1.0f / (oversample_h * rasterizer_density);
-        float recip_v = 1.0f / (oversample_v * rasterizer_density);
-
-        // Register glyph
-        // r->x r->y are coordinates inside texture (in pixels)
-        // glyph.X0, glyph.Y0 are drawing coordinates from base text position, and accounting for oversampling.
-        out_glyph->X0 = x0 * recip_h + font_off_x;
-        out_glyph->Y0 = y0 * recip_v + font_off_y;
-        out_glyph->X1 = (x0 + (int)r->w) * recip_h + font_off_x;
-        out_glyph->Y1 = (y0 + (int)r->h) * recip_v + font_off_y;
-        out_glyph->Visible = true;
+        ImGui_ImplStbTrueType_PlaceGlyph(src, baked, out_glyph, r, x0, y0, sub_x, sub_y, oversample_h, oversample_v);
         out_glyph->PackId = pack_id;
         ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, bitmap_pixels, ImTextureFormat_Alpha8, w);
     }
@@ -4756,6 +4815,659 @@ const ImFontLoader* ImFontAtlasGetFontLoaderForStbTruetype()
 
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas: bulk glyph loading
+//-------------------------------------------------------------------------
+// Loading many glyphs at once (legacy backends preloading all glyph ranges, ImFontAtlasBakedLoadGlyphs()) runs in three steps:
+// - Find the source and metrics of each codepoint, in order, on the calling thread.
+// - Rasterize the visible glyphs of stb_truetype sources into one scratch buffer.
+//   With IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER this is spread over ImFontAtlas::RasterizerThreads threads.
+// - Pack and register the glyphs, in order, on the calling thread.
+// Rectangles are packed in the same order as loading each glyph with FindGlyph() would, so the atlas comes out
+// identical to that whatever the number of threads. Codepoints needing anything else (other font loaders,
+// remapping, auto-baked ellipsis, missing glyphs) are loaded through FindGlyph() in their turn.
+//-------------------------------------------------------------------------
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+
+static const int FONT_ATLAS_BULK_GLYPHS_PER_JOB = 32;       // Glyphs a rasterizer thread takes at a time
+static const int FONT_ATLAS_BULK_MAX_THREADS = 16;
+
+struct ImFontAtlasBulkSource
+{
+    ImGui_ImplStbTrueType_FontSrcData*  Data;           // NULL when the source uses another font loader
+    int                                 OversampleH, OversampleV;
+    float                               ScaleForLayout;
+    float                               ScaleForRasterX, ScaleForRasterY;
+};
+
+struct ImFontAtlasBulkGlyph
+{
+    ImWchar     Codepoint;
+    int         SrcIdx;         // -1: load through FindGlyph()
+    int         GlyphIndex;     // stb_truetype glyph index
+    int         X0, Y0;         // Bitmap box origin
+    int         W, H;           // Bitmap size including oversampling. 0 when not visible.
+    int         PixelsOffset;   // Into ImFontAtlasBulkLoad::Pixels
+    float       AdvanceX;
+    float       SubX, SubY;     // Output of stbtt_MakeGlyphBitmapSubpixelPrefilter()
+};
+
+struct ImFontAtlasBulkLoad
+{
+    ImVector<ImFontAtlasBulkSource> Sources;
+    ImVector<ImFontAtlasBulkGlyph>  Glyphs;
+    ImVector<unsigned char>         Pixels;
+};
+
+static void ImFontAtlasBulkRasterize(ImFontAtlasBulkLoad* load, int glyph_begin, int glyph_end, ImFontAtlasThreadAllocator* allocator)
+{
+    for (int glyph_n = glyph_begin; glyph_n < glyph_end; glyph_n++)
+    {
+        ImFontAtlasBulkGlyph& glyph = load->Glyphs[glyph_n];
+        if (glyph.SrcIdx < 0 || glyph.W == 0)
+            continue;
+        const ImFontAtlasBulkSource& bulk_src = load->Sources[glyph.SrcIdx];
+        stbtt_fontinfo font_info = bulk_src.Data->FontInfo; // stb_truetype only reads it, but allocates through its userdata
+        font_info.userdata = allocator;
+        unsigned char* pixels = load->Pixels.Data + glyph.PixelsOffset;
+        memset(pixels, 0, (size_t)(glyph.W * glyph.H));
+        stbtt_MakeGlyphBitmapSubpixelPrefilter(&font_info, pixels, glyph.W, glyph.H, glyph.W,
+            bulk_src.ScaleForRasterX, bulk_src.ScaleForRasterY, 0, 0, bulk_src.OversampleH, bulk_src.OversampleV, &glyph.SubX, &glyph.SubY, glyph.GlyphIndex);
+    }
+}
+
+#ifdef IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER
+struct ImFontAtlasBulkWork
+{
+    ImFontAtlasBulkLoad*        Load;
+    ImFontAtlasThreadAllocator  Allocator;
+    std::atomic<int>            NextGlyph;
+};
+
+static void ImFontAtlasBulkRasterizeWorker(ImFontAtlasBulkWork* work, bool on_calling_thread)
+{
+    const int glyph_count = work->Load->Glyphs.Size;
+    for (int glyph_begin = work->NextGlyph.fetch_add(FONT_ATLAS_BULK_GLYPHS_PER_JOB); glyph_begin < glyph_count; glyph_begin = work->NextGlyph.fetch_add(FONT_ATLAS_BULK_GLYPHS_PER_JOB))
+        ImFontAtlasBulkRasterize(work->Load, glyph_begin, ImMin(glyph_begin + FONT_ATLAS_BULK_GLYPHS_PER_JOB, glyph_count), on_calling_thread ? NULL : &work->Allocator);
+}
+#endif
+
+void ImFontAtlasBakedLoadGlyphs(ImFontAtlas* atlas, ImFontBaked* baked, const ImWchar* codepoints, int codepoints_count)
+{
+    ImFont* font = baked->OwnerFont;
+    if (atlas->Locked || (font->Flags & ImFontFlags_NoLoadGlyphs) || font->RemapPairs.Data.Size != 0)
+    {
+        for (int n = 0; n < codepoints_count; n++)
+            baked->FindGlyph(codepoints[n]);
+        return;
+    }
+
+    ImFontAtlasBulkLoad load;
+    load.Sources.resize(font->Sources.Size);
+    for (int src_n = 0; src_n < font->Sources.Size; src_n++)
+    {
+        ImFontConfig* src = font->Sources[src_n];
+        const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+        ImFontAtlasBulkSource& bulk_src = load.Sources[src_n];
+        bulk_src.Data = (loader == ImFontAtlasGetFontLoaderForStbTruetype()) ? (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData : NULL;
+        if (bulk_src.Data == NULL)
+            continue;
+        ImFontAtlasBuildGetOversampleFactors(src, baked, &bulk_src.OversampleH, &bulk_src.OversampleV);
+        const float rasterizer_density = src->RasterizerDensity * baked->RasterizerDensity;
+        bulk_src.ScaleForLayout = bulk_src.Data->ScaleFactor * baked->Size;
+        bulk_src.ScaleForRasterX = bulk_src.Data->ScaleFactor * baked->Size * rasterizer_density * bulk_src.OversampleH;
+        bulk_src.ScaleForRasterY = bulk_src.Data->ScaleFactor * baked->Size * rasterizer_density * bulk_src.OversampleV;
+    }
+
+    // 1. Find source and metrics. Skip codepoints already loaded or listed twice: FindGlyph() would return early for them.
+    ImBitVector seen;
+    seen.Create(IM_UNICODE_CODEPOINT_MAX + 1);
+    int pixels_size = 0;
+    int raster_count = 0;
+    load.Glyphs.reserve(codepoints_count);
+    for (int n = 0; n < codepoints_count; n++)
+    {
+        const ImWchar c = codepoints[n];
+        if (((int)c < baked->IndexLookup.Size && baked->IndexLookup.Data[c] != IM_FONTGLYPH_INDEX_UNUSED) || seen.TestBit(c))
+            continue;
+        seen.SetBit(c);
+
+        load.Glyphs.push_back(ImFontAtlasBulkGlyph());
+        ImFontAtlasBulkGlyph& glyph = load.Glyphs.back();
+        glyph.Codepoint = c;
+        glyph.SrcIdx = -1;
+        if (c == font->EllipsisChar && font->EllipsisAutoBake)
+            continue;
+        for (int src_n = 0; src_n < font->Sources.Size; src_n++)
+        {
+            ImFontConfig* src = font->Sources[src_n];
+            if (src->GlyphExcludeRanges && !ImFontAtlasBuildAcceptCodepointForSource(src, c))
+                continue;
+            const ImFontAtlasBulkSource& bulk_src = load.Sources[src_n];
+            if (bulk_src.Data == NULL)
+                break; // Leave the whole search to the source's loader
+            const int glyph_index = stbtt_FindGlyphIndex(&bulk_src.Data->FontInfo, (int)c);
+            if (glyph_index == 0)
+                continue;
+
+            int x0, y0, x1, y1;
+            int advance, lsb;
+            stbtt_GetGlyphBitmapBoxSubpixel(&bulk_src.Data->FontInfo, glyph_index, bulk_src.ScaleForRasterX, bulk_src.ScaleForRasterY, 0, 0, &x0, &y0, &x1, &y1);
+            stbtt_GetGlyphHMetrics(&bulk_src.Data->FontInfo, glyph_index, &advance, &lsb);
+            glyph.SrcIdx = src_n;
+            glyph.GlyphIndex = glyph_index;
+            glyph.AdvanceX = advance * bulk_src.ScaleForLayout;
+            if (x0 != x1 && y0 != y1)
+            {
+                glyph.X0 = x0;
+                glyph.Y0 = y0;
+                glyph.W = x1 - x0 + bulk_src.OversampleH - 1;
+                glyph.H = y1 - y0 + bulk_src.OversampleV - 1;
+                glyph.PixelsOffset = pixels_size;
+                pixels_size += glyph.W * glyph.H;
+                raster_count++;
+            }
+            break;
+        }
+    }
+    seen.Clear();
+
+    // 2. Rasterize
+    load.Pixels.resize(pixels_size);
+    int threads_count = 1;
+#if defined(IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER) && !defined(IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION)
+    threads_count = (atlas->RasterizerThreads > 0) ? atlas->RasterizerThreads : (int)std::thread::hardware_concurrency();
+    threads_count = ImClamp(ImMin(threads_count, raster_count / FONT_ATLAS_BULK_GLYPHS_PER_JOB), 1, FONT_ATLAS_BULK_MAX_THREADS);
+    if (threads_count > 1)
+    {
+        ImFontAtlasBulkWork work;
+        work.Load = &load;
+        ImGui::GetAllocatorFunctions(&work.Allocator.AllocFunc, &work.Allocator.FreeFunc, &work.Allocator.UserData);
+        work.NextGlyph = 0;
+        std::thread workers[FONT_ATLAS_BULK_MAX_THREADS];
+        for (int thread_n = 1; thread_n < threads_count; thread_n++)
+            workers[thread_n] = std::thread(ImFontAtlasBulkRasterizeWorker, &work, false);
+        ImFontAtlasBulkRasterizeWorker(&work, true);
+        for (int thread_n = 1; thread_n < threads_count; thread_n++)
+            workers[thread_n].join();
+    }
+#endif
+    if (threads_count == 1)
+        ImFontAtlasBulkRasterize(&load, 0, load.Glyphs.Size, NULL);
+    IMGUI_DEBUG_LOG_FONT("[font] BakedLoadGlyphs: %d glyphs, %d rasterized on %d thread(s)\n", load.Glyphs.Size, raster_count, threads_count);
+
+    // 3. Pack and register, in order
+    for (const ImFontAtlasBulkGlyph& bulk_glyph : load.Glyphs)
+    {
+        const ImWchar c = bulk_glyph.Codepoint;
+        if (bulk_glyph.SrcIdx < 0)
+        {
+            baked->FindGlyph(c);
+            continue;
+        }
+        if ((int)c < baked->IndexLookup.Size && baked->IndexLookup.Data[c] != IM_FONTGLYPH_INDEX_UNUSED)
+            continue; // Loaded meanwhile, e.g. as the fallback glyph
+
+        ImFontConfig* src = font->Sources[bulk_glyph.SrcIdx];
+        const ImFontAtlasBulkSource& bulk_src = load.Sources[bulk_glyph.SrcIdx];
+        ImFontGlyph glyph;
+        glyph.Codepoint = c;
+        glyph.AdvanceX = bulk_glyph.AdvanceX;
+        if (bulk_glyph.W != 0)
+        {
+            ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, bulk_glyph.W, bulk_glyph.H);
+            if (pack_id == ImFontAtlasRectId_Invalid)
+            {
+                baked->FindGlyph(c); // Out of texture memory: take the regular path, which reports it
+                continue;
+            }
+            ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+            ImGui_ImplStbTrueType_PlaceGlyph(src, baked, &glyph, r, bulk_glyph.X0, bulk_glyph.Y0, bulk_glyph.SubX, bulk_glyph.SubY, bulk_src.OversampleH, bulk_src.OversampleV);
+            glyph.PackId = pack_id;
+            ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, &glyph, r, load.Pixels.Data + bulk_glyph.PixelsOffset, ImTextureFormat_Alpha8, bulk_glyph.W);
+        }
+        glyph.SourceIdx = bulk_glyph.SrcIdx;
+        ImFontAtlasBakedAddFontGlyph(atlas, baked, src, &glyph);
+    }
+}
+
+#else
+
+void ImFontAtlasBakedLoadGlyphs(ImFontAtlas* atlas, ImFontBaked* baked, const ImWchar* codepoints, int codepoints_count)
+{
+    IM_UNUSED(atlas);
+    for (int n = 0; n < codepoints_count; n++)
+        baked->FindGlyph(codepoints[n]);
+}
+
+#endif // IMGUI_ENABLE_STB_TRUETYPE
+
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas: baked font cache
+//-------------------------------------------------------------------------
+// ImFontAtlasBakedSaveToFile() writes the glyphs of one baked font (metrics as registered, and their pixels read back
+// from the texture) to a file. ImFontAtlasBakedLoadFromFile() maps that file and registers the glyphs again, so the
+// next run can skip rasterizing whatever it displayed last time.
+// - The file is keyed on everything rasterization depends on: the font data of every source, their configuration,
+//   the font loader, the baked size and density, and the texture format. Any mismatch and the load fails, leaving the
+//   baked font to load its glyphs on demand as usual: the cache never needs invalidating by hand.
+// - Glyphs are packed again into the current atlas rather than restoring the packer state from the previous run,
+//   since other fonts, sizes and custom rects may have been added differently. Pixels are copied as stored,
+//   post-processing (e.g. RasterizerMultiply) having already been applied.
+// - Codepoints which were missing from the font are not stored: they are looked up again when needed.
+//-------------------------------------------------------------------------
+
+static const ImU32 FONT_BAKED_CACHE_MAGIC = 0x43424649;     // "IFBC"
+static const ImU32 FONT_BAKED_CACHE_VERSION = 1;
+
+struct ImFontBakedCacheHeader
+{
+    ImU32           Magic;
+    ImU32           Version;
+    ImU32           Key;
+    int             GlyphsCount;
+    ImU32           PixelsSize;
+    ImU32           DataHash;       // Of everything after the header
+};
+
+struct ImFontBakedCacheGlyph
+{
+    ImFontGlyph     Glyph;          // With zero UV and no PackId
+    int             W, H;           // Size of the packed rectangle, 0 when not visible
+};
+
+// Every field which ends up in glyph metrics or pixels. All 4 bytes, so there is no padding to hash.
+struct ImFontBakedCacheSourceKey
+{
+    ImU32           FontDataHash;
+    int             FontDataSize;
+    ImU32           FontNo;
+    ImU32           FontLoaderFlags;
+    ImU32           FontLoaderNameHash;
+    ImU32           GlyphExcludeRangesHash;
+    int             Flags;
+    int             OversampleH, OversampleV;
+    int             PixelSnapH, PixelSnapV;
+    int             EllipsisChar;
+    float           SizePixels;
+    float           GlyphOffsetX, GlyphOffsetY;
+    float           GlyphMinAdvanceX, GlyphMaxAdvanceX, GlyphExtraAdvanceX;
+    float           RasterizerMultiply;
+    float           RasterizerDensity;
+};
+
+static ImU32 ImFontAtlasBakedCacheKey(ImFontAtlas* atlas, ImFontBaked* baked)
+{
+    ImFont* font = baked->OwnerFont;
+    const int header[] = { IMGUI_VERSION_NUM, (int)FONT_BAKED_CACHE_VERSION, (int)sizeof(ImFontGlyph), atlas->TexData->Format, (int)atlas->FontLoaderFlags, font->Flags, font->EllipsisChar, font->EllipsisAutoBake, font->Sources.Size };
+    const float sizes[] = { baked->Size, baked->RasterizerDensity };
+    ImU32 key = ImHashMurmur64A(header, sizeof(header), 0);
+    key = ImHashMurmur64A(sizes, sizeof(sizes), key);
+    key = ImHashMurmur64A(font->RemapPairs.Data.Data, (size_t)font->RemapPairs.Data.size_in_bytes(), key);
+    for (ImFontConfig* src : font->Sources)
+    {
+        const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+        ImFontBakedCacheSourceKey src_key;
+        memset(&src_key, 0, sizeof(src_key));
+        src_key.FontDataHash = ImHashMurmur64A(src->FontData, (size_t)src->FontDataSize, 0);
+        src_key.FontDataSize = src->FontDataSize;
+        src_key.FontNo = src->FontNo;
+        src_key.FontLoaderFlags = src->FontLoaderFlags;
+        src_key.FontLoaderNameHash = (loader && loader->Name) ? ImHashStr(loader->Name) : 0;
+        if (const ImWchar* exclude_list = src->GlyphExcludeRanges)
+        {
+            int exclude_count = 0;
+            while (exclude_list[exclude_count] != 0)
+                exclude_count++;
+            src_key.GlyphExcludeRangesHash = ImHashMurmur64A(exclude_list, exclude_count * sizeof(ImWchar), 1);
+        }
+        src_key.Flags = src->Flags;
+        src_key.OversampleH = src->OversampleH;
+        src_key.OversampleV = src->OversampleV;
+        src_key.PixelSnapH = src->PixelSnapH;
+        src_key.PixelSnapV = src->PixelSnapV;
+        src_key.EllipsisChar = src->EllipsisChar;
+        src_key.SizePixels = src->SizePixels;
+        src_key.GlyphOffsetX = src->GlyphOffset.x;
+        src_key.GlyphOffsetY = src->GlyphOffset.y;
+        src_key.GlyphMinAdvanceX = src->GlyphMinAdvanceX;
+        src_key.GlyphMaxAdvanceX = src->GlyphMaxAdvanceX;
+        src_key.GlyphExtraAdvanceX = src->GlyphExtraAdvanceX;
+        src_key.RasterizerMultiply = src->RasterizerMultiply;
+        src_key.RasterizerDensity = src->RasterizerDensity;
+        key = ImHashMurmur64A(&src_key, sizeof(src_key), key);
+    }
+    return key;
+}
+
+// Return false if nothing could be written
+bool ImFontAtlasBakedSaveToFile(ImFontAtlas* atlas, ImFontBaked* baked, const char* filename)
+{
+    ImFontAtlasAsyncGlyphsFlush(atlas);
+    ImTextureData* tex = atlas->TexData;
+    if (atlas->Builder == NULL || tex == NULL || tex->Pixels == NULL)
+        return false;
+    const int bpp = tex->BytesPerPixel;
+
+    ImVector<ImFontBakedCacheGlyph> glyphs;
+    ImVector<unsigned char> pixels;
+    glyphs.reserve(baked->Glyphs.Size);
+    for (const ImFontGlyph& glyph : baked->Glyphs)
+    {
+        ImFontBakedCacheGlyph cache_glyph;
+        memset(&cache_glyph, 0, sizeof(cache_glyph));
+        cache_glyph.Glyph = glyph;
+        cache_glyph.Glyph.U0 = cache_glyph.Glyph.V0 = cache_glyph.Glyph.U1 = cache_glyph.Glyph.V1 = 0.0f;
+        cache_glyph.Glyph.PackId = ImFontAtlasRectId_Invalid;
+        if (ImTextureRect* r = ImFontAtlasPackGetRectSafe(atlas, glyph.PackId))
+        {
+            cache_glyph.W = r->w;
+            cache_glyph.H = r->h;
+            const int row_size = r->w * bpp;
+            pixels.resize(pixels.Size + row_size * r->h);
+            unsigned char* dst = pixels.Data + pixels.Size - row_size * r->h;
+            for (int y = 0; y < r->h; y++, dst += row_size)
+                memcpy(dst, tex->GetPixelsAt(r->x, r->y + y), (size_t)row_size);
+        }
+        glyphs.push_back(cache_glyph);
+    }
+
+    ImFontBakedCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = FONT_BAKED_CACHE_MAGIC;
+    header.Version = FONT_BAKED_CACHE_VERSION;
+    header.Key = ImFontAtlasBakedCacheKey(atlas, baked);
+    header.GlyphsCount = glyphs.Size;
+    header.PixelsSize = (ImU32)pixels.Size;
+    header.DataHash = ImHashMurmur64A(pixels.Data, (size_t)pixels.Size, ImHashMurmur64A(glyphs.Data, (size_t)glyphs.size_in_bytes(), 0));
+
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    bool ok = ImFileWrite(&header, sizeof(header), 1, f) == 1;
+    ok &= glyphs.Size == 0 || ImFileWrite(glyphs.Data, (ImU64)glyphs.size_in_bytes(), 1, f) == 1;
+    ok &= pixels.Size == 0 || ImFileWrite(pixels.Data, (ImU64)pixels.Size, 1, f) == 1;
+    ok &= ImFileClose(f);
+    return ok;
+}
+
+// Return false when the file is missing, truncated or was written for a different font/configuration.
+// Codepoints already loaded in 'baked' are left untouched.
+bool ImFontAtlasBakedLoadFromFile(ImFontAtlas* atlas, ImFontBaked* baked, const char* filename)
+{
+    if (atlas->Builder == NULL)
+        ImFontAtlasBuildInit(atlas);
+
+    size_t file_size = 0;
+    const unsigned char* file_data = (const unsigned char*)ImFileMapReadOnly(filename, &file_size);
+    if (file_data == NULL)
+        return false;
+
+    // Validate everything before touching the atlas
+    ImFontBakedCacheHeader header;
+    bool ok = file_size >= sizeof(header);
+    if (ok)
+    {
+        memcpy(&header, file_data, sizeof(header));
+        const size_t glyphs_size = (size_t)ImMax(header.GlyphsCount, 0) * sizeof(ImFontBakedCacheGlyph);
+        ok = header.Magic == FONT_BAKED_CACHE_MAGIC && header.Version == FONT_BAKED_CACHE_VERSION && header.GlyphsCount >= 0;
+        ok = ok && file_size == sizeof(header) + glyphs_size + header.PixelsSize;
+        ok = ok && header.Key == ImFontAtlasBakedCacheKey(atlas, baked);
+        ok = ok && header.DataHash == ImHashMurmur64A(file_data + sizeof(header) + glyphs_size, header.PixelsSize, ImHashMurmur64A(file_data + sizeof(header), glyphs_size, 0));
+    }
+    const int bpp = atlas->TexData->BytesPerPixel;
+    ImVector<ImFontBakedCacheGlyph> glyphs;
+    if (ok)
+    {
+        glyphs.resize(header.GlyphsCount);
+        memcpy(glyphs.Data, file_data + sizeof(header), (size_t)glyphs.size_in_bytes());
+        size_t pixels_size = 0;
+        for (const ImFontBakedCacheGlyph& cache_glyph : glyphs)
+        {
+            ok &= cache_glyph.Glyph.Codepoint <= IM_UNICODE_CODEPOINT_MAX && cache_glyph.Glyph.SourceIdx < (unsigned int)baked->OwnerFont->Sources.Size;
+            ok &= cache_glyph.W >= 0 && cache_glyph.H >= 0 && cache_glyph.W <= atlas->TexMaxWidth && cache_glyph.H <= atlas->TexMaxHeight;
+            if (!ok)
+                break;
+            pixels_size += (size_t)(cache_glyph.W * cache_glyph.H * bpp);
+        }
+        ok = ok && pixels_size == header.PixelsSize;
+    }
+    if (!ok)
+    {
+        ImFileUnmap(file_data, file_size);
+        return false;
+    }
+
+    const unsigned char* src_pixels = file_data + sizeof(header) + glyphs.size_in_bytes();
+    for (ImFontBakedCacheGlyph& cache_glyph : glyphs)
+    {
+        ImFontGlyph& glyph = cache_glyph.Glyph;
+        const int src_size = cache_glyph.W * cache_glyph.H * bpp;
+        const bool already_loaded = glyph.Codepoint < (unsigned int)baked->IndexLookup.Size && baked->IndexLookup.Data[glyph.Codepoint] != IM_FONTGLYPH_INDEX_UNUSED;
+        if (!already_loaded)
+        {
+            if (cache_glyph.W > 0 && cache_glyph.H > 0)
+            {
+                ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, cache_glyph.W, cache_glyph.H);
+                if (pack_id == ImFontAtlasRectId_Invalid)
+                    break; // Out of texture space: remaining glyphs will load on demand
+                ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+                ImTextureData* tex = atlas->TexData; // May have been replaced when growing
+                ImFontAtlasTextureBlockConvert(src_pixels, tex->Format, cache_glyph.W * bpp, (unsigned char*)tex->GetPixelsAt(r->x, r->y), tex->Format, tex->GetPitch(), r->w, r->h);
+                ImFontAtlasTextureBlockQueueUpload(atlas, tex, r->x, r->y, r->w, r->h);
+                glyph.PackId = pack_id;
+            }
+            ImFontAtlasBakedAddFontGlyph(atlas, baked, NULL, &glyph); // Stored metrics are already adjusted for 'src'
+        }
+        src_pixels += src_size;
+    }
+    ImFileUnmap(file_data, file_size);
+    return true;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas: asynchronous glyph baking
+//-------------------------------------------------------------------------
+// With ImFontAtlasFlags_AsyncGlyphBaking, a glyph first needed in the middle of a frame is not rasterized there:
+// - The stb_truetype loader still computes its metrics and packs its rectangle right away, so layout is final and
+//   the glyph can be drawn. Its texels stay blank, which is the placeholder, until rasterized.
+// - A worker thread owned by the atlas builder rasterizes queued glyphs into buffers allocated by the calling thread.
+// - ImFontAtlasUpdateNewFrame() copies finished glyphs into the texture and queues their upload, normally on the next
+//   frame. Glyphs still being rasterized wait for a later frame: NewFrame() never waits on the worker.
+// Anything that would invalidate a queued glyph (discarding its baked font, destroying its source, rebuilding the atlas)
+// or reads texels back (auto-baked ellipsis, ImFontAtlasBakedSaveToFile()) calls ImFontAtlasAsyncGlyphsFlush() first.
+// Only available with IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER and a backend supporting ImGuiBackendFlags_RendererHasTextures.
+//-------------------------------------------------------------------------
+
+#if defined(IMGUI_ENABLE_STB_TRUETYPE) && defined(IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER) && !defined(IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION)
+
+struct ImFontAtlasAsyncGlyph
+{
+    ImGui_ImplStbTrueType_FontSrcData*  FontSrcData;    // Heap allocated: doesn't move when ImFontAtlas::Sources[] grows
+    ImGuiID                             BakedId;        // ImFontBaked* may move when the pool is compacted
+    int                                 SrcIdx;
+    int                                 GlyphIdx;       // Into ImFontBaked::Glyphs[]
+    int                                 GlyphIndex;     // stb_truetype glyph index
+    ImFontAtlasRectId                   PackId;
+    int                                 W, H;
+    int                                 OversampleH, OversampleV;
+    float                               ScaleForRasterX, ScaleForRasterY;
+    unsigned char*                      Pixels;         // Allocated and freed by the calling thread
+    bool                                Done;           // Guarded by ImFontAtlasAsyncBaker::Mutex
+};
+
+struct ImFontAtlasAsyncBaker
+{
+    std::thread                         Thread;
+    std::mutex                          Mutex;
+    std::condition_variable             WakeWorker;     // Glyphs queued, or quitting
+    std::condition_variable             GlyphDone;
+    ImVector<ImFontAtlasAsyncGlyph*>    Queue;          // In order. Finished glyphs form a prefix.
+    int                                 NextToRasterize;
+    bool                                Quit;
+    ImFontAtlasThreadAllocator          Allocator;
+
+    ImFontAtlasAsyncBaker()             { NextToRasterize = 0; Quit = false; ImGui::GetAllocatorFunctions(&Allocator.AllocFunc, &Allocator.FreeFunc, &Allocator.UserData); }
+};
+
+static void ImFontAtlasAsyncBakerWorker(ImFontAtlasAsyncBaker* baker)
+{
+    std::unique_lock<std::mutex> lock(baker->Mutex);
+    while (true)
+    {
+        if (baker->NextToRasterize < baker->Queue.Size)
+        {
+            ImFontAtlasAsyncGlyph* glyph = baker->Queue[baker->NextToRasterize++];
+            lock.unlock();
+            stbtt_fontinfo font_info = glyph->FontSrcData->FontInfo; // stb_truetype only reads it, but allocates through its userdata
+            font_info.userdata = &baker->Allocator;
+            float sub_x, sub_y;
+            stbtt_MakeGlyphBitmapSubpixelPrefilter(&font_info, glyph->Pixels, glyph->W, glyph->H, glyph->W,
+                glyph->ScaleForRasterX, glyph->ScaleForRasterY, 0, 0, glyph->OversampleH, glyph->OversampleV, &sub_x, &sub_y, glyph->GlyphIndex);
+            lock.lock();
+            glyph->Done = true;
+            baker->GlyphDone.notify_all();
+        }
+        else if (baker->Quit)
+        {
+            break;
+        }
+        else
+        {
+            baker->WakeWorker.wait(lock);
+        }
+    }
+}
+
+// Called by the stb_truetype loader once the glyph rectangle is packed. Return false to rasterize right away.
+static bool ImFontAtlasAsyncGlyphsQueue(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, int glyph_index, ImFontAtlasRectId pack_id, int w, int h, int oversample_h, int oversample_v, float scale_for_raster_x, float scale_for_raster_y)
+{
+    if ((atlas->Flags & ImFontAtlasFlags_AsyncGlyphBaking) == 0 || !atlas->RendererHasTextures)
+        return false;
+    int src_idx = 0;
+    while (src_idx < baked->OwnerFont->Sources.Size && baked->OwnerFont->Sources[src_idx] != src)
+        src_idx++;
+    if (src_idx == baked->OwnerFont->Sources.Size)
+        return false;
+
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontAtlasAsyncBaker* baker = builder->AsyncBaker;
+    if (baker == NULL)
+    {
+        baker = builder->AsyncBaker = IM_NEW(ImFontAtlasAsyncBaker)();
+        baker->Thread = std::thread(ImFontAtlasAsyncBakerWorker, baker);
+    }
+
+    ImFontAtlasAsyncGlyph* glyph = IM_NEW(ImFontAtlasAsyncGlyph)();
+    glyph->FontSrcData = (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData;
+    glyph->BakedId = baked->BakedId;
+    glyph->SrcIdx = src_idx;
+    glyph->GlyphIdx = baked->Glyphs.Size; // Caller registers it next
+    glyph->GlyphIndex = glyph_index;
+    glyph->PackId = pack_id;
+    glyph->W = w;
+    glyph->H = h;
+    glyph->OversampleH = oversample_h;
+    glyph->OversampleV = oversample_v;
+    glyph->ScaleForRasterX = scale_for_raster_x;
+    glyph->ScaleForRasterY = scale_for_raster_y;
+    glyph->Pixels = (unsigned char*)IM_ALLOC(w * h);
+    memset(glyph->Pixels, 0, (size_t)(w * h));
+    glyph->Done = false;
+    {
+        std::lock_guard<std::mutex> lock(baker->Mutex);
+        baker->Queue.push_back(glyph);
+    }
+    baker->WakeWorker.notify_one();
+    return true;
+}
+
+static void ImFontAtlasAsyncGlyphsApply(ImFontAtlas* atlas, bool wait_for_all)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontAtlasAsyncBaker* baker = builder ? builder->AsyncBaker : NULL;
+    if (baker == NULL)
+        return;
+
+    ImVector<ImFontAtlasAsyncGlyph*> done;
+    {
+        std::unique_lock<std::mutex> lock(baker->Mutex);
+        if (wait_for_all)
+            while (baker->Queue.Size > 0 && !baker->Queue.back()->Done)
+                baker->GlyphDone.wait(lock);
+        int done_count = 0;
+        while (done_count < baker->Queue.Size && baker->Queue[done_count]->Done)
+            done_count++;
+        if (done_count == 0)
+            return;
+        done.resize(done_count);
+        memcpy(done.Data, baker->Queue.Data, (size_t)done.size_in_bytes());
+        baker->Queue.erase(baker->Queue.Data, baker->Queue.Data + done_count);
+        baker->NextToRasterize -= done_count;
+    }
+
+    for (ImFontAtlasAsyncGlyph* async_glyph : done)
+    {
+        ImFontBaked* baked = (ImFontBaked*)builder->BakedMap.GetVoidPtr(async_glyph->BakedId);
+        ImTextureRect* r = ImFontAtlasPackGetRectSafe(atlas, async_glyph->PackId);
+        IM_ASSERT(baked != NULL && r != NULL); // Should have been flushed before discarding either
+        if (baked != NULL && r != NULL)
+        {
+            ImFontGlyph* glyph = &baked->Glyphs[async_glyph->GlyphIdx];
+            IM_ASSERT(glyph->PackId == async_glyph->PackId);
+            ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, baked->OwnerFont->Sources[async_glyph->SrcIdx], glyph, r, async_glyph->Pixels, ImTextureFormat_Alpha8, async_glyph->W);
+        }
+        IM_FREE(async_glyph->Pixels);
+        IM_DELETE(async_glyph);
+    }
+}
+
+static void ImFontAtlasAsyncGlyphsShutdown(ImFontAtlas* atlas)
+{
+    ImFontAtlasAsyncGlyphsApply(atlas, true);
+    ImFontAtlasAsyncBaker* baker = atlas->Builder->AsyncBaker;
+    if (baker == NULL)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(baker->Mutex);
+        baker->Quit = true;
+    }
+    baker->WakeWorker.notify_one();
+    baker->Thread.join();
+    IM_DELETE(baker);
+    atlas->Builder->AsyncBaker = NULL;
+}
+
+void ImFontAtlasAsyncGlyphsUpdate(ImFontAtlas* atlas)
+{
+    ImFontAtlasAsyncGlyphsApply(atlas, false);
+}
+
+void ImFontAtlasAsyncGlyphsFlush(ImFontAtlas* atlas)
+{
+    ImFontAtlasAsyncGlyphsApply(atlas, true);
+}
+
+int ImFontAtlasAsyncGlyphsGetPendingCount(ImFontAtlas* atlas)
+{
+    ImFontAtlasAsyncBaker* baker = atlas->Builder ? atlas->Builder->AsyncBaker : NULL;
+    if (baker == NULL)
+        return 0;
+    std::lock_guard<std::mutex> lock(baker->Mutex);
+    return baker->Queue.Size;
+}
+
+#else
+
+static bool ImFontAtlasAsyncGlyphsQueue(ImFontAtlas*, ImFontConfig*, ImFontBaked*, int, ImFontAtlasRectId, int, int, int, int, float, float) { return false; }
+static void ImFontAtlasAsyncGlyphsShutdown(ImFontAtlas*) {}
+void ImFontAtlasAsyncGlyphsUpdate(ImFontAtlas*) {}
+void ImFontAtlasAsyncGlyphsFlush(ImFontAtlas*) {}
+int  ImFontAtlasAsyncGlyphsGetPendingCount(ImFontAtlas*) { return 0; }
+
+#endif
+
 //-------------------------------------------------------------------------
 // [SECTION] ImFontAtlas: glyph ranges helpers
 //-------------------------------------------------------------------------
@@ -5408,9 +6120,30 @@ const char* ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* t
     bool inside_word = true;
 
     const char* s = text;
+    const ImU32 word_break_mask = (1u << (' ' - 0x20)) | (1u << ('!' - 0x20)) | (1u << ('\"' - 0x20)) | (1u << (',' - 0x20)) | (1u << ('.' - 0x20)) | (1u << (';' - 0x20)) | (1u << ('?' - 0x20)); // Blank and the separators below
     IM_ASSERT(text_end != NULL);
     while (s < text_end)
     {
+        // Inside a word, printable ASCII other than blanks and separators only makes the word longer: do it in a tight loop.
+        // Words are short, so classifying each byte here beats scanning ahead with ImTextFindNonPrintableAscii().
+        // The character that would overflow wrap_width, and anything else, is left to the regular path below.
+        if (inside_word)
+        {
+            while (s < text_end)
+            {
+                const unsigned int c = (unsigned char)*s;
+                if (c - 0x20 >= 0x60 || (c < 0x40 && ((word_break_mask >> (c - 0x20)) & 1)))
+                    break;
+                const float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
+                if (char_width < 0.0f || line_width + (word_width + char_width) > wrap_width)
+                    break;
+                word_width += char_width;
+                word_end = ++s;
+            }
+            if (s >= text_end)
+                break;
+        }
+
         unsigned int c = (unsigned int)*s;
         const char* next_s;
         if (c < 0x80)
@@ -5530,6 +6263,27 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
             }
         }
 
+        // Runs of printable ASCII need no decoding and hold no \n or \r: sum their advances in a tight loop.
+        // Glyphs not loaded yet and reaching max_width are left to the regular path below.
+        if ((unsigned char)(*s - 0x20) < 0x60)
+        {
+            const char* run_end = ImTextFindNonPrintableAscii(s + 1, word_wrap_enabled ? ImMin(word_wrap_eol, text_end_display) : text_end_display);
+            while (s < run_end)
+            {
+                const unsigned int c = (unsigned char)*s;
+                float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
+                if (char_width < 0.0f)
+                    break;
+                char_width *= scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+                s++;
+            }
+            if (s == run_end)
+                continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
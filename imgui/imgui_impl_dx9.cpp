@@ -17,6 +17,8 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-19: DirectX9: Vertex and index buffers are used as rings appended to with D3DLOCK_NOOVERWRITE, grow geometrically, and unchanged draw lists are not uploaded again. Added ImGui_ImplDX9_GetRenderStats().
+//  2026-10-19: DirectX9: Vertex and texture color conversions moved to imgui_impl_dx9_convert.h, with SSE2 and AVX2 paths.
 //  2025-09-18: Call platform_io.ClearRendererHandlers() on shutdown.
 //  2025-06-11: DirectX9: Added support for ImGuiBackendFlags_RendererHasTextures, for dynamic font atlas.
 //  2024-10-07: DirectX9: Changed default texture sampler to Clamp instead of Repeat/Wrap.
@@ -43,6 +45,7 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_dx9.h"
+#include "imgui_impl_dx9_convert.h"
 
 // DirectX
 #include <d3d9.h>
@@ -53,6 +56,18 @@
 #pragma clang diagnostic ignored "-Wsign-conversion"        // warning: implicit conversion changes signedness
 #endif
 
+// Where a draw list's geometry was last uploaded, and a copy of what was uploaded to tell whether it changed since
+struct ImGui_ImplDX9_DrawListCache
+{
+    const ImDrawList*           DrawList;       // nullptr: free entry
+    ImVector<ImDrawVert>        VtxCopy;
+    ImVector<ImDrawIdx>         IdxCopy;
+    int                         VtxStart;       // In vertices/indices from the start of pVB/pIB
+    int                         IdxStart;
+    int                         Epoch;          // Value of ImGui_ImplDX9_Data::BufferEpoch when uploaded
+    int                         LastFrame;
+};
+
 // DirectX data
 struct ImGui_ImplDX9_Data
 {
@@ -61,25 +76,21 @@ struct ImGui_ImplDX9_Data
     LPDIRECT3DINDEXBUFFER9      pIB;
     int                         VertexBufferSize;
     int                         IndexBufferSize;
+    int                         VertexBufferUsed;   // Ring write positions. Everything before them is intact until the next D3DLOCK_DISCARD.
+    int                         IndexBufferUsed;
+    int                         BufferEpoch;        // Incremented on every discard or recreation of pVB/pIB
+    int                         FrameCount;
     bool                        HasRgbaSupport;
+    ImVector<ImGui_ImplDX9_DrawListCache> DrawListCache;
+    ImVector<int>               DrawListCacheIndex; // Per ImDrawData::CmdLists[] entry, this frame
+    ImGui_ImplDX9_RenderStats   Stats;
 
     ImGui_ImplDX9_Data()        { memset((void*)this, 0, sizeof(*this)); VertexBufferSize = 5000; IndexBufferSize = 10000; }
 };
 
-struct CUSTOMVERTEX
-{
-    float    pos[3];
-    D3DCOLOR col;
-    float    uv[2];
-};
+typedef ImGui_ImplDX9_Vertex CUSTOMVERTEX;    // See imgui_impl_dx9_convert.h
 #define D3DFVF_CUSTOMVERTEX (D3DFVF_XYZ|D3DFVF_DIFFUSE|D3DFVF_TEX1)
 
-#ifdef IMGUI_USE_BGRA_PACKED_COLOR
-#define IMGUI_COL_TO_DX9_ARGB(_COL)     (_COL)
-#else
-#define IMGUI_COL_TO_DX9_ARGB(_COL)     (((_COL) & 0xFF00FF00) | (((_COL) & 0xFF0000) >> 16) | (((_COL) & 0xFF) << 16))
-#endif
-
 // Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
 // It is STRONGLY preferred that you use docking branch with multi-viewports (== single Dear ImGui context + multiple windows) instead of multiple Dear ImGui contexts.
 static ImGui_ImplDX9_Data* ImGui_ImplDX9_GetBackendData()
@@ -161,6 +172,68 @@ static void ImGui_ImplDX9_SetupRenderState(ImDrawData* draw_data)
     }
 }
 
+// Pair each draw list with its cache entry in bd->DrawListCacheIndex[]. Entries whose geometry is still in the buffers keep
+// their Epoch, the others get Epoch = -1 and count towards the vertices and indices to upload. Lists are matched by address,
+// usually in the same order as last frame, and compared in full, so a list rebuilt with identical geometry is not uploaded again.
+static void ImGui_ImplDX9_MatchDrawLists(ImDrawData* draw_data, int* out_upload_vtx_count, int* out_upload_idx_count)
+{
+    ImGui_ImplDX9_Data* bd = ImGui_ImplDX9_GetBackendData();
+    ImVector<ImGui_ImplDX9_DrawListCache>& cache = bd->DrawListCache;
+    const int frame = ++bd->FrameCount;
+    int upload_vtx_count = 0, upload_idx_count = 0;
+    int search_start = 0;
+    bd->DrawListCacheIndex.resize(draw_data->CmdLists.Size);
+    for (int n = 0; n < draw_data->CmdLists.Size; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        int found = -1;
+        for (int i = 0; i < cache.Size && found == -1; i++)
+        {
+            int idx = (search_start + i) % cache.Size;
+            if (cache[idx].DrawList == draw_list && cache[idx].LastFrame != frame)
+                found = idx;
+        }
+        if (found == -1)
+        {
+            for (int idx = 0; idx < cache.Size && found == -1; idx++)
+                if (cache[idx].DrawList == nullptr)
+                    found = idx;
+            if (found == -1)
+            {
+                cache.push_back(ImGui_ImplDX9_DrawListCache());
+                found = cache.Size - 1;
+            }
+            cache[found].DrawList = draw_list;
+            cache[found].Epoch = -1;
+        }
+        search_start = found + 1;
+
+        ImGui_ImplDX9_DrawListCache& entry = cache[found];
+        entry.LastFrame = frame;
+        bd->DrawListCacheIndex[n] = found;
+        bool unchanged = entry.Epoch == bd->BufferEpoch && entry.VtxCopy.Size == draw_list->VtxBuffer.Size && entry.IdxCopy.Size == draw_list->IdxBuffer.Size &&
+            (draw_list->VtxBuffer.Size == 0 || memcmp(entry.VtxCopy.Data, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes()) == 0) &&
+            (draw_list->IdxBuffer.Size == 0 || memcmp(entry.IdxCopy.Data, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes()) == 0);
+        if (!unchanged)
+        {
+            entry.Epoch = -1;
+            upload_vtx_count += draw_list->VtxBuffer.Size;
+            upload_idx_count += draw_list->IdxBuffer.Size;
+        }
+    }
+
+    // Free entries of draw lists that were not rendered this frame
+    for (ImGui_ImplDX9_DrawListCache& entry : cache)
+        if (entry.DrawList != nullptr && entry.LastFrame != frame)
+        {
+            entry.DrawList = nullptr;
+            entry.VtxCopy.clear();
+            entry.IdxCopy.clear();
+        }
+    *out_upload_vtx_count = upload_vtx_count;
+    *out_upload_idx_count = upload_idx_count;
+}
+
 // Render function.
 void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
 {
@@ -178,20 +251,41 @@ void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
             if (tex->Status != ImTextureStatus_OK)
                 ImGui_ImplDX9_UpdateTexture(tex);
 
-    // Create and grow buffers if needed
-    if (!bd->pVB || bd->VertexBufferSize < draw_data->TotalVtxCount)
+    // Find which draw lists are still in the buffers unchanged, and how much has to be uploaded
+    int upload_vtx_count, upload_idx_count;
+    ImGui_ImplDX9_MatchDrawLists(draw_data, &upload_vtx_count, &upload_idx_count);
+
+    // The buffers are used as rings: new geometry is appended after last frame's with D3DLOCK_NOOVERWRITE, so geometry
+    // that did not change can be drawn again from where it is. When the append does not fit, both buffers are discarded
+    // and the whole frame is uploaded from the start. They are sized for two full frames and double when that is exceeded.
+    bool discard = !bd->pVB || !bd->pIB || bd->VertexBufferUsed + upload_vtx_count > bd->VertexBufferSize || bd->IndexBufferUsed + upload_idx_count > bd->IndexBufferSize;
+    if (!bd->pVB || bd->VertexBufferSize < draw_data->TotalVtxCount * 2)
     {
         if (bd->pVB) { bd->pVB->Release(); bd->pVB = nullptr; }
-        bd->VertexBufferSize = draw_data->TotalVtxCount + 5000;
+        while (bd->VertexBufferSize < draw_data->TotalVtxCount * 2)
+            bd->VertexBufferSize *= 2;
+        bd->Stats.BufferResizes++;
         if (device->CreateVertexBuffer(bd->VertexBufferSize * sizeof(CUSTOMVERTEX), D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY, D3DFVF_CUSTOMVERTEX, D3DPOOL_DEFAULT, &bd->pVB, nullptr) < 0)
             return;
+        discard = true;
     }
-    if (!bd->pIB || bd->IndexBufferSize < draw_data->TotalIdxCount)
+    if (!bd->pIB || bd->IndexBufferSize < draw_data->TotalIdxCount * 2)
     {
         if (bd->pIB) { bd->pIB->Release(); bd->pIB = nullptr; }
-        bd->IndexBufferSize = draw_data->TotalIdxCount + 10000;
+        while (bd->IndexBufferSize < draw_data->TotalIdxCount * 2)
+            bd->IndexBufferSize *= 2;
+        bd->Stats.BufferResizes++;
         if (device->CreateIndexBuffer(bd->IndexBufferSize * sizeof(ImDrawIdx), D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY, sizeof(ImDrawIdx) == 2 ? D3DFMT_INDEX16 : D3DFMT_INDEX32, D3DPOOL_DEFAULT, &bd->pIB, nullptr) < 0)
             return;
+        discard = true;
+    }
+    if (discard)
+    {
+        bd->VertexBufferUsed = bd->IndexBufferUsed = 0;
+        bd->BufferEpoch++;
+        bd->Stats.BufferDiscards++;
+        upload_vtx_count = draw_data->TotalVtxCount;
+        upload_idx_count = draw_data->TotalIdxCount;
     }
 
     // Backup the DX9 state
@@ -210,44 +304,57 @@ void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
     device->GetTransform(D3DTS_VIEW, &last_view);
     device->GetTransform(D3DTS_PROJECTION, &last_projection);
 
-    // Allocate buffers
-    CUSTOMVERTEX* vtx_dst;
-    ImDrawIdx* idx_dst;
-    if (bd->pVB->Lock(0, (UINT)(draw_data->TotalVtxCount * sizeof(CUSTOMVERTEX)), (void**)&vtx_dst, D3DLOCK_DISCARD) < 0)
+    // Lock the part of the buffers this frame appends to. (A size of 0 would lock the whole buffer)
+    const DWORD lock_flags = discard ? D3DLOCK_DISCARD : D3DLOCK_NOOVERWRITE;
+    CUSTOMVERTEX* vtx_dst = nullptr;
+    ImDrawIdx* idx_dst = nullptr;
+    if (upload_vtx_count > 0 && bd->pVB->Lock((UINT)(bd->VertexBufferUsed * sizeof(CUSTOMVERTEX)), (UINT)(upload_vtx_count * sizeof(CUSTOMVERTEX)), (void**)&vtx_dst, lock_flags) < 0)
     {
         state_block->Release();
         return;
     }
-    if (bd->pIB->Lock(0, (UINT)(draw_data->TotalIdxCount * sizeof(ImDrawIdx)), (void**)&idx_dst, D3DLOCK_DISCARD) < 0)
+    if (upload_idx_count > 0 && bd->pIB->Lock((UINT)(bd->IndexBufferUsed * sizeof(ImDrawIdx)), (UINT)(upload_idx_count * sizeof(ImDrawIdx)), (void**)&idx_dst, lock_flags) < 0)
     {
-        bd->pVB->Unlock();
+        if (vtx_dst) bd->pVB->Unlock();
         state_block->Release();
         return;
     }
 
-    // Copy and convert all vertices into a single contiguous buffer, convert colors to DX9 default format.
+    // Copy and convert the vertices of new or changed draw lists after the ones already in the buffers, convert colors to DX9 default format.
     // FIXME-OPT: This is a minor waste of resource, the ideal is to use imconfig.h and
     //  1) to avoid repacking colors:   #define IMGUI_USE_BGRA_PACKED_COLOR
     //  2) to avoid repacking vertices: #define IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT struct ImDrawVert { ImVec2 pos; float z; ImU32 col; ImVec2 uv; }
-    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    bd->Stats.VtxBytesUploaded = upload_vtx_count * (int)sizeof(CUSTOMVERTEX);
+    bd->Stats.IdxBytesUploaded = upload_idx_count * (int)sizeof(ImDrawIdx);
+    bd->Stats.VtxBytesDrawn = draw_data->TotalVtxCount * (int)sizeof(CUSTOMVERTEX);
+    bd->Stats.IdxBytesDrawn = draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx);
+    bd->Stats.DrawListsUploaded = bd->Stats.DrawListsReused = 0;
+    for (int n = 0; n < draw_data->CmdLists.Size; n++)
     {
-        const ImDrawVert* vtx_src = draw_list->VtxBuffer.Data;
-        for (int i = 0; i < draw_list->VtxBuffer.Size; i++)
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        ImGui_ImplDX9_DrawListCache& entry = bd->DrawListCache[bd->DrawListCacheIndex[n]];
+        if (entry.Epoch == bd->BufferEpoch)
         {
-            vtx_dst->pos[0] = vtx_src->pos.x;
-            vtx_dst->pos[1] = vtx_src->pos.y;
-            vtx_dst->pos[2] = 0.0f;
-            vtx_dst->col = IMGUI_COL_TO_DX9_ARGB(vtx_src->col);
-            vtx_dst->uv[0] = vtx_src->uv.x;
-            vtx_dst->uv[1] = vtx_src->uv.y;
-            vtx_dst++;
-            vtx_src++;
+            bd->Stats.DrawListsReused++;
+            continue;
         }
+        ImGui_ImplDX9_ConvertVertices(vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size);
+        vtx_dst += draw_list->VtxBuffer.Size;
         memcpy(idx_dst, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
         idx_dst += draw_list->IdxBuffer.Size;
+        entry.VtxCopy.resize(draw_list->VtxBuffer.Size);
+        entry.IdxCopy.resize(draw_list->IdxBuffer.Size);
+        if (draw_list->VtxBuffer.Size > 0) memcpy(entry.VtxCopy.Data, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes());
+        if (draw_list->IdxBuffer.Size > 0) memcpy(entry.IdxCopy.Data, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes());
+        entry.VtxStart = bd->VertexBufferUsed;
+        entry.IdxStart = bd->IndexBufferUsed;
+        entry.Epoch = bd->BufferEpoch;
+        bd->VertexBufferUsed += draw_list->VtxBuffer.Size;
+        bd->IndexBufferUsed += draw_list->IdxBuffer.Size;
+        bd->Stats.DrawListsUploaded++;
     }
-    bd->pVB->Unlock();
-    bd->pIB->Unlock();
+    if (vtx_dst) bd->pVB->Unlock();
+    if (idx_dst) bd->pIB->Unlock();
     device->SetStreamSource(0, bd->pVB, 0, sizeof(CUSTOMVERTEX));
     device->SetIndices(bd->pIB);
     device->SetFVF(D3DFVF_CUSTOMVERTEX);
@@ -257,11 +364,13 @@ void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
 
     // Render command lists
     // (Because we merged all buffers into a single one, we maintain our own offset into them)
-    int global_vtx_offset = 0;
-    int global_idx_offset = 0;
     ImVec2 clip_off = draw_data->DisplayPos;
-    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    for (int n = 0; n < draw_data->CmdLists.Size; n++)
     {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        const ImGui_ImplDX9_DrawListCache& entry = bd->DrawListCache[bd->DrawListCacheIndex[n]];
+        const int global_vtx_offset = entry.VtxStart;
+        const int global_idx_offset = entry.IdxStart;
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
@@ -292,8 +401,6 @@ void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
                 device->DrawIndexedPrimitive(D3DPT_TRIANGLELIST, pcmd->VtxOffset + global_vtx_offset, 0, (UINT)draw_list->VtxBuffer.Size, pcmd->IdxOffset + global_idx_offset, pcmd->ElemCount / 3);
             }
         }
-        global_idx_offset += draw_list->IdxBuffer.Size;
-        global_vtx_offset += draw_list->VtxBuffer.Size;
     }
 
     // Restore the DX9 transform
@@ -361,6 +468,7 @@ void ImGui_ImplDX9_Shutdown()
     io.BackendRendererUserData = nullptr;
     io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
     platform_io.ClearRendererHandlers();
+    bd->DrawListCache.clear_destruct();
     IM_DELETE(bd);
 }
 
@@ -379,8 +487,7 @@ static void ImGui_ImplDX9_CopyTextureRegion(bool tex_use_colors, const ImU32* sr
         const ImU32* src_p = (const ImU32*)(const void*)((const unsigned char*)src + src_pitch * y);
         ImU32* dst_p = (ImU32*)(void*)((unsigned char*)dst + dst_pitch * y);
         if (convert_rgba_to_bgra)
-            for (int x = w; x > 0; x--, src_p++, dst_p++) // Convert copy
-                *dst_p = IMGUI_COL_TO_DX9_ARGB(*src_p);
+            ImGui_ImplDX9_ConvertColors(dst_p, src_p, w); // Convert copy
         else
             memcpy(dst_p, src_p, w * 4); // Raw copy
     }
@@ -468,6 +575,13 @@ void ImGui_ImplDX9_InvalidateDeviceObjects()
     if (bd->pIB) { bd->pIB->Release(); bd->pIB = nullptr; }
 }
 
+void ImGui_ImplDX9_GetRenderStats(ImGui_ImplDX9_RenderStats* out_stats)
+{
+    ImGui_ImplDX9_Data* bd = ImGui_ImplDX9_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplDX9_Init()?");
+    *out_stats = bd->Stats;
+}
+
 void ImGui_ImplDX9_NewFrame()
 {
     ImGui_ImplDX9_Data* bd = ImGui_ImplDX9_GetBackendData();
@@ -34,4 +34,19 @@ IMGUI_IMPL_API void     ImGui_ImplDX9_InvalidateDeviceObjects();
 // (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = NULL to handle this manually.
 IMGUI_IMPL_API void     ImGui_ImplDX9_UpdateTexture(ImTextureData* tex);
 
+// Geometry upload counters. Per frame unless noted, for the last ImGui_ImplDX9_RenderDrawData() call.
+// Draw lists whose geometry is unchanged and still in the vertex/index buffers are drawn from there instead of being uploaded again.
+struct ImGui_ImplDX9_RenderStats
+{
+    int     VtxBytesUploaded;       // Written to the vertex buffer
+    int     IdxBytesUploaded;       // Written to the index buffer
+    int     VtxBytesDrawn;          // Referenced by the frame, uploaded or not. What every frame uploaded before buffers were reused.
+    int     IdxBytesDrawn;
+    int     DrawListsUploaded;
+    int     DrawListsReused;
+    int     BufferDiscards;         // Since init: frames that did not fit after the previous ones and restarted the buffers with D3DLOCK_DISCARD
+    int     BufferResizes;          // Since init: vertex or index buffer (re)creations
+};
+IMGUI_IMPL_API void     ImGui_ImplDX9_GetRenderStats(ImGui_ImplDX9_RenderStats* out_stats);
+
 #endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,113 @@
+// dear imgui: vertex and color conversion for the DirectX9 Renderer Backend
+// No Direct3D dependency, so the kernels can be checked and timed on any platform (see imgui_bench_main.cpp).
+
+// DX9 wants D3DCOLOR (0xAARRGGBB) where Dear ImGui packs 0xAABBGGRR, and a 3D position in its fixed-function vertex.
+// Both conversions run with AVX2 (when compiled with it, e.g. -mavx2 or /arch:AVX2) and SSE2 (any x64 build), with a scalar
+// loop for the remainder and for other targets. Define IMGUI_DISABLE_SSE to only use the scalar loops.
+// With IMGUI_USE_BGRA_PACKED_COLOR colors are already in DX9 order and are copied as is.
+
+#pragma once
+#include "imgui.h"      // ImDrawVert, ImU32
+#ifndef IMGUI_DISABLE
+#include <string.h>     // memcpy
+
+#if (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_IMPL_DX9_ENABLE_SSE2
+#include <immintrin.h>
+#endif
+
+// Layout of D3DFVF_XYZ | D3DFVF_DIFFUSE | D3DFVF_TEX1
+struct ImGui_ImplDX9_Vertex
+{
+    float    pos[3];
+    ImU32    col;
+    float    uv[2];
+};
+
+#ifdef IMGUI_USE_BGRA_PACKED_COLOR
+#define IMGUI_COL_TO_DX9_ARGB(_COL)     (_COL)
+#else
+#define IMGUI_COL_TO_DX9_ARGB(_COL)     (((_COL) & 0xFF00FF00) | (((_COL) & 0xFF0000) >> 16) | (((_COL) & 0xFF) << 16))
+#endif
+
+#ifdef IMGUI_IMPL_DX9_ENABLE_SSE2
+// IMGUI_COL_TO_DX9_ARGB() on 4 colors
+static inline __m128i ImGui_ImplDX9_ColToARGB_SSE2(__m128i col)
+{
+#ifdef IMGUI_USE_BGRA_PACKED_COLOR
+    return col;
+#else
+    const __m128i mask_ag = _mm_set1_epi32((int)0xFF00FF00);
+    const __m128i mask_b = _mm_set1_epi32(0xFF);
+    return _mm_or_si128(_mm_and_si128(col, mask_ag), _mm_or_si128(_mm_and_si128(_mm_srli_epi32(col, 16), mask_b), _mm_slli_epi32(_mm_and_si128(col, mask_b), 16)));
+#endif
+}
+#endif
+
+// Convert 'count' colors from Dear ImGui to DX9 order. 'dst' and 'src' may not overlap.
+static inline void ImGui_ImplDX9_ConvertColors(ImU32* dst, const ImU32* src, int count)
+{
+#ifdef IMGUI_USE_BGRA_PACKED_COLOR
+    memcpy(dst, src, (size_t)count * sizeof(ImU32));
+#else
+    int i = 0;
+#if defined(IMGUI_IMPL_DX9_ENABLE_SSE2) && defined(__AVX2__)
+    // Swap bytes 0 and 2 of each color
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_si256((__m256i*)(void*)(dst + i), _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(const void*)(src + i)), shuffle));
+#endif
+#ifdef IMGUI_IMPL_DX9_ENABLE_SSE2
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128((__m128i*)(void*)(dst + i), ImGui_ImplDX9_ColToARGB_SSE2(_mm_loadu_si128((const __m128i*)(const void*)(src + i))));
+#endif
+    for (; i < count; i++)
+        dst[i] = IMGUI_COL_TO_DX9_ARGB(src[i]);
+#endif
+}
+
+// Convert 'count' vertices to the DX9 layout: z = 0 and colors in DX9 order. 'dst' and 'src' may not overlap.
+// The SIMD path repacks 4 vertices (80 bytes) into 6 full 16-byte stores, which is what write-combined memory from a locked vertex buffer wants.
+// It assumes the default ImDrawVert layout and is skipped with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT.
+static inline void ImGui_ImplDX9_ConvertVertices(ImGui_ImplDX9_Vertex* dst, const ImDrawVert* src, int count)
+{
+    int i = 0;
+#if defined(IMGUI_IMPL_DX9_ENABLE_SSE2) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+    static_assert(sizeof(ImDrawVert) == 20 && sizeof(ImGui_ImplDX9_Vertex) == 24, "");
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+    {
+        // Input floats 5*k+0..4 hold pos.x, pos.y, uv.x, uv.y, col of vertex k. Only shuffles, so colors pass through untouched.
+        const float* s = (const float*)(const void*)(src + i);
+        __m128 a = _mm_loadu_ps(s + 0);     // p0 p0 u0 u0
+        __m128 b = _mm_loadu_ps(s + 4);     // c0 p1 p1 u1
+        __m128 c = _mm_loadu_ps(s + 8);     // u1 c1 p2 p2
+        __m128 d = _mm_loadu_ps(s + 12);    // u2 u2 c2 p3
+        __m128 e = _mm_loadu_ps(s + 16);    // p3 u3 u3 c3
+        __m128 cols = _mm_shuffle_ps(_mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 0, 0)), _mm_shuffle_ps(d, e, _MM_SHUFFLE(3, 3, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        cols = _mm_castsi128_ps(ImGui_ImplDX9_ColToARGB_SSE2(_mm_castps_si128(cols)));
+        __m128 zc01 = _mm_unpacklo_ps(zero, cols);  // 0 c0 0 c1
+        __m128 zc23 = _mm_unpackhi_ps(zero, cols);  // 0 c2 0 c3
+        float* o = (float*)(void*)(dst + i);
+        _mm_storeu_ps(o + 0, _mm_shuffle_ps(a, zc01, _MM_SHUFFLE(1, 0, 1, 0)));                                     // p0 p0 0 c0
+        _mm_storeu_ps(o + 4, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 1, 3, 2)));                                        // u0 u0 p1 p1
+        _mm_storeu_ps(o + 8, _mm_shuffle_ps(zc01, _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 3, 2)));  // 0 c1 u1 u1
+        _mm_storeu_ps(o + 12, _mm_shuffle_ps(c, zc23, _MM_SHUFFLE(1, 0, 3, 2)));                                    // p2 p2 0 c2
+        _mm_storeu_ps(o + 16, _mm_shuffle_ps(d, _mm_shuffle_ps(d, e, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 1, 0)));   // u2 u2 p3 p3
+        _mm_storeu_ps(o + 20, _mm_shuffle_ps(zc23, e, _MM_SHUFFLE(2, 1, 3, 2)));                                    // 0 c3 u3 u3
+    }
+#endif
+    for (; i < count; i++)
+    {
+        ImGui_ImplDX9_Vertex* d = &dst[i];
+        const ImDrawVert* s = &src[i];
+        d->pos[0] = s->pos.x;
+        d->pos[1] = s->pos.y;
+        d->pos[2] = 0.0f;
+        d->col = IMGUI_COL_TO_DX9_ARGB(s->col);
+        d->uv[0] = s->uv.x;
+        d->uv[1] = s->uv.y;
+    }
+}
+
+#endif // #ifndef IMGUI_DISABLE
@@ -141,6 +141,7 @@ struct ImGuiTextIndex;              // Maintain a line index for a text buffer.
 // ImDrawList/ImFontAtlas
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
+struct ImFontAtlasAsyncBaker;       // Worker thread for ImFontAtlasFlags_AsyncGlyphBaking
 struct ImFontAtlasBuilder;          // Internal storage for incrementally packing and building a ImFontAtlas
 struct ImFontAtlasPostProcessData;  // Data available to potential texture post-processing functions
 struct ImFontAtlasRectEntry;        // Packed rectangle lookup entry
@@ -367,6 +368,7 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
+IMGUI_API ImU32         ImHashMurmur64A(const void* data, size_t data_size, ImU32 seed = 0);  // 8 bytes per step: faster than ImHashData() on large buffers
 IMGUI_API const char*   ImHashSkipUncontributingPrefix(const char* label);
 
 // Helpers: Sorting
@@ -429,6 +431,7 @@ IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, cons
 IMGUI_API const char*   ImTextFindPreviousUtf8Codepoint(const char* in_text_start, const char* in_p);                           // return previous UTF-8 code-point.
 IMGUI_API const char*   ImTextFindValidUtf8CodepointEnd(const char* in_text_start, const char* in_text_end, const char* in_p);  // return previous UTF-8 code-point if 'in_p' is not the end of a valid one.
 IMGUI_API int           ImTextCountLines(const char* in_text, const char* in_text_end);                                         // return number of lines taken by text. trailing carriage return doesn't count as an extra line.
+IMGUI_API const char*   ImTextFindNonPrintableAscii(const char* in_text, const char* in_text_end);                              // return first byte that is not printable ASCII (control character or part of a multi-byte UTF-8 sequence), or in_text_end.
 
 // Helpers: High-level text functions (DO NOT USE!!! THIS IS A MINIMAL SUBSET OF LARGER UPCOMING CHANGES)
 enum ImDrawTextFlags_
@@ -463,6 +466,8 @@ IMGUI_API ImU64             ImFileWrite(const void* data, ImU64 size, ImU64 coun
 #define IMGUI_DISABLE_TTY_FUNCTIONS // Can't use stdout, fflush if we are not using default file functions
 #endif
 IMGUI_API void*             ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_file_size = NULL, int padding_bytes = 0);
+IMGUI_API const void*       ImFileMapReadOnly(const char* filename, size_t* out_file_size);  // Memory-mapped where supported, otherwise loaded. Release with ImFileUnmap().
+IMGUI_API void              ImFileUnmap(const void* data, size_t file_size);
 
 // Helpers: Maths
 IM_MSVC_RUNTIME_CHECKS_OFF
@@ -816,6 +821,7 @@ struct ImGuiTextIndex
 
 // Helper: ImGuiStorage
 IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStoragePair* in_end, ImGuiID key);
+IMGUI_API ImGuiStoragePair* ImStorageFind(ImGuiStorage* storage, ImGuiID key); // NULL if missing. Sorted lookup, or hashed with IMGUI_STORAGE_OPEN_ADDRESSING
 
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawList support
@@ -892,6 +898,40 @@ struct ImFontStackData
     float       FontSizeAfterScaling;       // ~~ g.FontSize
 };
 
+// One remembered CalcTextSize() result
+struct ImGuiTextSizeCacheEntry
+{
+    ImGuiID     Key;                        // Hash of (Font, FontSize, WrapWidth, text)
+    ImFont*     Font;
+    float       FontSize;
+    float       WrapWidth;
+    int         TextOffset;                 // Copy of the text in ImGuiTextSizeCache::TextBuf, compared on lookup so a hash collision can't return a wrong size
+    int         TextLen;
+    int         LastUsedFrame;
+    ImVec2      Size;                       // As returned by CalcTextSize() (already rounded)
+};
+
+// Cache of CalcTextSize() results across frames, so unchanged labels are measured once instead of every frame.
+// - Looking up a label costs a hash (8 bytes per step) and a memcmp(), a fraction of walking its glyphs.
+// - Entries unused for a while are dropped by a periodic compaction pass, which also rebuilds TextBuf and Slots.
+// - Everything is dropped when glyph metrics of the atlas may have changed (ImFontAtlas::MetricsVersion).
+struct ImGuiTextSizeCache
+{
+    bool                                Enabled;
+    ImVector<ImGuiTextSizeCacheEntry>   Entries;
+    ImVector<int>                       Slots;          // Open-addressing index by Key: index into Entries + 1, 0 = empty. Kept at <= 50% load.
+    ImVector<char>                      TextBuf;
+    ImFontAtlas*                        Atlas;          // Atlas and metrics version the sizes were measured with
+    int                                 AtlasMetricsVersion;
+    int                                 LastCompactFrame;
+    int                                 HitsThisFrame, MissesThisFrame;
+    int                                 HitsLastFrame, MissesLastFrame;
+    ImU64                               HitsTotal, MissesTotal;
+
+    ImGuiTextSizeCache()                { Enabled = true; Atlas = NULL; AtlasMetricsVersion = LastCompactFrame = 0; HitsThisFrame = MissesThisFrame = HitsLastFrame = MissesLastFrame = 0; HitsTotal = MissesTotal = 0; }
+    void    Clear()                     { Entries.clear(); Slots.clear(); TextBuf.clear(); }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Style support
 //-----------------------------------------------------------------------------
@@ -1280,6 +1320,7 @@ enum ImGuiWindowRefreshFlags_
     ImGuiWindowRefreshFlags_TryToAvoidRefresh   = 1 << 0,   // [EXPERIMENTAL] Try to keep existing contents, USER MUST NOT HONOR BEGIN() RETURNING FALSE AND NOT APPEND.
     ImGuiWindowRefreshFlags_RefreshOnHover      = 1 << 1,   // [EXPERIMENTAL] Always refresh on hover
     ImGuiWindowRefreshFlags_RefreshOnFocus      = 1 << 2,   // [EXPERIMENTAL] Always refresh on focus
+    ImGuiWindowRefreshFlags_RefreshOnChange     = 1 << 3,   // [EXPERIMENTAL] Refresh when the window, style, fonts, focus or the content hash passed to SetNextWindowRefreshPolicy() changed, and while interacted with
     // Refresh policy/frequency, Load Balancing etc.
 };
 
@@ -1328,6 +1369,7 @@ struct ImGuiNextWindowData
     float                       BgAlphaVal;             // Override background alpha
     ImVec2                      MenuBarOffsetMinVal;    // (Always on) This is not exposed publicly, so we don't clear it and it doesn't have a corresponding flag (could we? for consistency?)
     ImGuiWindowRefreshFlags     RefreshFlagsVal;
+    ImGuiID                     RefreshContentHashVal;  // Hash of the user state the window contents depend on, for ImGuiWindowRefreshFlags_RefreshOnChange
 
     ImGuiNextWindowData()       { memset(this, 0, sizeof(*this)); }
     inline void ClearFlags()    { HasFlags = ImGuiNextWindowDataFlags_None; }
@@ -2197,6 +2239,7 @@ struct ImGuiContext
     float                   FontRasterizerDensity;              // Current font density. Used by all calls to GetFontBaked().
     float                   CurrentDpiScale;                    // Current window/viewport DpiScale == CurrentViewport->DpiScale
     ImDrawListSharedData    DrawListSharedData;
+    ImGuiTextSizeCache      TextSizeCache;                      // CalcTextSize() results of recent frames
     ImGuiID                 WithinEndChildID;                   // Set within EndChild()
     void*                   TestEngine;                         // Test engine user data
 
@@ -2700,6 +2743,9 @@ struct IMGUI_API ImGuiWindow
     ImVec2ih                HitTestHoleSize;                    // Define an optional rectangular hole where mouse will pass-through the window.
     ImVec2ih                HitTestHoleOffset;
 
+    ImGuiID                 SkipRefreshHash;                    // [EXPERIMENTAL] Hash of the window inputs on the last refreshed frame (ImGuiWindowRefreshFlags_RefreshOnChange)
+    int                     SkipRefreshHits;                    // [EXPERIMENTAL] Frames that reused the previous contents while a refresh policy was set
+    int                     SkipRefreshMisses;                  // [EXPERIMENTAL] Frames that were redrawn while a refresh policy was set
     int                     LastFrameActive;                    // Last frame number the window was Active.
     float                   LastTimeActive;                     // Last timestamp the window was Active (using float as we don't need high precision there)
     float                   ItemWidthDefault;
@@ -3170,7 +3216,7 @@ namespace ImGui
     IMGUI_API ImGuiWindow*  FindBottomMostVisibleWindowWithinBeginStack(ImGuiWindow* window);
 
     // Windows: Idle, Refresh Policies [EXPERIMENTAL]
-    IMGUI_API void          SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags);
+    IMGUI_API void          SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags, ImGuiID content_hash = 0);
 
     // Fonts, drawing
     IMGUI_API void          RegisterUserTexture(ImTextureData* tex); // Register external texture. EXPERIMENTAL: DO NOT USE YET.
@@ -3185,6 +3231,9 @@ namespace ImGui
     IMGUI_API ImFont*       GetDefaultFont();
     IMGUI_API void          PushPasswordFont();
     IMGUI_API void          PopPasswordFont();
+    IMGUI_API ImGuiID       TextSizeCacheKey(ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end);
+    IMGUI_API const ImVec2* TextSizeCacheFind(ImGuiID key, ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end);
+    IMGUI_API void          TextSizeCacheAdd(ImGuiID key, ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end, const ImVec2& size);
     inline ImDrawList*      GetForegroundDrawList(ImGuiWindow* window) { IM_UNUSED(window); return GetForegroundDrawList(); } // This seemingly unnecessary wrapper simplifies compatibility between the 'master' and 'docking' branches.
     IMGUI_API ImDrawList*   GetBackgroundDrawList(ImGuiViewport* viewport);                     // get background draw list for the given viewport. this draw list will be the first rendering one. Useful to quickly draw shapes/text behind dear imgui contents.
     IMGUI_API ImDrawList*   GetForegroundDrawList(ImGuiViewport* viewport);                     // get foreground draw list for the given viewport. this draw list will be the last rendered one. Useful to quickly draw shapes/text over dear imgui contents.
@@ -3857,6 +3906,9 @@ struct ImFontAtlasBuilder
     ImFontAtlasRectId           PackIdMouseCursors;     // White pixel + mouse cursors. Also happen to be fallback in case of packing failure.
     ImFontAtlasRectId           PackIdLinesTexData;
 
+    // Glyphs rasterized on a worker thread (ImFontAtlasFlags_AsyncGlyphBaking). Created on first use.
+    ImFontAtlasAsyncBaker*      AsyncBaker;
+
     ImFontAtlasBuilder()        { memset(this, 0, sizeof(*this)); FrameCount = -1; RectsIndexFreeListStart = -1; PackIdMouseCursors = PackIdLinesTexData = -1; }
 };
 
@@ -3897,6 +3949,12 @@ IMGUI_API ImFontGlyph*      ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImF
 IMGUI_API void              ImFontAtlasBakedAddFontGlyphAdvancedX(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, ImWchar codepoint, float advance_x);
 IMGUI_API void              ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked, ImFontGlyph* glyph);
 IMGUI_API void              ImFontAtlasBakedSetFontGlyphBitmap(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, ImFontGlyph* glyph, ImTextureRect* r, const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch);
+IMGUI_API void              ImFontAtlasBakedLoadGlyphs(ImFontAtlas* atlas, ImFontBaked* baked, const ImWchar* codepoints, int codepoints_count); // Same result as calling FindGlyph() on each in order, but rasterizes in bulk (on worker threads with IMGUI_ENABLE_THREADED_GLYPH_RASTERIZER)
+IMGUI_API bool              ImFontAtlasBakedSaveToFile(ImFontAtlas* atlas, ImFontBaked* baked, const char* filename);
+IMGUI_API void              ImFontAtlasAsyncGlyphsUpdate(ImFontAtlas* atlas);         // Copy glyphs finished by the ImFontAtlasFlags_AsyncGlyphBaking worker into the texture. Called by NewFrame().
+IMGUI_API void              ImFontAtlasAsyncGlyphsFlush(ImFontAtlas* atlas);          // Same, waiting for every queued glyph first
+IMGUI_API int               ImFontAtlasAsyncGlyphsGetPendingCount(ImFontAtlas* atlas); // Glyphs queued and still drawn blank
+IMGUI_API bool              ImFontAtlasBakedLoadFromFile(ImFontAtlas* atlas, ImFontBaked* baked, const char* filename); // Register glyphs saved by ImFontAtlasBakedSaveToFile(). Return false if the file doesn't match the font/configuration.
 
 IMGUI_API void              ImFontAtlasPackInit(ImFontAtlas* atlas);
 IMGUI_API ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFontAtlasRectEntry* overwrite_entry = NULL);
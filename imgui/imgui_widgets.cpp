@@ -8403,6 +8403,9 @@ void ImGuiSelectionBasicStorage::Clear()
     Size = 0;
     _SelectionOrder = 1; // Always >0
     _Storage.Data.resize(0);
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    _Storage.BuildIndex();
+#endif
 }
 
 void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
@@ -8410,6 +8413,10 @@ void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
     ImSwap(Size, r.Size);
     ImSwap(_SelectionOrder, r._SelectionOrder);
     _Storage.Data.swap(r._Storage.Data);
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    _Storage._Ctrl.swap(r._Storage._Ctrl);
+    _Storage._Slots.swap(r._Storage._Slots);
+#endif
 }
 
 bool ImGuiSelectionBasicStorage::Contains(ImGuiID id) const
@@ -8431,7 +8438,12 @@ bool ImGuiSelectionBasicStorage::GetNextSelectedItem(void** opaque_it, ImGuiID*
     ImGuiStoragePair* it = (ImGuiStoragePair*)*opaque_it;
     ImGuiStoragePair* it_end = _Storage.Data.Data + _Storage.Data.Size;
     if (PreserveOrder && it == NULL && it_end != NULL)
+    {
         ImQsort(_Storage.Data.Data, (size_t)_Storage.Data.Size, sizeof(ImGuiStoragePair), PairComparerByValueInt); // ~ImGuiStorage::BuildSortByValueInt()
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+        _Storage.BuildIndex(); // Lookups don't need pairs sorted by key: keep selection order and skip the second sort below.
+#endif
+    }
     if (it == NULL)
         it = _Storage.Data.Data;
     IM_ASSERT(it >= _Storage.Data.Data && it <= it_end);
@@ -8441,8 +8453,10 @@ bool ImGuiSelectionBasicStorage::GetNextSelectedItem(void** opaque_it, ImGuiID*
     const bool has_more = (it != it_end);
     *opaque_it = has_more ? (void**)(it + 1) : (void**)(it);
     *out_id = has_more ? it->key : 0;
+#ifndef IMGUI_STORAGE_OPEN_ADDRESSING
     if (PreserveOrder && !has_more)
         _Storage.BuildSortByKey();
+#endif
     return has_more;
 }
 
@@ -8457,12 +8471,22 @@ void ImGuiSelectionBasicStorage::SetItemSelected(ImGuiID id, bool selected)
 static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicStorage* selection, ImGuiID id, bool selected, int size_before_amends, int selection_order)
 {
     ImGuiStorage* storage = &selection->_Storage;
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    IM_UNUSED(size_before_amends);
+    ImGuiStoragePair* it = ImStorageFind(storage, id);
+    const bool is_contained = (it != NULL);
+#else
     ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + size_before_amends, id);
     const bool is_contained = (it != storage->Data.Data + size_before_amends) && (it->key == id);
+#endif
     if (selected == (is_contained && it->val_i != 0))
         return;
     if (selected && !is_contained)
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+        storage->SetInt(id, selection_order); // Hashed insertion is O(1): nothing to sort afterwards
+#else
         storage->Data.push_back(ImGuiStoragePair(id, selection_order)); // Push unsorted at end of vector, will be sorted in SelectionMultiAmendsFinish()
+#endif
     else if (is_contained)
         it->val_i = selected ? selection_order : 0; // Modify in-place.
     selection->Size += selected ? +1 : -1;
@@ -8471,8 +8495,12 @@ static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicS
 static void ImGuiSelectionBasicStorage_BatchFinish(ImGuiSelectionBasicStorage* selection, bool selected, int size_before_amends)
 {
     ImGuiStorage* storage = &selection->_Storage;
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    IM_UNUSED(storage); IM_UNUSED(selected); IM_UNUSED(size_before_amends);
+#else
     if (selected && selection->Size != size_before_amends)
         storage->BuildSortByKey(); // When done selecting: sort everything
+#endif
 }
 
 // Apply requests coming from BeginMultiSelect() and EndMultiSelect().
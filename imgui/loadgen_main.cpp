@@ -0,0 +1,435 @@
+// Load generator for desainin-server. Replays a weighted mix of register,
+// login, add, find, assign and list requests and reports throughput plus
+// p50/p99/p99.9 latency per operation.
+//
+//   g++ -std=c++17 -O2 -pthread loadgen_main.cpp modular/OrderClient.cpp modular/LatencyHistogram.cpp
+//       modular/PasswordHash.cpp modular/PasswordVerifier.cpp -o desainin-loadgen
+//   (add -lws2_32 on Windows)
+//
+//   desainin-loadgen [--port 7070] [--connections 4] [--seconds 10]
+//                    [--mode closed|open] [--depth 1] [--rate 10000]
+//                    [--mix register=2,login=8,add=20,find=40,assign=10,list=20]
+//                    [--subscribers 0]
+//   desainin-loadgen --mode hash [--costs 1000,10000,100000] [--threads 0] [--seconds 10]
+//
+// Closed loop: every connection keeps --depth requests in flight and sends
+// the next batch as soon as the last one is answered, so it measures peak
+// throughput. Open loop: requests are sent on a fixed schedule of --rate per
+// second in total, and latency is measured from the scheduled send time, so
+// a stalled server shows up as queueing delay instead of a slower client.
+// --subscribers opens extra SUBSCRIBE,ALL connections and reports how many
+// pushed deltas reached them.
+// Hash mode needs no server: it times password checks on a PasswordVerifier
+// pool at each PBKDF2 cost in turn, --seconds per cost, to pick a cost that
+// keeps login throughput and latency acceptable on this machine.
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modular/OrderClient.hpp"
+#include "modular/LatencyHistogram.hpp"
+#include "modular/PasswordHash.hpp"
+#include "modular/PasswordVerifier.hpp"
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+enum class Op { Register, Login, Add, Find, Assign, List };
+static const int OpCount = 6;
+static const char* OpNames[OpCount] = { "register", "login", "add", "find", "assign", "list" };
+
+struct Options {
+    uint16_t port = 7070;
+    int connections = 4;
+    double seconds = 10;
+    bool openLoop = false;
+    bool hashBench = false;
+    vector<uint32_t> costs = { 1000, 10000, 50000, 100000, 200000 };
+    int threads = 0;
+    int depth = 1;
+    double rate = 10000;
+    int subscribers = 0;
+    double mix[OpCount] = { 2, 8, 20, 40, 10, 20 };
+};
+
+struct Results {
+    LatencyHistogram latency[OpCount];
+    long errors[OpCount] = {};
+
+    void merge(const Results& other) {
+        for (int i = 0; i < OpCount; ++i) {
+            latency[i].merge(other.latency[i]);
+            errors[i] += other.errors[i];
+        }
+    }
+};
+
+// Request generator and bookkeeping for one connection. It registers its
+// own customer up front and only touches the orders it created, so workers
+// never contend on the same records. Logins repeat that customer's, since a
+// login rebinds the connection's session and the orders belong to it.
+class Workload {
+public:
+    Workload(const Options& options, int worker, const string& runTag)
+        : rng(random_device{}() + worker),
+          pick(begin(options.mix), end(options.mix)),
+          prefix("lg" + runTag + "-" + to_string(worker) + "-"),
+          editor("editor-" + to_string(worker)) {}
+
+    bool setUp(OrderClient& client) {
+        vector<string> response;
+        username = prefix + "0";
+        if (!client.call("REGISTER," + username + ",pw,Customer", response)) return false;
+        if (response[0] == "ERR,READONLY") return setUpReadOnly(client);
+        if (response[0].compare(0, 3, "OK,") != 0) return false;
+        customerID = atoi(response[0].c_str() + 3);
+        // Order writes need a session on the connection
+        if (!client.call("LOGIN," + username + ",pw", response)) return false;
+        return customerID > 0 && response[0].compare(0, 3, "OK,") == 0;
+    }
+
+    // Against a read replica: find and list existing orders instead
+    bool setUpReadOnly(OrderClient& client) {
+        vector<string> response;
+        if (!client.call("LIST", response) || response.size() < 2) return false;
+        for (size_t i = 1; i < response.size(); ++i) {
+            size_t start = response[i].find(',') + 1;
+            orderIDs.push_back(atoi(response[i].c_str() + start));
+        }
+        size_t customerColumn = response[1].rfind(',', response[1].rfind(',') - 1) + 1;
+        customerID = atoi(response[1].c_str() + customerColumn);
+        return true;
+    }
+
+    Op next(string& request) {
+        lock_guard<mutex> lock(stateMutex);
+        Op op = (Op)pick(rng);
+        if ((op == Op::Find || op == Op::Assign) && orderIDs.empty()) op = Op::Add;
+        if (op == Op::Login && username.empty()) op = Op::List;
+
+        switch (op) {
+            case Op::Register:
+                request = "REGISTER," + prefix + to_string(++registered) + ",pw,Customer";
+                break;
+            case Op::Login:
+                request = "LOGIN," + username + ",pw";
+                break;
+            case Op::Add:
+                request = "ADD," + to_string(customerID) + ",load order " + to_string(++added) +
+                          ",Other,2030-01-01,ref,extras";
+                break;
+            case Op::Find:
+                request = "GET," + to_string(orderIDs[rng() % orderIDs.size()]);
+                break;
+            case Op::Assign:
+                request = "ASSIGN," + to_string(orderIDs[rng() % orderIDs.size()]) + "," + editor;
+                break;
+            case Op::List:
+                request = "LIST," + to_string(customerID);
+                break;
+        }
+        return op;
+    }
+
+    // Returns false on an ERR response
+    bool complete(Op op, const vector<string>& response) {
+        if (response.empty() || response[0].compare(0, 3, "ERR") == 0) return false;
+        lock_guard<mutex> lock(stateMutex);
+        if (op == Op::Add) orderIDs.push_back(atoi(response[0].c_str() + 3));
+        return true;
+    }
+
+private:
+    mutex stateMutex;
+    mt19937 rng;
+    discrete_distribution<int> pick;
+    string prefix;
+    string editor;
+    int customerID = 0;
+    int registered = 0;
+    int added = 0;
+    string username;
+    vector<int> orderIDs;
+};
+
+static uint64_t nanosSince(Clock::time_point start, Clock::time_point end) {
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+}
+
+static bool runClosedLoop(const Options& options, OrderClient& client, Workload& workload,
+                          Clock::time_point stopAt, Results& results) {
+    vector<Op> ops(options.depth);
+    vector<string> requests(options.depth);
+    vector<string> response;
+    while (Clock::now() < stopAt) {
+        Clock::time_point sent = Clock::now();
+        for (int i = 0; i < options.depth; ++i) {
+            ops[i] = workload.next(requests[i]);
+            if (!client.send(requests[i])) return false;
+        }
+        for (int i = 0; i < options.depth; ++i) {
+            if (!client.receive(response)) return false;
+            results.latency[(int)ops[i]].record(nanosSince(sent, Clock::now()));
+            if (!workload.complete(ops[i], response)) results.errors[(int)ops[i]]++;
+        }
+    }
+    return true;
+}
+
+struct InFlight {
+    Op op;
+    string request;
+    Clock::time_point scheduled;
+};
+
+static bool runOpenLoop(const Options& options, OrderClient& client, Workload& workload,
+                        Clock::time_point stopAt, Results& results) {
+    mutex queueMutex;
+    condition_variable queued;
+    deque<InFlight> inFlight;
+    bool senderDone = false;
+    atomic<bool> failed{ false };
+
+    thread receiver([&]() {
+        vector<string> response;
+        for (;;) {
+            InFlight next;
+            {
+                unique_lock<mutex> lock(queueMutex);
+                queued.wait(lock, [&]() { return !inFlight.empty() || senderDone; });
+                if (inFlight.empty()) return;
+                next = inFlight.front();
+                inFlight.pop_front();
+            }
+            if (!client.receive(response)) {
+                failed = true;
+                return;
+            }
+            results.latency[(int)next.op].record(nanosSince(next.scheduled, Clock::now()));
+            if (!workload.complete(next.op, response)) results.errors[(int)next.op]++;
+        }
+    });
+
+    auto interval = chrono::duration_cast<Clock::duration>(
+        chrono::duration<double>(options.connections / options.rate));
+    Clock::time_point scheduled = Clock::now();
+    while (scheduled < stopAt && !failed) {
+        this_thread::sleep_until(scheduled);
+        InFlight item;
+        item.op = workload.next(item.request);
+        item.scheduled = scheduled;
+        {
+            lock_guard<mutex> lock(queueMutex);
+            inFlight.push_back(item);
+        }
+        queued.notify_one();
+        if (!client.send(item.request)) {
+            failed = true;
+            break;
+        }
+        scheduled += interval;
+    }
+    {
+        lock_guard<mutex> lock(queueMutex);
+        senderDone = true;
+    }
+    queued.notify_one();
+    receiver.join();
+    return !failed;
+}
+
+static bool parseMix(const string& text, double mix[OpCount]) {
+    for (int i = 0; i < OpCount; ++i) mix[i] = 0;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        size_t eq = item.find('=');
+        if (eq == string::npos) return false;
+        string name = item.substr(0, eq);
+        int op = 0;
+        while (op < OpCount && name != OpNames[op]) op++;
+        if (op == OpCount) return false;
+        mix[op] = atof(item.c_str() + eq + 1);
+    }
+    double sum = 0;
+    for (int i = 0; i < OpCount; ++i) sum += mix[i];
+    return sum > 0;
+}
+
+static bool parseCosts(const string& text, vector<uint32_t>& costs) {
+    costs.clear();
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        long cost = atol(item.c_str());
+        if (cost <= 0) return false;
+        costs.push_back((uint32_t)cost);
+    }
+    return !costs.empty();
+}
+
+// Keeps two verifications per worker queued, so the pool never idles, and
+// records each one from submission to answer as a login would see it
+static void runHashBenchmark(const Options& options) {
+    PasswordVerifier pool((unsigned)options.threads);
+    size_t inFlight = pool.threadCount() * 2;
+    cout << "password verification, " << pool.threadCount() << " threads, "
+         << options.seconds << " s per cost" << endl;
+
+    for (uint32_t cost : options.costs) {
+        string stored = PasswordHash::hash("loadgen-password", cost);
+        LatencyHistogram latency;
+        long failed = 0;
+        deque<pair<Clock::time_point, future<bool>>> pending;
+
+        Clock::time_point start = Clock::now();
+        Clock::time_point stopAt = start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(options.seconds));
+        while (Clock::now() < stopAt || !pending.empty()) {
+            while (pending.size() < inFlight && Clock::now() < stopAt) {
+                pending.emplace_back(Clock::now(), pool.verify("loadgen-password", stored));
+            }
+            if (pending.empty()) break;
+            bool ok = pending.front().second.get();
+            latency.record(nanosSince(pending.front().first, Clock::now()));
+            if (!ok) failed++;
+            pending.pop_front();
+        }
+        double elapsed = chrono::duration<double>(Clock::now() - start).count();
+        string label = to_string(cost);
+        cout << "  cost " << label << string(label.size() < 9 ? 9 - label.size() : 1, ' ')
+             << (long)(latency.count() / elapsed) << " logins/s  " << latency.summary();
+        if (failed) cout << " FAILED=" << failed;
+        cout << endl;
+    }
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        string value = argv[i + 1];
+        if (flag == "--port") options.port = (uint16_t)atoi(value.c_str());
+        else if (flag == "--connections") options.connections = atoi(value.c_str());
+        else if (flag == "--seconds") options.seconds = atof(value.c_str());
+        else if (flag == "--mode") {
+            options.openLoop = (value == "open");
+            options.hashBench = (value == "hash");
+        }
+        else if (flag == "--threads") options.threads = atoi(value.c_str());
+        else if (flag == "--costs") {
+            if (!parseCosts(value, options.costs)) return false;
+        }
+        else if (flag == "--depth") options.depth = atoi(value.c_str());
+        else if (flag == "--rate") options.rate = atof(value.c_str());
+        else if (flag == "--subscribers") options.subscribers = atoi(value.c_str());
+        else if (flag == "--mix") {
+            if (!parseMix(value, options.mix)) return false;
+        }
+        else return false;
+    }
+    return argc % 2 == 1 && options.connections > 0 && options.depth > 0 &&
+           options.rate > 0 && options.seconds > 0 && options.subscribers >= 0 && options.threads >= 0;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        cerr << "Usage: desainin-loadgen [--port p] [--connections n] [--seconds s] [--mode closed|open]\n"
+                "                        [--depth d] [--rate r] [--mix register=w,login=w,add=w,find=w,assign=w,list=w]\n"
+                "       desainin-loadgen --mode hash [--costs c1,c2,...] [--threads n] [--seconds s]" << endl;
+        return 1;
+    }
+    if (options.hashBench) {
+        runHashBenchmark(options);
+        return 0;
+    }
+
+    string runTag = to_string(chrono::system_clock::now().time_since_epoch().count() % 1000000000);
+    vector<Results> results(options.connections);
+    atomic<int> failures{ 0 };
+    vector<thread> workers;
+
+    atomic<long> deltaBatches{ 0 };
+    atomic<long> deltaRows{ 0 };
+    atomic<bool> finished{ false };
+    vector<thread> watchers;
+    for (int w = 0; w < options.subscribers; ++w) {
+        watchers.emplace_back([&]() {
+            OrderClient client;
+            vector<string> lines;
+            if (!client.connect("127.0.0.1", options.port) || !client.subscribe("SUBSCRIBE,ALL", lines)) {
+                failures++;
+                return;
+            }
+            while (!finished) {
+                if (client.readDelta(lines, 100)) {
+                    deltaBatches++;
+                    deltaRows += (long)lines.size();
+                } else if (!client.isConnected()) {
+                    failures++;
+                    return;
+                }
+            }
+        });
+    }
+
+    Clock::time_point start = Clock::now();
+    Clock::time_point stopAt = start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(options.seconds));
+    for (int w = 0; w < options.connections; ++w) {
+        workers.emplace_back([&, w]() {
+            OrderClient client;
+            Workload workload(options, w, runTag);
+            if (!client.connect("127.0.0.1", options.port) || !workload.setUp(client)) {
+                failures++;
+                return;
+            }
+            bool ok = options.openLoop
+                ? runOpenLoop(options, client, workload, stopAt, results[w])
+                : runClosedLoop(options, client, workload, stopAt, results[w]);
+            if (!ok) failures++;
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    double elapsed = chrono::duration<double>(Clock::now() - start).count();
+    // Give the last deltas a moment to arrive before the watchers hang up
+    this_thread::sleep_for(chrono::milliseconds(200));
+    finished = true;
+    for (auto& watcher : watchers) watcher.join();
+
+    Results total;
+    for (const auto& r : results) total.merge(r);
+    LatencyHistogram overall;
+    long errors = 0;
+    for (int i = 0; i < OpCount; ++i) {
+        overall.merge(total.latency[i]);
+        errors += total.errors[i];
+    }
+
+    cout << (options.openLoop ? "open loop, " : "closed loop, ") << options.connections << " connections, ";
+    if (options.openLoop) cout << "target " << options.rate << " req/s";
+    else cout << "depth " << options.depth;
+    cout << "\n" << overall.count() << " requests in " << elapsed << " s ("
+         << (long)(overall.count() / elapsed) << " req/s), " << errors << " errors";
+    if (failures) cout << ", " << failures << " connections failed";
+    cout << "\n";
+    for (int i = 0; i < OpCount; ++i) {
+        if (total.latency[i].count() == 0) continue;
+        cout << "  " << OpNames[i] << string(10 - string(OpNames[i]).size(), ' ')
+             << total.latency[i].summary() << " errors=" << total.errors[i] << "\n";
+    }
+    cout << "  all       " << overall.summary() << endl;
+    if (options.subscribers > 0) {
+        cout << options.subscribers << " subscribers received " << deltaRows << " order updates in "
+             << deltaBatches << " deltas" << endl;
+    }
+    return (failures || errors) ? 1 : 0;
+}
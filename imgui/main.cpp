@@ -1,9 +1,13 @@
 #include <d3d9.h>
 #include <tchar.h>
 #include <string>
+#include <vector>
+#include <map>
 #include <chrono>
+#include <future>
 
 #include "imgui.h"
+#include "imgui_internal.h"
 #include "imgui_impl_dx9.h"
 #include "imgui_impl_win32.h"
 
@@ -11,7 +15,10 @@
 #include "modular/customer.hpp"
 #include "modular/editor.hpp"
 #include "modular/UserManager.hpp"
+#include "modular/PasswordVerifier.hpp"
 #include "modular/SaveManager.hpp"
+#include "modular/EditorScheduler.hpp"
+#include "modular/OrderTransfer.hpp"
 
 // DirectX9 globals
 static LPDIRECT3D9              g_pD3D = nullptr;
@@ -43,6 +50,15 @@ struct AppState {
     int regRoleIndex = 0; // 0=Customer, 1=Editor
     char regErrorMsg[128] = "";
     char loginErrorMsg[128] = "";
+
+    // Password hashing is slow on purpose, so it runs off the render thread;
+    // the Login and Create Account buttons poll for the result each frame
+    PasswordVerifier passwordPool{ 1 };
+    std::future<bool> pendingLogin;         // password check for loginCandidate
+    user* loginCandidate = nullptr;
+    std::future<std::string> pendingRegister;   // hash for the new account
+    std::string registerName;
+    user::Role registerRole = user::Role::Customer;
     
     // Logged-in state
     int loggedUserID = 0;
@@ -56,13 +72,42 @@ struct AppState {
     char bufExtras[128] = "";
     char bufFinalLink[256] = "";
     char bufEditorAssign[64] = "";
-    int nextOrderID = 1001;
     int kindIndex = 0;
     int deadlineDays = 7;
     int statusIndex = 0; // For editor status changes
     
     // Detail prefill flag
     bool detailsPrefilled = false;
+    uint64_t editBaseVersion = 0; // Order::version the open form was filled from
+
+    // Orders that went overdue since the editor last dismissed the alert
+    std::vector<int> overdueAlerts;
+
+    // Editor search box
+    char bufSearch[128] = "";
+    std::vector<SearchIndex::Result> searchResults;
+    bool searchStale = false;       // orders changed since the results were computed
+    double lastSearchTime = 0.0;    // ImGui::GetTime() of the last search run
+
+    // Order list rows, patched from the change feed instead of rebuilt every frame
+    ChangeFeed::Cursor feedCursor;
+    std::vector<OrderEvent> feedEvents;
+    bool rowsValid = false;
+    int rowsForUserID = 0;
+    std::map<int, std::string> customerRows;    // orders of the logged-in customer
+    std::map<int, std::string> editorRows;      // every order, for the editor menu
+
+    // Auto-assignment; the message reports the last run
+    EditorScheduler scheduler;
+    std::string autoAssignMsg;
+
+    // Import / export panel; the format follows the file extension
+    char bufTransferPath[256] = "orders.csv";
+    std::string transferMsg;
+    std::vector<ImportError> transferErrors;
+
+    // Render stats overlay, toggled with F3
+    bool showRenderStats = false;
 };
 
 // Helper function to calculate days until deadline
@@ -73,6 +118,167 @@ int calculateDaysUntilDeadline(const std::chrono::system_clock::time_point& dead
     return static_cast<int>(diff.count() / 24);
 }
 
+const char* statusLabel(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::Pending: return "Pending";
+        case OrderStatus::InProgress: return "In Progress";
+        case OrderStatus::Completed: return "Completed";
+        case OrderStatus::Cancelled: return "Cancelled";
+    }
+    return "Pending";
+}
+
+void refreshOrderRow(AppState& app, const OrderSnapshot& view, int orderID) {
+    app.customerRows.erase(orderID);
+    app.editorRows.erase(orderID);
+    std::shared_ptr<const Order> order = view.find(orderID);
+    if (!order) return;
+
+    char label[256];
+    snprintf(label, sizeof(label), "[ID:%d] %s (Customer: %d) [%s]", 
+             order->orderID, order->orderName.c_str(), order->customerID, statusLabel(order->status));
+    app.editorRows[orderID] = label;
+    if (order->customerID == app.loggedUserID) {
+        snprintf(label, sizeof(label), "[ID:%d] %s - %s", 
+                 order->orderID, order->orderName.c_str(), statusLabel(order->status));
+        app.customerRows[orderID] = label;
+    }
+}
+
+void runSearch(AppState& app) {
+    app.searchResults = app.manager.searchOrders(app.bufSearch);
+    app.searchStale = false;
+    app.lastSearchTime = ImGui::GetTime();
+}
+
+// Applies new change-feed events to the cached list rows and returns the
+// snapshot this frame renders from. Rows are only rebuilt in full on login
+// or when the feed overran.
+std::shared_ptr<const OrderSnapshot> syncOrderRows(AppState& app) {
+    const ChangeFeed& feed = app.manager.changes();
+    bool rebuild = !app.rowsValid || app.rowsForUserID != app.loggedUserID;
+    if (rebuild) {
+        // Subscribe before taking the snapshot so no write can fall in between
+        app.feedCursor = feed.subscribe();
+    }
+
+    app.feedEvents.clear();
+    feed.poll(app.feedCursor, app.feedEvents);
+    if (app.feedCursor.overrun) {
+        app.feedCursor.overrun = false;
+        rebuild = true;
+    }
+
+    std::shared_ptr<const OrderSnapshot> view = app.manager.snapshot();
+    if (rebuild) {
+        app.customerRows.clear();
+        app.editorRows.clear();
+        for (const auto& order : view->orders) {
+            refreshOrderRow(app, *view, order->orderID);
+        }
+        app.rowsValid = true;
+        app.rowsForUserID = app.loggedUserID;
+    } else {
+        for (const auto& event : app.feedEvents) {
+            refreshOrderRow(app, *view, event.orderID);
+        }
+    }
+
+    // Search again after changes, but at most a few times per second while
+    // writes keep coming; rows of removed orders are skipped when drawn
+    if (rebuild || !app.feedEvents.empty()) app.searchStale = true;
+    if (app.searchStale && app.bufSearch[0] != '\0' && ImGui::GetTime() - app.lastSearchTime >= 0.25) {
+        runSearch(app);
+    }
+    return view;
+}
+
+// After our own successful write, move the open form's base version forward
+// so the next save isn't rejected as a conflict with ourselves
+void advanceEditBase(AppState& app, int orderID, uint64_t versionBefore) {
+    if (app.editBaseVersion != versionBefore) return;
+    if (auto latest = app.manager.findOrder(orderID)) {
+        app.editBaseVersion = latest->version;
+    }
+}
+
+std::vector<std::string> editorNames(const AppState& app) {
+    std::vector<std::string> names;
+    for (const auto& u : app.userManager.getAllUsers()) {
+        if (u.getRole() == user::Role::Editor) names.push_back(u.getUsername());
+    }
+    return names;
+}
+
+// Hands pending orders to editors and, when someone just freed up, lets them
+// take queued work from the busiest editor
+void runScheduler(AppState& app, bool assignPending) {
+    std::vector<std::string> editors = editorNames(app);
+    size_t assigned = 0;
+    if (assignPending) {
+        auto view = app.manager.snapshot();
+        assigned = EditorScheduler::apply(app.manager, app.scheduler.plan(*view, editors, std::chrono::system_clock::now()));
+    }
+    auto view = app.manager.snapshot();
+    size_t moved = EditorScheduler::apply(app.manager, app.scheduler.rebalance(*view, editors));
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "Assigned %d pending order(s), moved %d queued order(s)", (int)assigned, (int)moved);
+    app.autoAssignMsg = msg;
+}
+
+void drawUndoRedoButtons(AppState& app, const char* idSuffix) {
+    char label[64];
+    bool canUndo = app.manager.canUndo();
+    if (!canUndo) ImGui::BeginDisabled();
+    snprintf(label, sizeof(label), "Undo##%s", idSuffix);
+    if (ImGui::Button(label, ImVec2(100, 0)) && !app.manager.undo()) {
+        snprintf(label, sizeof(label), "undo_failed##%s", idSuffix);
+        ImGui::OpenPopup(label);
+    }
+    if (!canUndo) ImGui::EndDisabled();
+    
+    ImGui::SameLine();
+    
+    bool canRedo = app.manager.canRedo();
+    if (!canRedo) ImGui::BeginDisabled();
+    snprintf(label, sizeof(label), "Redo##%s", idSuffix);
+    if (ImGui::Button(label, ImVec2(100, 0)) && !app.manager.redo()) {
+        snprintf(label, sizeof(label), "undo_failed##%s", idSuffix);
+        ImGui::OpenPopup(label);
+    }
+    if (!canRedo) ImGui::EndDisabled();
+    
+    snprintf(label, sizeof(label), "undo_failed##%s", idSuffix);
+    if (ImGui::BeginPopupModal(label, nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+        ImGui::Text("The order was changed again since then, nothing was undone.");
+        if (ImGui::Button("OK##undo_failed", ImVec2(120, 0))) {
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+    }
+}
+
+// Everything the editor menu shows besides ImGui's own state. The window is
+// only redrawn when this changes (or while it is being used); otherwise last
+// frame's draw list is reused.
+ImGuiID editorMenuContentHash(const AppState& app, const OrderSnapshot& view) {
+    using namespace std::chrono;
+    ImGuiID hash = ImHashData(&view.version, sizeof(view.version), 0);
+    // Overdue counts and days left move with the clock
+    long long minute = duration_cast<minutes>(system_clock::now().time_since_epoch()).count();
+    hash = ImHashData(&minute, sizeof(minute), hash);
+    size_t sizes[] = { app.editorRows.size(), app.searchResults.size(), app.overdueAlerts.size(), app.transferErrors.size() };
+    hash = ImHashData(sizes, sizeof(sizes), hash);
+    hash = ImHashData(&app.selectedOrderID, sizeof(app.selectedOrderID), hash);
+    hash = ImHashData(app.loggedUsername.data(), app.loggedUsername.size(), hash);
+    hash = ImHashData(app.bufSearch, strlen(app.bufSearch), hash);
+    hash = ImHashData(app.bufTransferPath, strlen(app.bufTransferPath), hash);
+    hash = ImHashData(app.transferMsg.data(), app.transferMsg.size(), hash);
+    hash = ImHashData(app.autoAssignMsg.data(), app.autoAssignMsg.size(), hash);
+    return hash;
+}
+
 int main(int, char**)
 {
     // Create window
@@ -119,13 +325,19 @@ int main(int, char**)
     colors[ImGuiCol_HeaderActive] = ImVec4(0.35f, 0.45f, 0.60f, 1.00f);
     
     // Try to load Arial font
-    if (io.Fonts->AddFontFromFileTTF("C:\\Windows\\Fonts\\arial.ttf", 16.0f)) {
-        // Font loaded successfully
-    }
+    ImFont* uiFont = io.Fonts->AddFontFromFileTTF("C:\\Windows\\Fonts\\arial.ttf", 16.0f);
+    // Characters not seen before (a new customer name) are rasterized on a
+    // worker and show up a frame later instead of stalling the frame
+    io.Fonts->Flags |= ImFontAtlasFlags_AsyncGlyphBaking;
 
     ImGui_ImplWin32_Init(hwnd);
     ImGui_ImplDX9_Init(g_pd3dDevice);
 
+    // Glyphs rasterized by the last run. A missing or stale cache (other font file,
+    // size or settings) is ignored and glyphs load on demand as usual.
+    if (uiFont)
+        ImFontAtlasBakedLoadFromFile(io.Fonts, uiFont->GetFontBaked(16.0f), "fontcache.bin");
+
     AppState app;
     
     // Load saved data at startup
@@ -151,6 +363,14 @@ int main(int, char**)
         ImGuiViewport* viewport = ImGui::GetMainViewport();
         ImVec2 center = viewport->GetCenter();
 
+        // Collect orders that crossed their deadline since last frame
+        app.manager.pollOverdue(std::chrono::system_clock::now(), [&app](int orderID) {
+            app.overdueAlerts.push_back(orderID);
+        });
+
+        // Every window renders from the same consistent snapshot this frame
+        std::shared_ptr<const OrderSnapshot> view = syncOrderRows(app);
+
         // ========== LOGIN CHOICE WINDOW ==========
         if (app.currentScreen == AppState::LoginChoice) {
             ImGui::SetNextWindowPos(center, ImGuiCond_Always, ImVec2(0.5f, 0.5f));
@@ -202,6 +422,21 @@ int main(int, char**)
             }
             
             ImGui::Separator();
+
+            if (app.pendingRegister.valid() && app.pendingRegister.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                // The name may have been taken while the hash was computed
+                if (app.userManager.restoreUser(app.registerName, app.pendingRegister.get(), app.registerRole)) {
+                    strcpy(app.regErrorMsg, "");
+                    strcpy(app.bufUsername, "");
+                    strcpy(app.bufPassword, "");
+                    app.currentScreen = AppState::LoginChoice;
+                } else {
+                    strcpy(app.regErrorMsg, "Username already exists!");
+                }
+            }
+            bool registering = app.pendingRegister.valid();
+            if (registering) ImGui::Text("Creating account...");
+            ImGui::BeginDisabled(registering);
             
             if (ImGui::Button("Create Account##btn", ImVec2(150, 0))) {
                 if (strlen(app.bufUsername) == 0 || strlen(app.bufPassword) == 0) {
@@ -213,16 +448,9 @@ int main(int, char**)
                 } else if (app.userManager.usernameExists(app.bufUsername)) {
                     strcpy(app.regErrorMsg, "Username already exists!");
                 } else {
-                    user::Role role = (app.regRoleIndex == 0) ? user::Role::Customer : user::Role::Editor;
-                    bool success = app.userManager.registerUser(app.bufUsername, app.bufPassword, role);
-                    if (success) {
-                        strcpy(app.regErrorMsg, "");
-                        strcpy(app.bufUsername, "");
-                        strcpy(app.bufPassword, "");
-                        app.currentScreen = AppState::LoginChoice;
-                    } else {
-                        strcpy(app.regErrorMsg, "Registration failed!");
-                    }
+                    app.registerName = app.bufUsername;
+                    app.registerRole = (app.regRoleIndex == 0) ? user::Role::Customer : user::Role::Editor;
+                    app.pendingRegister = app.passwordPool.hash(app.bufPassword);
                 }
             }
             
@@ -232,6 +460,7 @@ int main(int, char**)
                 app.currentScreen = AppState::LoginChoice;
                 strcpy(app.regErrorMsg, "");
             }
+            ImGui::EndDisabled();
             
             ImGui::End();
         }
@@ -253,14 +482,17 @@ int main(int, char**)
             }
             
             ImGui::Separator();
-            
-            if (ImGui::Button("Login##btn", ImVec2(150, 0))) {
-                user* loggedInUser = app.userManager.loginUser(app.bufUsername, app.bufPassword);
+
+            if (app.pendingLogin.valid() && app.pendingLogin.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                user* loggedInUser = app.pendingLogin.get() ? app.loginCandidate : nullptr;
+                app.loginCandidate = nullptr;
                 if (loggedInUser) {
                     app.loggedUserID = loggedInUser->getUserID();
                     app.loggedUsername = loggedInUser->getUsername();
                     app.loggedRole = loggedInUser->getRole();
                     strcpy(app.loginErrorMsg, "");
+                    // Undo history never crosses from one user's session to the next
+                    app.manager.clearHistory();
                     
                     if (app.loggedRole == user::Role::Customer) {
                         app.currentScreen = AppState::CustomerMenu;
@@ -272,6 +504,18 @@ int main(int, char**)
                     strcpy(app.loginErrorMsg, "Invalid username or password!");
                 }
             }
+            bool checking = app.pendingLogin.valid();
+            if (checking) ImGui::Text("Checking password...");
+            ImGui::BeginDisabled(checking);
+
+            if (ImGui::Button("Login##btn", ImVec2(150, 0))) {
+                app.loginCandidate = app.userManager.getUserByUsername(app.bufUsername);
+                if (app.loginCandidate) {
+                    app.pendingLogin = app.passwordPool.verify(app.bufPassword, app.loginCandidate->getPassword());
+                } else {
+                    strcpy(app.loginErrorMsg, "Invalid username or password!");
+                }
+            }
             
             ImGui::SameLine();
             
@@ -279,6 +523,7 @@ int main(int, char**)
                 app.currentScreen = AppState::LoginChoice;
                 strcpy(app.loginErrorMsg, "");
             }
+            ImGui::EndDisabled();
             
             ImGui::End();
         }
@@ -302,30 +547,14 @@ int main(int, char**)
             ImGui::Text("Your Orders:");
             
             ImGui::BeginChild("orders_list", ImVec2(0, 300), true);
-            int orderCount = 0;
-            for (const auto& order : app.manager.getOrders()) {
-                if (order.customerID != app.loggedUserID) continue;
-                
-                orderCount++;
-                const char* statusStr = "Pending";
-                switch(order.status) {
-                    case OrderStatus::Pending: statusStr = "Pending"; break;
-                    case OrderStatus::InProgress: statusStr = "In Progress"; break;
-                    case OrderStatus::Completed: statusStr = "Completed"; break;
-                    case OrderStatus::Cancelled: statusStr = "Cancelled"; break;
-                }
-                
-                char label[256];
-                snprintf(label, sizeof(label), "[ID:%d] %s - %s", 
-                         order.orderID, order.orderName.c_str(), statusStr);
-                
-                if (ImGui::Selectable(label, app.selectedOrderID == order.orderID)) {
-                    app.selectedOrderID = order.orderID;
+            for (const auto& row : app.customerRows) {
+                if (ImGui::Selectable(row.second.c_str(), app.selectedOrderID == row.first)) {
+                    app.selectedOrderID = row.first;
                     app.detailsPrefilled = false;
                     app.currentScreen = AppState::OrderDetails;
                 }
             }
-            if (orderCount == 0) {
+            if (app.customerRows.empty()) {
                 ImGui::TextDisabled("No orders yet. Create your first order!");
             }
             ImGui::EndChild();
@@ -333,7 +562,6 @@ int main(int, char**)
             ImGui::Separator();
             
             if (ImGui::Button("New Order##btn", ImVec2(150, 0))) {
-                app.nextOrderID = 1001 + (int)app.manager.getOrders().size();
                 strcpy(app.bufOrderName, "");
                 strcpy(app.bufReference, "");
                 strcpy(app.bufExtras, "");
@@ -342,6 +570,9 @@ int main(int, char**)
                 app.currentScreen = AppState::NewOrder;
             }
             
+            ImGui::SameLine();
+            drawUndoRedoButtons(app, "custmenu");
+            
             ImGui::End();
         }
 
@@ -353,7 +584,7 @@ int main(int, char**)
             
             ImGui::Text("Create a new order (Customer ID: %d)", app.loggedUserID);
             ImGui::Separator();
-            ImGui::Text("Order ID will be auto-assigned: %d", app.nextOrderID);
+            ImGui::TextDisabled("The order ID is assigned when the order is created.");
             ImGui::InputText("Order Name##neworder", app.bufOrderName, IM_ARRAYSIZE(app.bufOrderName));
             
             const char* kinds[] = { "Logo", "Status", "Feed", "Asset", "Document", "Other" };
@@ -375,7 +606,7 @@ int main(int, char**)
                     using namespace std::chrono;
                     auto deadline = system_clock::now() + hours(24 * app.deadlineDays);
                     Customer cust(app.loggedUserID, "User");
-                    cust.createOrder(app.manager, app.nextOrderID, 
+                    cust.createOrder(app.manager,
                                     std::string(app.bufOrderName), 
                                     static_cast<OrderKind>(app.kindIndex),
                                     deadline, 
@@ -416,7 +647,7 @@ int main(int, char**)
                 }
                 ImGui::End();
             } else {
-                Order* order = app.manager.findOrder(app.selectedOrderID);
+                std::shared_ptr<const Order> order = view->find(app.selectedOrderID);
                 
                 if (!order) {
                     ImGui::Text("Order not found (may have been deleted).");
@@ -437,6 +668,7 @@ int main(int, char**)
                         app.bufReference[sizeof(app.bufReference) - 1] = '\0';
                         strncpy(app.bufExtras, order->extras.c_str(), sizeof(app.bufExtras) - 1);
                         app.bufExtras[sizeof(app.bufExtras) - 1] = '\0';
+                        app.editBaseVersion = order->version;
                         app.detailsPrefilled = true;
                     }
                     
@@ -497,15 +729,20 @@ int main(int, char**)
                             using namespace std::chrono;
                             auto deadline = system_clock::now() + hours(24 * app.deadlineDays);
                             Customer cust(app.loggedUserID, "User");
-                            cust.modifyOrder(app.manager, order->orderID,
+                            UpdateResult result = cust.modifyOrder(app.manager, order->orderID,
                                             std::string(app.bufOrderName),
                                             static_cast<OrderKind>(app.kindIndex),
                                             deadline,
                                             std::string(app.bufReference),
-                                            std::string(app.bufExtras));
-                            app.currentScreen = AppState::CustomerMenu;
-                            app.selectedOrderID = 0;
-                            app.detailsPrefilled = false;
+                                            std::string(app.bufExtras),
+                                            app.editBaseVersion);
+                            if (result == UpdateResult::Conflict) {
+                                ImGui::OpenPopup("update_conflict");
+                            } else {
+                                app.currentScreen = AppState::CustomerMenu;
+                                app.selectedOrderID = 0;
+                                app.detailsPrefilled = false;
+                            }
                         }
                     }
                     
@@ -529,7 +766,7 @@ int main(int, char**)
                     // Delete confirmation popup
                     if (ImGui::BeginPopupModal("delete_confirm", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
                         ImGui::Text("Are you sure you want to delete this order?");
-                        ImGui::Text("This action cannot be undone.");
+                        ImGui::Text("You can restore it with Undo from the menu.");
                         ImGui::Separator();
                         if (ImGui::Button("Yes, Delete", ImVec2(120, 0))) {
                             app.manager.deleteOrder(app.selectedOrderID);
@@ -554,6 +791,22 @@ int main(int, char**)
                         ImGui::EndPopup();
                     }
                     
+                    // Stale edit popup
+                    if (ImGui::BeginPopupModal("update_conflict", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+                        ImGui::Text("This order was changed by someone else while you were editing.");
+                        ImGui::Text("Your changes were not saved.");
+                        ImGui::Separator();
+                        if (ImGui::Button("Reload Order##conflict", ImVec2(150, 0))) {
+                            app.detailsPrefilled = false;
+                            ImGui::CloseCurrentPopup();
+                        }
+                        ImGui::SameLine();
+                        if (ImGui::Button("Keep Editing##conflict", ImVec2(150, 0))) {
+                            ImGui::CloseCurrentPopup();
+                        }
+                        ImGui::EndPopup();
+                    }
+                    
                     ImGui::End();
                 }
             }
@@ -562,7 +815,10 @@ int main(int, char**)
         // ========== EDITOR MENU WINDOW ==========
         if (app.currentScreen == AppState::EditorMenu) {
             ImGui::SetNextWindowSize(ImVec2(700, 450), ImGuiCond_FirstUseEver);
-            ImGui::Begin("Editor Menu", nullptr);
+            ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags_TryToAvoidRefresh | ImGuiWindowRefreshFlags_RefreshOnChange,
+                                              editorMenuContentHash(app, *view));
+            // false while the window reuses last frame's contents (or is collapsed)
+            bool editorMenuVisible = ImGui::Begin("Editor Menu", nullptr);
             
             ImGui::Text("Logged in as: %s (Editor, ID: %d)", app.loggedUsername.c_str(), app.loggedUserID);
             if (ImGui::Button("Logout##editormenu")) {
@@ -573,32 +829,142 @@ int main(int, char**)
             }
             
             ImGui::Separator();
-            ImGui::Text("All Orders:");
+            if (ImGui::InputTextWithHint("##editor_search", "Search name, reference or extras...", app.bufSearch, IM_ARRAYSIZE(app.bufSearch))) {
+                runSearch(app);
+            }
+            bool searching = app.bufSearch[0] != '\0';
+            if (searching) {
+                ImGui::Text("Search Results (%d):", (int)app.searchResults.size());
+            } else {
+                ImGui::Text("All Orders:");
+            }
             
             ImGui::BeginChild("editor_orders_list", ImVec2(0, 250), true);
-            for (const auto& order : app.manager.getOrders()) {
-                char label[256];
-                const char* statusStr = "";
-                switch (order.status) {
-                    case OrderStatus::Pending: statusStr = "Pending"; break;
-                    case OrderStatus::InProgress: statusStr = "In Progress"; break;
-                    case OrderStatus::Completed: statusStr = "Completed"; break;
+            auto drawOrderRow = [&app, &view](int orderID, const std::string& label) {
+                if (ImGui::Selectable(label.c_str(), app.selectedOrderID == orderID)) {
+                    if (auto order = view->find(orderID)) {
+                        app.selectedOrderID = orderID;
+                        app.statusIndex = static_cast<int>(order->status);
+                        app.currentScreen = AppState::EditorOrderDetails;
+                    }
                 }
-                snprintf(label, sizeof(label), "[ID:%d] %s (Customer: %d) [%s]", 
-                         order.orderID, order.orderName.c_str(), order.customerID, statusStr);
-                
-                if (ImGui::Selectable(label, app.selectedOrderID == order.orderID)) {
-                    app.selectedOrderID = order.orderID;
-                    app.statusIndex = static_cast<int>(order.status);
-                    app.currentScreen = AppState::EditorOrderDetails;
+            };
+            if (searching) {
+                for (const auto& result : app.searchResults) {
+                    auto row = app.editorRows.find(result.orderID);
+                    if (row != app.editorRows.end()) {
+                        drawOrderRow(row->first, row->second);
+                    }
+                }
+                if (app.searchResults.empty()) {
+                    ImGui::TextDisabled("No matching orders.");
+                }
+            } else {
+                for (const auto& row : app.editorRows) {
+                    drawOrderRow(row.first, row.second);
                 }
             }
             ImGui::EndChild();
-            
+
+            // Deadline overview (served from the deadline index, no list scan)
             ImGui::Separator();
-            
+            ImGui::Text("Deadlines:");
+            if (editorMenuVisible) {
+                auto now = std::chrono::system_clock::now();
+                int overdue = (int)app.manager.countOverdue(now);
+                int atRisk = (int)app.manager.countDueWithin(now, 3);
+
+                if (!app.overdueAlerts.empty()) {
+                    ImGui::TextColored(ImVec4(1, 0.3f, 0.3f, 1), "%d order(s) just went overdue!", (int)app.overdueAlerts.size());
+                    ImGui::SameLine();
+                    if (ImGui::SmallButton("Dismiss##overdue")) {
+                        app.overdueAlerts.clear();
+                    }
+                }
+
+                ImGui::TextColored(ImVec4(1, 0.3f, 0.3f, 1), "Overdue: %d", overdue);
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.2f, 1.0f), "Due within 3 days: %d", atRisk);
+
+                for (int orderID : app.manager.nextDue(5, now)) {
+                    auto order = view->find(orderID);
+                    if (!order) continue;
+                    ImGui::BulletText("[ID:%d] %s - %d day(s) left", order->orderID, order->orderName.c_str(),
+                                      calculateDaysUntilDeadline(order->deadline));
+                }
+            }
+
+            // Dashboard (counters are maintained by OrderManager, reads are O(1))
+            if (ImGui::CollapsingHeader("Dashboard##editor")) {
+                const OrderStats& stats = view->stats;
+                ImGui::Text("Total: %d | Unassigned: %d | Assigned to me: %d",
+                            stats.total(), stats.unassignedCount(), stats.countForEditor(app.loggedUsername));
+                ImGui::Text("Pending: %d | In Progress: %d | Completed: %d | Cancelled: %d",
+                            stats.countByStatus(OrderStatus::Pending), stats.countByStatus(OrderStatus::InProgress),
+                            stats.countByStatus(OrderStatus::Completed), stats.countByStatus(OrderStatus::Cancelled));
+                ImGui::Text("Logo: %d | Status: %d | Feed: %d | Asset: %d | Document: %d | Other: %d",
+                            stats.countByKind(OrderKind::Logo), stats.countByKind(OrderKind::Status),
+                            stats.countByKind(OrderKind::Feed), stats.countByKind(OrderKind::Asset),
+                            stats.countByKind(OrderKind::Document), stats.countByKind(OrderKind::Other));
+                for (const auto& entry : stats.getEditorCounts()) {
+                    ImGui::BulletText("%s: %d order(s), %d open", entry.first.c_str(), entry.second,
+                                      stats.openForEditor(entry.first));
+                }
+            }
+
+            if (ImGui::CollapsingHeader("Import / Export##editor")) {
+                ImGui::InputText("File (.csv or .jsonl)##transfer", app.bufTransferPath, sizeof(app.bufTransferPath));
+                if (ImGui::Button("Import##transfer", ImVec2(150, 0))) {
+                    ImportReport report;
+                    app.transferErrors.clear();
+                    if (OrderTransfer::importFile(app.bufTransferPath, app.manager, report)) {
+                        char msg[160];
+                        snprintf(msg, sizeof(msg), "Imported %d order(s), %d rejected, in %.2f s",
+                                 (int)report.imported, (int)report.errorCount, report.seconds);
+                        app.transferMsg = msg;
+                        app.transferErrors = report.errors;
+                    } else {
+                        app.transferMsg = "Could not open the file (use .csv or .jsonl)";
+                    }
+                }
+                ImGui::SameLine();
+                if (ImGui::Button("Export##transfer", ImVec2(150, 0))) {
+                    size_t written = 0;
+                    app.transferErrors.clear();
+                    if (OrderTransfer::exportFile(app.bufTransferPath, app.manager, written)) {
+                        app.transferMsg = "Exported " + std::to_string(written) + " order(s)";
+                    } else {
+                        app.transferMsg = "Could not write the file (use .csv or .jsonl)";
+                    }
+                }
+                if (!app.transferMsg.empty()) {
+                    ImGui::Text("%s", app.transferMsg.c_str());
+                }
+                if (!app.transferErrors.empty()) {
+                    ImGui::BeginChild("transfer_errors", ImVec2(0, 100), true);
+                    for (const auto& error : app.transferErrors) {
+                        ImGui::TextColored(ImVec4(1, 0.3f, 0.3f, 1), "Line %d: %s", (int)error.line, error.message.c_str());
+                    }
+                    ImGui::EndChild();
+                }
+            }
+
+            ImGui::Separator();
+
             if (ImGui::Button("Refresh##editor", ImVec2(150, 0))) {
-                // Refresh is automatic (list is dynamic)
+                // Lists follow the change feed; this forces a full rebuild anyway
+                app.rowsValid = false;
+            }
+            
+            ImGui::SameLine();
+            if (ImGui::Button("Auto-assign##editor", ImVec2(150, 0))) {
+                runScheduler(app, true);
+            }
+            
+            ImGui::SameLine();
+            drawUndoRedoButtons(app, "editormenu");
+            if (!app.autoAssignMsg.empty()) {
+                ImGui::TextDisabled("%s", app.autoAssignMsg.c_str());
             }
             
             ImGui::End();
@@ -616,7 +982,7 @@ int main(int, char**)
                 }
                 ImGui::End();
             } else {
-                Order* order = app.manager.findOrder(app.selectedOrderID);
+                std::shared_ptr<const Order> order = view->find(app.selectedOrderID);
                 
                 if (!order) {
                     ImGui::Text("Order not found (may have been deleted).");
@@ -638,6 +1004,7 @@ int main(int, char**)
                         app.bufEditorAssign[sizeof(app.bufEditorAssign) - 1] = '\0';
                         app.kindIndex = static_cast<int>(order->orderKind);
                         app.statusIndex = static_cast<int>(order->status);
+                        app.editBaseVersion = order->version;
                         app.detailsPrefilled = true;
                     }
                     
@@ -688,15 +1055,23 @@ int main(int, char**)
                             // Show "Unassign" button only if assigned to current editor
                             if (order->editorAssigned == app.loggedUsername) {
                                 if (ImGui::Button("Unassign from Me##editor_unassign", ImVec2(150, 0))) {
-                                    order->unassignEditor();
-                                    ImGui::OpenPopup("editor_unassign_success");
+                                    if (app.manager.unassignEditor(order->orderID, order->version) == UpdateResult::Conflict) {
+                                        ImGui::OpenPopup("editor_conflict");
+                                    } else {
+                                        advanceEditBase(app, order->orderID, order->version);
+                                        ImGui::OpenPopup("editor_unassign_success");
+                                    }
                                 }
                             }
                         } else {
                             ImGui::Text("Assigned to: (None)");
                             if (ImGui::Button("Assign to Me##editor_assign", ImVec2(150, 0))) {
-                                order->assignEditor(app.loggedUsername);
-                                ImGui::OpenPopup("editor_assign_success");
+                                if (app.manager.assignEditor(order->orderID, app.loggedUsername, order->version) == UpdateResult::Conflict) {
+                                    ImGui::OpenPopup("editor_conflict");
+                                } else {
+                                    advanceEditBase(app, order->orderID, order->version);
+                                    ImGui::OpenPopup("editor_assign_success");
+                                }
                             }
                         }
                     }
@@ -708,9 +1083,20 @@ int main(int, char**)
                         ImGui::BeginDisabled();
                     }
                     if (ImGui::Button("Save Changes##editor", ImVec2(150, 0))) {
-                        order->status = static_cast<OrderStatus>(app.statusIndex);
-                        order->finalLink = std::string(app.bufFinalLink);
-                        ImGui::OpenPopup("editor_save_success");
+                        UpdateResult result = app.manager.updateProgress(order->orderID,
+                                                                         static_cast<OrderStatus>(app.statusIndex),
+                                                                         std::string(app.bufFinalLink),
+                                                                         app.editBaseVersion);
+                        if (result == UpdateResult::Conflict) {
+                            ImGui::OpenPopup("editor_conflict");
+                        } else {
+                            advanceEditBase(app, order->orderID, app.editBaseVersion);
+                            // A finished order frees its editor up for queued work
+                            if (static_cast<OrderStatus>(app.statusIndex) == OrderStatus::Completed) {
+                                runScheduler(app, false);
+                            }
+                            ImGui::OpenPopup("editor_save_success");
+                        }
                     }
                     
                     if (isCompleted) {
@@ -751,7 +1137,7 @@ int main(int, char**)
                     // Delete confirmation popup
                     if (ImGui::BeginPopupModal("editor_delete_confirm", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
                         ImGui::Text("Are you sure you want to delete this order?");
-                        ImGui::Text("This action cannot be undone.");
+                        ImGui::Text("You can restore it with Undo from the menu.");
                         ImGui::Separator();
                         if (ImGui::Button("Yes, Delete##editor", ImVec2(120, 0))) {
                             app.manager.deleteOrder(app.selectedOrderID);
@@ -776,6 +1162,17 @@ int main(int, char**)
                         ImGui::EndPopup();
                     }
                     
+                    // Stale edit popup
+                    if (ImGui::BeginPopupModal("editor_conflict", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+                        ImGui::Text("This order was changed by someone else in the meantime.");
+                        ImGui::Text("Your changes were not saved.");
+                        if (ImGui::Button("Reload Order##editor_conflict", ImVec2(150, 0))) {
+                            app.detailsPrefilled = false;
+                            ImGui::CloseCurrentPopup();
+                        }
+                        ImGui::EndPopup();
+                    }
+                    
                     // Unassignment success popup
                     if (ImGui::BeginPopupModal("editor_unassign_success", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
                         ImGui::Text("You have been unassigned from this order!");
@@ -790,6 +1187,26 @@ int main(int, char**)
             }
         }
 
+        // Render stats overlay: how much geometry the last frame sent to the GPU
+        if (ImGui::IsKeyPressed(ImGuiKey_F3, false))
+            app.showRenderStats = !app.showRenderStats;
+        if (app.showRenderStats) {
+            ImGui_ImplDX9_RenderStats stats;
+            ImGui_ImplDX9_GetRenderStats(&stats);
+            ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - 10, viewport->WorkPos.y + 10), ImGuiCond_Always, ImVec2(1, 0));
+            ImGui::SetNextWindowBgAlpha(0.75f);
+            ImGui::Begin("Render stats", &app.showRenderStats, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
+            ImGui::Text("Uploaded: %.1f of %.1f KB (vertices %.1f, indices %.1f)",
+                        (stats.VtxBytesUploaded + stats.IdxBytesUploaded) / 1024.0f, (stats.VtxBytesDrawn + stats.IdxBytesDrawn) / 1024.0f,
+                        stats.VtxBytesUploaded / 1024.0f, stats.IdxBytesUploaded / 1024.0f);
+            ImGui::Text("Draw lists: %d uploaded, %d reused", stats.DrawListsUploaded, stats.DrawListsReused);
+            ImGui::Text("Buffer discards: %d, resizes: %d", stats.BufferDiscards, stats.BufferResizes);
+            if (ImGuiWindow* editorMenu = ImGui::FindWindowByName("Editor Menu")) {
+                ImGui::Text("Editor Menu: %d frame(s) reused, %d redrawn", editorMenu->SkipRefreshHits, editorMenu->SkipRefreshMisses);
+            }
+            ImGui::End();
+        }
+
         // Rendering
         ImGui::EndFrame();
         g_pd3dDevice->SetRenderState(D3DRS_ZENABLE, FALSE);
@@ -810,6 +1227,8 @@ int main(int, char**)
 
     // Save data before shutdown
     SaveManager::saveToFile("savedata.txt", app.manager, app.userManager);
+    if (uiFont)
+        ImFontAtlasBakedSaveToFile(io.Fonts, uiFont->GetFontBaked(16.0f), "fontcache.bin");
 
     ImGui_ImplDX9_Shutdown();
     ImGui_ImplWin32_Shutdown();
@@ -0,0 +1,69 @@
+#include "ChangeFeed.hpp"
+
+ChangeFeed::ChangeFeed(size_t capacityPow2)
+    : mask(capacityPow2 - 1), slots(new Slot[capacityPow2]) {}
+
+void ChangeFeed::publish(OrderEventType type, int orderID, int customerID, uint64_t version) {
+    uint64_t seq = nextSequence.load(memory_order_relaxed);
+    Slot& slot = slots[seq & mask];
+
+    slot.stamp.store(seq * 2 + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot.type.store(static_cast<uint8_t>(type), memory_order_relaxed);
+    slot.orderID.store(orderID, memory_order_relaxed);
+    slot.customerID.store(customerID, memory_order_relaxed);
+    slot.version.store(version, memory_order_relaxed);
+    slot.stamp.store(seq * 2 + 2, memory_order_release);
+
+    nextSequence.store(seq + 1, memory_order_release);
+}
+
+ChangeFeed::Cursor ChangeFeed::subscribe() const {
+    Cursor cursor;
+    cursor.next = nextSequence.load(memory_order_acquire);
+    return cursor;
+}
+
+size_t ChangeFeed::poll(Cursor& cursor, vector<OrderEvent>& out, size_t maxEvents) const {
+    uint64_t end = nextSequence.load(memory_order_acquire);
+    if (end - cursor.next > mask + 1) {
+        cursor.next = end;
+        cursor.overrun = true;
+        return 0;
+    }
+
+    size_t count = 0;
+    while (cursor.next < end && count < maxEvents) {
+        uint64_t seq = cursor.next;
+        const Slot& slot = slots[seq & mask];
+
+        // Seqlock read: the stamp must be the completed stamp for seq before and after
+        uint64_t stamp = slot.stamp.load(memory_order_acquire);
+        OrderEvent event;
+        event.sequence = seq;
+        event.type = static_cast<OrderEventType>(slot.type.load(memory_order_relaxed));
+        event.orderID = slot.orderID.load(memory_order_relaxed);
+        event.customerID = slot.customerID.load(memory_order_relaxed);
+        event.version = slot.version.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (stamp != seq * 2 + 2 || slot.stamp.load(memory_order_relaxed) != stamp) {
+            // The writer lapped us while we were reading
+            cursor.next = nextSequence.load(memory_order_acquire);
+            cursor.overrun = true;
+            return count;
+        }
+
+        out.push_back(event);
+        cursor.next++;
+        count++;
+    }
+    return count;
+}
+
+bool ChangeFeed::hasPending(const Cursor& cursor) const {
+    return nextSequence.load(memory_order_acquire) != cursor.next;
+}
+
+uint64_t ChangeFeed::head() const {
+    return nextSequence.load(memory_order_acquire);
+}
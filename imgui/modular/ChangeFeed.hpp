@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+using namespace std;
+
+enum class OrderEventType : uint8_t {
+    Created,
+    Modified,       // name, kind, deadline, reference, extras or links
+    StatusChanged,
+    Assigned,       // editor assigned or unassigned
+    Deleted,
+};
+
+struct OrderEvent {
+    uint64_t sequence;
+    OrderEventType type;
+    int orderID;
+    int customerID;
+    uint64_t version;   // Order::version after the write (0 for Deleted)
+};
+
+// Fixed-size ring of order events. One writer at a time publishes (OrderManager
+// calls it under its writer lock); any number of readers poll with their own
+// cursor and never block the writer. A reader that falls more than capacity
+// events behind loses events and is told to resync from a snapshot.
+class ChangeFeed {
+public:
+    struct Cursor {
+        uint64_t next = 0;
+        bool overrun = false;   // events were lost, rebuild from OrderManager::snapshot()
+    };
+
+    explicit ChangeFeed(size_t capacityPow2 = 4096);
+
+    void publish(OrderEventType type, int orderID, int customerID, uint64_t version);
+
+    // Cursor positioned after the latest event
+    Cursor subscribe() const;
+    // Appends up to maxEvents new events to out and advances the cursor
+    size_t poll(Cursor& cursor, vector<OrderEvent>& out, size_t maxEvents = SIZE_MAX) const;
+    bool hasPending(const Cursor& cursor) const;
+    uint64_t head() const;
+
+private:
+    struct Slot {
+        atomic<uint64_t> stamp{0};  // 2*seq+1 while writing, 2*seq+2 once complete
+        atomic<uint8_t> type{0};
+        atomic<int> orderID{0};
+        atomic<int> customerID{0};
+        atomic<uint64_t> version{0};
+    };
+
+    size_t mask;
+    unique_ptr<Slot[]> slots;
+    atomic<uint64_t> nextSequence{0};
+};
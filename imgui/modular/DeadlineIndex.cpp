@@ -0,0 +1,219 @@
+#include "DeadlineIndex.hpp"
+#include <algorithm>
+
+// First chunk whose last deadline is >= deadline, or the last chunk
+size_t DeadlineCounts::chunkFor(const TimePoint& deadline) const {
+    auto it = lower_bound(chunks.begin(), chunks.end(), deadline, [](const vector<TimePoint>& chunk, const TimePoint& t) {
+        return chunk.back() < t;
+    });
+    if (it == chunks.end()) return chunks.size() - 1;
+    return it - chunks.begin();
+}
+
+void DeadlineCounts::recount(size_t from) {
+    before.resize(chunks.size());
+    for (size_t c = from; c < chunks.size(); c++) {
+        before[c] = (c == 0) ? 0 : before[c - 1] + chunks[c - 1].size();
+    }
+}
+
+void DeadlineCounts::insert(const TimePoint& deadline) {
+    total++;
+    if (chunks.empty()) {
+        chunks.push_back({ deadline });
+        recount(0);
+        return;
+    }
+    size_t c = chunkFor(deadline);
+    vector<TimePoint>& chunk = chunks[c];
+    chunk.insert(upper_bound(chunk.begin(), chunk.end(), deadline), deadline);
+    if (chunk.size() > 2 * ChunkSize) {
+        vector<TimePoint> upper(chunk.begin() + ChunkSize, chunk.end());
+        chunk.resize(ChunkSize);
+        chunks.insert(chunks.begin() + c + 1, move(upper));
+    }
+    recount(c + 1);
+}
+
+void DeadlineCounts::insertSorted(const vector<TimePoint>& sorted) {
+    if (sorted.empty()) return;
+    vector<TimePoint> merged;
+    merged.reserve(total + sorted.size());
+    for (const auto& chunk : chunks) merged.insert(merged.end(), chunk.begin(), chunk.end());
+    size_t middle = merged.size();
+    merged.insert(merged.end(), sorted.begin(), sorted.end());
+    inplace_merge(merged.begin(), merged.begin() + middle, merged.end());
+
+    total = merged.size();
+    chunks.clear();
+    for (size_t i = 0; i < merged.size(); i += ChunkSize) {
+        chunks.emplace_back(merged.begin() + i, merged.begin() + min(merged.size(), i + ChunkSize));
+    }
+    recount(0);
+}
+
+void DeadlineCounts::erase(const TimePoint& deadline) {
+    if (chunks.empty()) return;
+    size_t c = chunkFor(deadline);
+    vector<TimePoint>& chunk = chunks[c];
+    auto it = lower_bound(chunk.begin(), chunk.end(), deadline);
+    if (it == chunk.end() || *it != deadline) return;
+    total--;
+    chunk.erase(it);
+    if (chunk.empty()) {
+        chunks.erase(chunks.begin() + c);
+        recount(c);
+    } else {
+        recount(c + 1);
+    }
+}
+
+void DeadlineCounts::clear() {
+    chunks.clear();
+    before.clear();
+    total = 0;
+}
+
+size_t DeadlineCounts::countUpTo(const TimePoint& t) const {
+    // First chunk with a deadline after t; everything before it counts
+    auto it = upper_bound(chunks.begin(), chunks.end(), t, [](const TimePoint& time, const vector<TimePoint>& chunk) {
+        return time < chunk.back();
+    });
+    if (it == chunks.end()) return total;
+    size_t c = it - chunks.begin();
+    return before[c] + (upper_bound(it->begin(), it->end(), t) - it->begin());
+}
+
+void DeadlineIndex::insert(int orderID, const TimePoint& deadline) {
+    if (entries.count(orderID)) {
+        update(orderID, deadline);
+        return;
+    }
+    entries[orderID] = byDeadline.emplace(deadline, orderID);
+    counts.insert(deadline);
+    if (deadline <= watermark) {
+        lateArrivals.push_back(orderID);
+    }
+}
+
+void DeadlineIndex::insertAll(vector<pair<TimePoint, int>> batch) {
+    if (batch.empty()) return;
+    sort(batch.begin(), batch.end());
+    entries.reserve(entries.size() + batch.size());
+    vector<TimePoint> added;
+    added.reserve(batch.size());
+    auto hint = byDeadline.upper_bound(batch.front().first);
+    for (const auto& entry : batch) {
+        if (entries.count(entry.second)) {
+            update(entry.second, entry.first);
+            continue;
+        }
+        auto it = byDeadline.emplace_hint(hint, entry.first, entry.second);
+        entries[entry.second] = it;
+        added.push_back(entry.first);
+        hint = next(it);
+        if (entry.first <= watermark) {
+            lateArrivals.push_back(entry.second);
+        }
+    }
+    counts.insertSorted(added);
+}
+
+void DeadlineIndex::update(int orderID, const TimePoint& deadline) {
+    auto it = entries.find(orderID);
+    if (it == entries.end()) {
+        insert(orderID, deadline);
+        return;
+    }
+    if (it->second->first == deadline) return;
+
+    bool wasOverdue = it->second->first <= watermark;
+    counts.erase(it->second->first);
+    counts.insert(deadline);
+    byDeadline.erase(it->second);
+    it->second = byDeadline.emplace(deadline, orderID);
+    if (!wasOverdue && deadline <= watermark) {
+        lateArrivals.push_back(orderID);
+    }
+}
+
+void DeadlineIndex::remove(int orderID) {
+    auto it = entries.find(orderID);
+    if (it == entries.end()) return;
+    counts.erase(it->second->first);
+    byDeadline.erase(it->second);
+    entries.erase(it);
+}
+
+void DeadlineIndex::clear() {
+    byDeadline.clear();
+    entries.clear();
+    counts.clear();
+    lateArrivals.clear();
+    watermark = TimePoint{};
+}
+
+bool DeadlineIndex::contains(int orderID) const {
+    return entries.count(orderID) != 0;
+}
+
+size_t DeadlineIndex::size() const {
+    return byDeadline.size();
+}
+
+vector<int> DeadlineIndex::nextDue(size_t n, const TimePoint& now) const {
+    vector<int> result;
+    for (auto it = byDeadline.upper_bound(now); it != byDeadline.end() && result.size() < n; ++it) {
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+vector<int> DeadlineIndex::overdue(const TimePoint& now) const {
+    vector<int> result;
+    auto end = byDeadline.upper_bound(now);
+    for (auto it = byDeadline.begin(); it != end; ++it) {
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+vector<int> DeadlineIndex::dueWithin(const TimePoint& now, int days) const {
+    vector<int> result;
+    auto end = byDeadline.upper_bound(now + chrono::hours(24 * days));
+    for (auto it = byDeadline.upper_bound(now); it != end; ++it) {
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+size_t DeadlineIndex::countOverdue(const TimePoint& now) const {
+    return counts.countUpTo(now);
+}
+
+size_t DeadlineIndex::countDueWithin(const TimePoint& now, int days) const {
+    return counts.countUpTo(now + chrono::hours(24 * days)) - counts.countUpTo(now);
+}
+
+void DeadlineIndex::pollOverdue(const TimePoint& now, const function<void(int)>& onOverdue) {
+    // Orders that were added or moved behind the watermark since the last poll
+    for (int orderID : lateArrivals) {
+        auto it = entries.find(orderID);
+        if (it != entries.end() && it->second->first <= watermark) {
+            onOverdue(orderID);
+        }
+    }
+    lateArrivals.clear();
+
+    if (now <= watermark) return;
+    auto end = byDeadline.upper_bound(now);
+    for (auto it = byDeadline.upper_bound(watermark); it != end; ++it) {
+        onOverdue(it->second);
+    }
+    watermark = now;
+}
+
+void DeadlineIndex::markReported(const TimePoint& now) {
+    lateArrivals.clear();
+    if (now > watermark) watermark = now;
+}
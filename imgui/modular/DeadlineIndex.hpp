@@ -0,0 +1,76 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Sorted deadlines, kept only to count how many fall at or before a time.
+// Stored in chunks of at most 2 * ChunkSize with the number of deadlines
+// before each chunk, so a count is two binary searches, O(log n), and a
+// change costs O(ChunkSize + n / ChunkSize).
+class DeadlineCounts {
+public:
+    using TimePoint = chrono::system_clock::time_point;
+
+    void insert(const TimePoint& deadline);
+    // Merges deadlines sorted ascending in one pass
+    void insertSorted(const vector<TimePoint>& sorted);
+    void erase(const TimePoint& deadline);
+    void clear();
+    // Number of deadlines at or before t
+    size_t countUpTo(const TimePoint& t) const;
+
+private:
+    static const size_t ChunkSize = 512;
+
+    vector<vector<TimePoint>> chunks;   // none empty
+    vector<size_t> before;              // deadlines in the chunks before each one
+    size_t total = 0;
+
+    size_t chunkFor(const TimePoint& deadline) const;
+    void recount(size_t from);
+};
+
+// Orders that are still open (Pending / InProgress) ordered by deadline.
+// Lookups are O(log n + k) for k returned orders; counts are O(log n).
+class DeadlineIndex {
+public:
+    using TimePoint = chrono::system_clock::time_point;
+
+    void insert(int orderID, const TimePoint& deadline);
+    // Same as insert() for every (deadline, orderID) pair, but sorted first so
+    // each entry goes in next to the previous one instead of searching the tree
+    void insertAll(vector<pair<TimePoint, int>> batch);
+    void update(int orderID, const TimePoint& deadline);
+    void remove(int orderID);
+    void clear();
+    bool contains(int orderID) const;
+    size_t size() const;
+
+    // Next n orders whose deadline is still in the future
+    vector<int> nextDue(size_t n, const TimePoint& now) const;
+    // Orders whose deadline is at or before now
+    vector<int> overdue(const TimePoint& now) const;
+    // Orders due between now and now + days (at-risk)
+    vector<int> dueWithin(const TimePoint& now, int days) const;
+    // Sizes of overdue() and dueWithin(), without building the lists
+    size_t countOverdue(const TimePoint& now) const;
+    size_t countDueWithin(const TimePoint& now, int days) const;
+
+    // Calls onOverdue once for every order that became overdue since the last poll
+    void pollOverdue(const TimePoint& now, const function<void(int)>& onOverdue);
+    // Treats everything due at or before now as already reported, e.g. the
+    // orders that were overdue when the data was loaded
+    void markReported(const TimePoint& now);
+
+private:
+    multimap<TimePoint, int> byDeadline;
+    unordered_map<int, multimap<TimePoint, int>::iterator> entries;
+    DeadlineCounts counts;
+
+    // Everything at or before the watermark has already been reported
+    TimePoint watermark{};
+    vector<int> lateArrivals;
+};
@@ -0,0 +1,127 @@
+#include "EditorScheduler.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+EditorScheduler::EditorScheduler() {}
+
+EditorScheduler::EditorScheduler(const Settings& settings) : settings(settings) {}
+
+const EditorScheduler::Settings& EditorScheduler::getSettings() const {
+    return settings;
+}
+
+void EditorScheduler::setSettings(const Settings& newSettings) {
+    settings = newSettings;
+}
+
+// Share of the editor's completed orders that were of this kind
+static double affinity(const OrderSnapshot& view, const string& editor, OrderKind kind) {
+    int completed = view.stats.completedForEditor(editor);
+    return completed ? view.stats.completedForEditor(editor, kind) / (double)completed : 0;
+}
+
+static bool earlierDeadline(const Order* a, const Order* b) {
+    if (a->deadline != b->deadline) return a->deadline < b->deadline;
+    return a->orderID < b->orderID;
+}
+
+vector<Assignment> EditorScheduler::plan(const OrderSnapshot& view, const vector<string>& editors,
+                                         const TimePoint& now) const {
+    vector<Assignment> result;
+    if (editors.empty() || settings.capacity <= 0) return result;
+
+    vector<const Order*> waiting;
+    for (const auto& order : view.orders) {
+        if (order->status == OrderStatus::Pending && order->editorAssigned.empty()) waiting.push_back(order.get());
+    }
+    if (waiting.empty()) return result;
+    sort(waiting.begin(), waiting.end(), earlierDeadline);
+
+    vector<int> load(editors.size());
+    int free = 0;
+    for (size_t e = 0; e < editors.size(); ++e) {
+        load[e] = view.stats.openForEditor(editors[e]);
+        free += max(0, settings.capacity - load[e]);
+    }
+
+    for (const Order* order : waiting) {
+        if (free == 0) break;
+        bool urgent = order->deadline - now <= settings.urgentWindow;
+        int best = -1;
+        double bestCost = 0;
+        for (size_t e = 0; e < editors.size(); ++e) {
+            if (load[e] >= settings.capacity) continue;
+            double cost = (load[e] + 1) / (double)settings.capacity;
+            if (!urgent) cost -= settings.specialization * affinity(view, editors[e], order->orderKind);
+            if (best < 0 || cost < bestCost) {
+                best = (int)e;
+                bestCost = cost;
+            }
+        }
+        result.push_back({ order->orderID, editors[best], string(), order->version });
+        load[best]++;
+        free--;
+    }
+    return result;
+}
+
+vector<Assignment> EditorScheduler::rebalance(const OrderSnapshot& view, const vector<string>& editors) const {
+    vector<Assignment> result;
+    if (editors.size() < 2) return result;
+
+    unordered_map<string, size_t> indexOf;
+    for (size_t e = 0; e < editors.size(); ++e) indexOf[editors[e]] = e;
+
+    // Stealable orders per editor, latest deadline at the back
+    vector<vector<const Order*>> queued(editors.size());
+    vector<int> load(editors.size());
+    for (size_t e = 0; e < editors.size(); ++e) load[e] = view.stats.openForEditor(editors[e]);
+    for (const auto& order : view.orders) {
+        if (order->status != OrderStatus::Pending || order->editorAssigned.empty()) continue;
+        auto it = indexOf.find(order->editorAssigned);
+        if (it != indexOf.end()) queued[it->second].push_back(order.get());
+    }
+    for (auto& list : queued) sort(list.begin(), list.end(), earlierDeadline);
+
+    for (;;) {
+        size_t thief = 0;
+        for (size_t e = 1; e < editors.size(); ++e) {
+            if (load[e] < load[thief]) thief = e;
+        }
+        if (load[thief] > settings.stealBelow) break;
+
+        size_t victim = thief;
+        for (size_t e = 0; e < editors.size(); ++e) {
+            if (queued[e].empty()) continue;
+            if (victim == thief || load[e] > load[victim]) victim = e;
+        }
+        if (victim == thief || load[victim] - load[thief] < 2) break;
+
+        // Take the latest order the thief knows at least as well as the
+        // victim. Moving work to someone slower at it only shifts the queue.
+        vector<const Order*>& from = queued[victim];
+        size_t pick = from.size();
+        for (size_t i = from.size(); i-- > 0;) {
+            OrderKind kind = from[i]->orderKind;
+            if (affinity(view, editors[thief], kind) >= affinity(view, editors[victim], kind)) {
+                pick = i;
+                break;
+            }
+        }
+        if (pick == from.size()) break;
+        const Order* order = from[pick];
+        from.erase(from.begin() + pick);
+        result.push_back({ order->orderID, editors[thief], editors[victim], order->version });
+        load[victim]--;
+        load[thief]++;
+    }
+    return result;
+}
+
+size_t EditorScheduler::apply(OrderManager& manager, const vector<Assignment>& assignments) {
+    size_t applied = 0;
+    for (const auto& move : assignments) {
+        if (manager.assignEditor(move.orderID, move.editor, move.version) == UpdateResult::Ok) applied++;
+    }
+    return applied;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "OrderManager.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+// One planned change of hands. from is empty for a fresh assignment.
+// version is the Order::version the plan was made from, so applying it
+// loses cleanly to anyone who touched the order in the meantime.
+struct Assignment {
+    int orderID;
+    string editor;
+    string from;
+    uint64_t version;
+};
+
+// Decides which editor gets which order. Plans are computed from a snapshot
+// and applied as ordinary optimistic writes, so the scheduler never holds
+// OrderManager's lock and can run next to editors clicking "Assign to Me".
+//
+// plan() hands out unassigned Pending orders earliest deadline first. Each
+// goes to the editor with the lowest cost:
+//     (open + 1) / capacity  -  specialization * share of the editor's
+//                               completed orders that were of this kind
+// so work spreads by load and drifts towards editors who usually do that
+// kind. Orders due within urgentWindow ignore specialization and go to
+// whoever is least loaded. Editors at capacity get nothing.
+//
+// rebalance() is the work-stealing half: an editor whose load has dropped
+// to stealBelow takes queued orders (assigned but still Pending) from the
+// busiest editor, latest deadline first, as long as that leaves the victim
+// at least as loaded as the thief. Only kinds the thief has done at least
+// as often as the victim are taken, and in-progress work is never moved.
+class EditorScheduler {
+public:
+    using TimePoint = chrono::system_clock::time_point;
+
+    struct Settings {
+        int capacity = 5;               // open orders per editor
+        double specialization = 0.5;    // weight of kind experience against load
+        chrono::hours urgentWindow{ 24 };
+        int stealBelow = 1;             // an editor this idle may steal
+    };
+
+    EditorScheduler();
+    explicit EditorScheduler(const Settings& settings);
+
+    const Settings& getSettings() const;
+    void setSettings(const Settings& settings);
+
+    vector<Assignment> plan(const OrderSnapshot& view, const vector<string>& editors, const TimePoint& now) const;
+    vector<Assignment> rebalance(const OrderSnapshot& view, const vector<string>& editors) const;
+
+    // Applies a plan in order; moves that lost a version race are skipped.
+    // Returns the number applied.
+    static size_t apply(OrderManager& manager, const vector<Assignment>& assignments);
+
+private:
+    Settings settings;
+};
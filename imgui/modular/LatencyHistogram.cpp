@@ -0,0 +1,96 @@
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static int highestBit(uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : counts((64 - SubBucketBits + 1) * SubBuckets, 0) {}
+
+// Values below 2*SubBuckets map one-to-one. Above that, a value with its
+// top bit at position b is shifted right by (b - SubBucketBits) so it lands
+// in [SubBuckets, 2*SubBuckets), and each shift gets its own block of
+// SubBuckets slots.
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < 2 * SubBuckets) return (size_t)value;
+    int shift = highestBit(value) - SubBucketBits;
+    return (size_t)(shift + 1) * SubBuckets + (size_t)((value >> shift) - SubBuckets);
+}
+
+// Highest value that maps to the bucket
+uint64_t LatencyHistogram::bucketValue(size_t index) {
+    if (index < 2 * SubBuckets) return index;
+    int shift = (int)(index / SubBuckets) - 1;
+    uint64_t sub = index % SubBuckets + SubBuckets;
+    return (sub << shift) + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t nanos) {
+    counts[bucketIndex(nanos)]++;
+    total++;
+    sum += (double)nanos;
+    if (nanos < minValue) minValue = nanos;
+    if (nanos > maxValue) maxValue = nanos;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+    total += other.total;
+    sum += other.sum;
+    if (other.minValue < minValue) minValue = other.minValue;
+    if (other.maxValue > maxValue) maxValue = other.maxValue;
+}
+
+void LatencyHistogram::clear() {
+    fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    sum = 0;
+    minValue = UINT64_MAX;
+    maxValue = 0;
+}
+
+uint64_t LatencyHistogram::count() const {
+    return total;
+}
+
+uint64_t LatencyHistogram::min() const {
+    return total ? minValue : 0;
+}
+
+uint64_t LatencyHistogram::max() const {
+    return maxValue;
+}
+
+double LatencyHistogram::mean() const {
+    return total ? sum / (double)total : 0.0;
+}
+
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    if (total == 0) return 0;
+    uint64_t target = (uint64_t)ceil(percentile / 100.0 * (double)total);
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            uint64_t value = bucketValue(i);
+            return value < maxValue ? value : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+string LatencyHistogram::summary() const {
+    char line[256];
+    snprintf(line, sizeof(line),
+             "n=%llu mean=%.1fus p50=%.1fus p99=%.1fus p99.9=%.1fus max=%.1fus",
+             (unsigned long long)total, mean() / 1000.0,
+             valueAtPercentile(50) / 1000.0, valueAtPercentile(99) / 1000.0,
+             valueAtPercentile(99.9) / 1000.0, max() / 1000.0);
+    return line;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+// HDR-style log-linear histogram of nanosecond latencies. Each power of two
+// is split into SubBuckets linear steps, so any recorded value is reported
+// within 1/SubBuckets (about 1.6%) of its true value, from 1 ns up to
+// hundreds of years, in a fixed ~30 KB of counters. Histograms from
+// different threads are combined with merge().
+class LatencyHistogram {
+public:
+    static const int SubBucketBits = 6;
+    static const int SubBuckets = 1 << SubBucketBits;
+
+    LatencyHistogram();
+
+    void record(uint64_t nanos);
+    void merge(const LatencyHistogram& other);
+    void clear();
+
+    uint64_t count() const;
+    uint64_t min() const;
+    uint64_t max() const;
+    double mean() const;
+    // Smallest recorded value v such that at least `percentile`% of samples are <= v
+    uint64_t valueAtPercentile(double percentile) const;
+
+    // "n=... mean=... p50=... p99=... p99.9=... max=..." in microseconds
+    string summary() const;
+
+private:
+    vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t minValue = UINT64_MAX;
+    uint64_t maxValue = 0;
+    double sum = 0;
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketValue(size_t index);
+};
@@ -0,0 +1,39 @@
+#pragma once
+// Minimal socket portability layer shared by OrderServer and OrderClient.
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+typedef SOCKET socket_t;
+typedef int socklen_t;
+#define NET_INVALID_SOCKET INVALID_SOCKET
+#define pollSockets WSAPoll
+inline int netLastError() { return WSAGetLastError(); }
+inline bool netWouldBlock(int err) { return err == WSAEWOULDBLOCK; }
+inline void netClose(socket_t s) { closesocket(s); }
+inline bool netSetNonBlocking(socket_t s) { u_long on = 1; return ioctlsocket(s, FIONBIO, &on) == 0; }
+inline bool netStartup() { WSADATA data; return WSAStartup(MAKEWORD(2, 2), &data) == 0; }
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int socket_t;
+#define NET_INVALID_SOCKET (-1)
+#define pollSockets poll
+inline int netLastError() { return errno; }
+inline bool netWouldBlock(int err) { return err == EAGAIN || err == EWOULDBLOCK; }
+inline void netClose(socket_t s) { close(s); }
+inline bool netSetNonBlocking(socket_t s) { return fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK) == 0; }
+inline bool netStartup() { return true; }
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
@@ -0,0 +1,156 @@
+#include "OrderClient.hpp"
+#include "NetCompat.hpp"
+#include <cstdlib>
+
+OrderClient::OrderClient() {}
+
+OrderClient::~OrderClient() {
+    disconnect();
+}
+
+bool OrderClient::connect(const string& host, uint16_t port) {
+    disconnect();
+    if (!netStartup()) return false;
+
+    socket_t s = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s == NET_INVALID_SOCKET) return false;
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 ||
+        ::connect(s, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        netClose(s);
+        return false;
+    }
+    int on = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&on, sizeof(on));
+    socket = (intptr_t)s;
+    return true;
+}
+
+void OrderClient::disconnect() {
+    if (socket != -1) netClose((socket_t)socket);
+    socket = -1;
+    buffer.clear();
+    deltas.clear();
+}
+
+bool OrderClient::isConnected() const {
+    return socket != -1;
+}
+
+bool OrderClient::sendAll(const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        int n = (int)::send((socket_t)socket, data.data() + sent, (int)(data.size() - sent), MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += n;
+    }
+    return true;
+}
+
+bool OrderClient::readLine(string& line) {
+    size_t end;
+    while ((end = buffer.find('\n')) == string::npos) {
+        char chunk[16 * 1024];
+        int n = (int)::recv((socket_t)socket, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buffer.append(chunk, n);
+    }
+    line.assign(buffer, 0, end);
+    buffer.erase(0, end + 1);
+    return true;
+}
+
+bool OrderClient::readBlock(vector<string>& lines) {
+    lines.clear();
+    string status;
+    if (!readLine(status)) return false;
+    lines.push_back(status);
+
+    if (status.compare(0, 5, "ROWS,") == 0 || status.compare(0, 6, "DELTA,") == 0) {
+        int rows = atoi(status.c_str() + status.find(',') + 1);
+        for (int i = 0; i < rows; ++i) {
+            string row;
+            if (!readLine(row)) return false;
+            lines.push_back(row);
+        }
+    }
+    return true;
+}
+
+bool OrderClient::readResponse(vector<string>& response) {
+    for (;;) {
+        if (!readBlock(response)) return false;
+        if (response[0].compare(0, 6, "DELTA,") != 0) return true;
+        deltas.emplace_back(response.begin() + 1, response.end());
+    }
+}
+
+bool OrderClient::call(const string& request, vector<string>& response) {
+    if (socket == -1 || !sendAll(request + "\n")) return false;
+    return readResponse(response);
+}
+
+bool OrderClient::send(const string& request) {
+    return socket != -1 && sendAll(request + "\n");
+}
+
+bool OrderClient::receive(vector<string>& response) {
+    return socket != -1 && readResponse(response);
+}
+
+bool OrderClient::callBatch(const vector<string>& requests, vector<vector<string>>& responses) {
+    if (socket == -1) return false;
+    string batch;
+    for (const auto& request : requests) batch += request + "\n";
+    if (!sendAll(batch)) return false;
+
+    responses.resize(requests.size());
+    for (auto& response : responses) {
+        if (!readResponse(response)) return false;
+    }
+    return true;
+}
+
+bool OrderClient::subscribe(const string& request, vector<string>& response) {
+    return call(request, response) && response[0].compare(0, 5, "ROWS,") == 0;
+}
+
+bool OrderClient::readLine(string& line, int timeoutMs) {
+    if (socket == -1) return false;
+    if (buffer.find('\n') == string::npos) {
+        pollfd fd = { (socket_t)socket, POLLIN, 0 };
+        if (pollSockets(&fd, 1, timeoutMs) <= 0) return false;
+    }
+    if (!readLine(line)) {
+        disconnect();
+        return false;
+    }
+    return true;
+}
+
+bool OrderClient::hasLine() const {
+    return buffer.find('\n') != string::npos;
+}
+
+bool OrderClient::readDelta(vector<string>& lines, int timeoutMs) {
+    lines.clear();
+    if (socket == -1) return false;
+    while (deltas.empty()) {
+        if (buffer.find('\n') == string::npos) {
+            pollfd fd = { (socket_t)socket, POLLIN, 0 };
+            if (pollSockets(&fd, 1, timeoutMs) <= 0) return false;
+        }
+        vector<string> block;
+        if (!readBlock(block)) {
+            disconnect();
+            return false;
+        }
+        if (block[0].compare(0, 6, "DELTA,") == 0) deltas.emplace_back(block.begin() + 1, block.end());
+    }
+    lines = move(deltas.front());
+    deltas.pop_front();
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Blocking client for OrderServer. call() sends one request and waits for
+// its response; callBatch() writes several requests in one send and then
+// reads all of their responses, which is how pipelining is exercised.
+class OrderClient {
+public:
+    OrderClient();
+    ~OrderClient();
+
+    bool connect(const string& host, uint16_t port);
+    void disconnect();
+    bool isConnected() const;
+
+    // Response lines for the request: the status line plus any ORDER rows
+    bool call(const string& request, vector<string>& response);
+    bool callBatch(const vector<string>& requests, vector<vector<string>>& responses);
+
+    // Split halves of call() for callers that keep several requests in
+    // flight; responses come back in request order. One thread may send
+    // while another receives.
+    bool send(const string& request);
+    bool receive(vector<string>& response);
+
+    // Sends a SUBSCRIBE request (see OrderService) and returns the initial rows.
+    // Pushed DELTA blocks that arrive while waiting for other responses are
+    // kept aside for readDelta.
+    bool subscribe(const string& request, vector<string>& response);
+    // Next pushed delta: its ORDER/REMOVED lines. Waits up to timeoutMs
+    // (-1 blocks); returns false with lines empty on timeout.
+    bool readDelta(vector<string>& lines, int timeoutMs);
+    // Next raw line from the server, for streams that are not request/response
+    // such as REPLICATE. Waits up to timeoutMs (-1 blocks).
+    bool readLine(string& line, int timeoutMs);
+    // True when a complete line is already buffered, so readLine won't wait
+    bool hasLine() const;
+
+private:
+    intptr_t socket = -1;
+    string buffer;
+    deque<vector<string>> deltas;
+
+    bool sendAll(const string& data);
+    bool readLine(string& line);
+    bool readBlock(vector<string>& lines);
+    bool readResponse(vector<string>& response);
+};
@@ -0,0 +1,110 @@
+#include "OrderHistory.hpp"
+
+static const OrderField AllFields[] = {
+    OrderField::Name, OrderField::Status, OrderField::Kind, OrderField::Deadline, OrderField::Reference,
+    OrderField::Extras, OrderField::EditorAssigned, OrderField::FinalLink, OrderField::CustomerID,
+};
+
+OrderChange OrderChange::diff(const Order& before, const Order& after) {
+    OrderChange change{ Kind::Update, after.orderID, {} };
+    for (OrderField field : AllFields) {
+        if (!before.sameField(after, field)) {
+            change.fields.push_back({ field, before.getField(field), after.getField(field) });
+        }
+    }
+    return change;
+}
+
+OrderChange OrderChange::created(const Order& order) {
+    OrderChange change{ Kind::Create, order.orderID, {} };
+    for (OrderField field : AllFields) {
+        change.fields.push_back({ field, string(), order.getField(field) });
+    }
+    return change;
+}
+
+OrderChange OrderChange::deleted(const Order& order) {
+    OrderChange change{ Kind::Delete, order.orderID, {} };
+    for (OrderField field : AllFields) {
+        change.fields.push_back({ field, order.getField(field), string() });
+    }
+    return change;
+}
+
+OrderChange OrderChange::inverse() const {
+    OrderChange result{ kind, orderID, {} };
+    if (kind == Kind::Create) result.kind = Kind::Delete;
+    if (kind == Kind::Delete) result.kind = Kind::Create;
+    for (const auto& delta : fields) {
+        result.fields.push_back({ delta.field, delta.after, delta.before });
+    }
+    return result;
+}
+
+bool OrderChange::applyTo(Order& order) const {
+    for (const auto& delta : fields) {
+        if (!order.setField(delta.field, delta.after)) return false;
+    }
+    return true;
+}
+
+bool OrderChange::matches(const Order& order) const {
+    for (const auto& delta : fields) {
+        if (order.getField(delta.field) != delta.after) return false;
+    }
+    return true;
+}
+
+Order OrderChange::toOrder() const {
+    Order order(orderID, string(), OrderKind::Other, chrono::system_clock::time_point());
+    applyTo(order);
+    return order;
+}
+
+OrderHistory::OrderHistory(size_t capacity) : capacity(capacity) {}
+
+void OrderHistory::record(OrderChange change) {
+    if (change.kind == OrderChange::Kind::Update && change.fields.empty()) return;
+    undoStack.push_back(move(change));
+    if (undoStack.size() > capacity) undoStack.pop_front();
+    redoStack.clear();
+}
+
+bool OrderHistory::canUndo() const {
+    return !undoStack.empty();
+}
+
+bool OrderHistory::canRedo() const {
+    return !redoStack.empty();
+}
+
+const OrderChange& OrderHistory::nextUndo() const {
+    return undoStack.back();
+}
+
+const OrderChange& OrderHistory::nextRedo() const {
+    return redoStack.back();
+}
+
+void OrderHistory::markUndone() {
+    redoStack.push_back(move(undoStack.back()));
+    undoStack.pop_back();
+}
+
+void OrderHistory::markRedone() {
+    undoStack.push_back(move(redoStack.back()));
+    redoStack.pop_back();
+}
+
+void OrderHistory::dropUndo() {
+    undoStack.pop_back();
+}
+
+void OrderHistory::dropRedo() {
+    redoStack.pop_back();
+}
+
+void OrderHistory::clear() {
+    undoStack.clear();
+    redoStack.clear();
+}
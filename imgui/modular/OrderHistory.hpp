@@ -0,0 +1,57 @@
+#pragma once
+#include "order.hpp"
+#include <deque>
+#include <string>
+#include <vector>
+using namespace std;
+
+// One changed column, encoded by Order::getField
+struct FieldDelta {
+    OrderField field;
+    string before;
+    string after;
+};
+
+// A single recorded mutation. Creates and deletes carry every field, updates
+// only the fields that actually changed.
+struct OrderChange {
+    enum class Kind { Create, Update, Delete };
+
+    Kind kind;
+    int orderID;
+    vector<FieldDelta> fields;
+
+    static OrderChange diff(const Order& before, const Order& after);
+    static OrderChange created(const Order& order);
+    static OrderChange deleted(const Order& order);
+    OrderChange inverse() const;
+
+    // Applies the "after" side of every field delta
+    bool applyTo(Order& order) const;
+    // True when the order still holds the "after" values (nothing overwrote them)
+    bool matches(const Order& order) const;
+    Order toOrder() const;
+};
+
+// Bounded undo/redo stacks. Recording a new change drops the redo stack.
+class OrderHistory {
+public:
+    explicit OrderHistory(size_t capacity = 256);
+
+    void record(OrderChange change);
+    bool canUndo() const;
+    bool canRedo() const;
+    const OrderChange& nextUndo() const;
+    const OrderChange& nextRedo() const;
+    void markUndone();
+    void markRedone();
+    // Drops an entry that can no longer be applied
+    void dropUndo();
+    void dropRedo();
+    void clear();
+
+private:
+    size_t capacity;
+    deque<OrderChange> undoStack;
+    vector<OrderChange> redoStack;
+};
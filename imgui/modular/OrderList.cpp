@@ -0,0 +1,118 @@
+#include "OrderList.hpp"
+#include <algorithm>
+
+static bool lessByID(const shared_ptr<const Order>& o, int orderID) {
+    return o->orderID < orderID;
+}
+
+// First chunk whose last ID is >= orderID, or the last chunk
+size_t OrderList::chunkFor(int orderID) const {
+    auto it = lower_bound(chunks.begin(), chunks.end(), orderID, [](const shared_ptr<Chunk>& chunk, int id) {
+        return chunk->back()->orderID < id;
+    });
+    if (it == chunks.end()) return chunks.size() - 1;
+    return it - chunks.begin();
+}
+
+// Copies the chunk first if another OrderList (a published snapshot) still
+// shares it. Only the writer's own list can hold the last reference, so
+// nobody can start sharing it concurrently.
+OrderList::Chunk& OrderList::own(size_t chunk) {
+    shared_ptr<Chunk>& c = chunks[chunk];
+    if (c.use_count() > 1) c = make_shared<Chunk>(*c);
+    return *c;
+}
+
+shared_ptr<const Order> OrderList::find(int orderID) const {
+    if (chunks.empty()) return nullptr;
+    const Chunk& chunk = *chunks[chunkFor(orderID)];
+    auto it = lower_bound(chunk.begin(), chunk.end(), orderID, lessByID);
+    if (it != chunk.end() && (*it)->orderID == orderID)
+        return *it;
+    return nullptr;
+}
+
+bool OrderList::insert(shared_ptr<const Order> order) {
+    int orderID = order->orderID;
+    if (chunks.empty()) {
+        chunks.push_back(make_shared<Chunk>());
+        chunks.back()->push_back(move(order));
+        count = 1;
+        return true;
+    }
+
+    size_t c = chunkFor(orderID);
+    const Chunk& shared = *chunks[c];
+    auto pos = lower_bound(shared.begin(), shared.end(), orderID, lessByID);
+    if (pos != shared.end() && (*pos)->orderID == orderID) return false;
+    size_t index = pos - shared.begin();
+
+    Chunk& chunk = own(c);
+    chunk.insert(chunk.begin() + index, move(order));
+    count++;
+    if (chunk.size() > 2 * ChunkSize) {
+        auto upper = make_shared<Chunk>(chunk.begin() + ChunkSize, chunk.end());
+        chunk.resize(ChunkSize);
+        chunks.insert(chunks.begin() + c + 1, move(upper));
+    }
+    return true;
+}
+
+bool OrderList::replace(shared_ptr<const Order> order) {
+    if (chunks.empty()) return false;
+    size_t c = chunkFor(order->orderID);
+    const Chunk& shared = *chunks[c];
+    auto pos = lower_bound(shared.begin(), shared.end(), order->orderID, lessByID);
+    if (pos == shared.end() || (*pos)->orderID != order->orderID) return false;
+    size_t index = pos - shared.begin();
+
+    own(c)[index] = move(order);
+    return true;
+}
+
+bool OrderList::erase(int orderID) {
+    if (chunks.empty()) return false;
+    size_t c = chunkFor(orderID);
+    const Chunk& shared = *chunks[c];
+    auto pos = lower_bound(shared.begin(), shared.end(), orderID, lessByID);
+    if (pos == shared.end() || (*pos)->orderID != orderID) return false;
+    size_t index = pos - shared.begin();
+
+    if (shared.size() == 1) {
+        chunks.erase(chunks.begin() + c);
+    } else {
+        Chunk& chunk = own(c);
+        chunk.erase(chunk.begin() + index);
+    }
+    count--;
+    return true;
+}
+
+void OrderList::insertSorted(vector<shared_ptr<const Order>> fresh) {
+    if (fresh.empty()) return;
+    size_t keep = chunks.empty() ? 0 : chunkFor(fresh.front()->orderID);
+    if (keep < chunks.size() && chunks[keep]->back()->orderID < fresh.front()->orderID) keep++;
+
+    // Merge the rest of the list with the new orders into fresh chunks
+    Chunk rest;
+    for (size_t c = keep; c < chunks.size(); c++) rest.insert(rest.end(), chunks[c]->begin(), chunks[c]->end());
+    Chunk merged;
+    merged.reserve(rest.size() + fresh.size());
+    merge(make_move_iterator(rest.begin()), make_move_iterator(rest.end()),
+          make_move_iterator(fresh.begin()), make_move_iterator(fresh.end()), back_inserter(merged),
+          [](const shared_ptr<const Order>& a, const shared_ptr<const Order>& b) {
+              return a->orderID < b->orderID;
+          });
+
+    count += fresh.size();
+    chunks.resize(keep);
+    for (size_t i = 0; i < merged.size(); i += ChunkSize) {
+        size_t end = min(merged.size(), i + ChunkSize);
+        chunks.push_back(make_shared<Chunk>(make_move_iterator(merged.begin() + i), make_move_iterator(merged.begin() + end)));
+    }
+}
+
+void OrderList::clear() {
+    chunks.clear();
+    count = 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "order.hpp"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+using namespace std;
+
+// Orders sorted by orderID, stored in chunks of a few hundred that copies of
+// the list share. Copying an OrderList copies only the chunk pointers; a write
+// then copies the one chunk it touches, or changes it in place when no other
+// copy holds it anymore. OrderManager publishes a copy per write, so a write
+// costs O(n / ChunkSize + ChunkSize) instead of O(n).
+class OrderList {
+public:
+    using Chunk = vector<shared_ptr<const Order>>;
+
+    class const_iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = shared_ptr<const Order>;
+        using difference_type = ptrdiff_t;
+        using pointer = const shared_ptr<const Order>*;
+        using reference = const shared_ptr<const Order>&;
+
+        const_iterator() = default;
+        reference operator*() const { return (*(*chunks)[chunk])[pos]; }
+        pointer operator->() const { return &**this; }
+        const_iterator& operator++() {
+            if (++pos == (*chunks)[chunk]->size()) {
+                chunk++;
+                pos = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const const_iterator& other) const { return chunk == other.chunk && pos == other.pos; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class OrderList;
+        const_iterator(const vector<shared_ptr<Chunk>>* chunks, size_t chunk, size_t pos)
+            : chunks(chunks), chunk(chunk), pos(pos) {}
+
+        const vector<shared_ptr<Chunk>>* chunks = nullptr;
+        size_t chunk = 0;
+        size_t pos = 0;
+    };
+
+    const_iterator begin() const { return const_iterator(&chunks, 0, 0); }
+    const_iterator end() const { return const_iterator(&chunks, chunks.size(), 0); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    // Order with the highest ID; the list must not be empty
+    const shared_ptr<const Order>& back() const { return chunks.back()->back(); }
+    shared_ptr<const Order> find(int orderID) const;
+
+    // Writers. insert() and replace() return false if the order's ID is
+    // already taken or not there, respectively.
+    bool insert(shared_ptr<const Order> order);
+    bool replace(shared_ptr<const Order> order);
+    bool erase(int orderID);
+    // Inserts orders sorted by ID, none of them in the list yet. Chunks
+    // before the first new ID stay shared.
+    void insertSorted(vector<shared_ptr<const Order>> fresh);
+    void clear();
+
+private:
+    static const size_t ChunkSize = 512;
+
+    vector<shared_ptr<Chunk>> chunks;   // none empty, none over 2 * ChunkSize
+    size_t count = 0;
+
+    size_t chunkFor(int orderID) const;
+    Chunk& own(size_t chunk);
+};
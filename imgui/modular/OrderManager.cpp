@@ -1,44 +1,397 @@
 #include "OrderManager.hpp"
 #include <iostream>
 #include <algorithm>
+#include <mutex>
 
-void OrderManager::addOrder(const Order& order) {
-    orders.push_back(order);
+shared_ptr<const Order> OrderSnapshot::find(int orderID) const {
+    return orders.find(orderID);
 }
 
-Order* OrderManager::findOrder(int OrderId) {
-    for (auto &o : orders) {
-        if (o.orderID == OrderId)
-            return &o;
+bool OrderManager::isOpen(const Order& order) {
+    return order.status == OrderStatus::Pending || order.status == OrderStatus::InProgress;
+}
+
+// Copies the current order list and counters into a new immutable snapshot,
+// which shares everything but the chunk and shard pointers with the last one,
+// then announces the writes since the last publish on the change feed, so a
+// reader that sees an event always finds it in snapshot(). Must be called
+// with writeMutex held, once per batch of *Locked writes.
+void OrderManager::publish() {
+    auto next = make_shared<OrderSnapshot>();
+    next->version = version;
+    next->orders = orders;
+    next->stats = stats;
+    atomic_store(&published, shared_ptr<const OrderSnapshot>(move(next)));
+
+    for (const auto& event : pendingEvents) {
+        feed.publish(event.type, event.orderID, event.customerID, event.version);
+    }
+    pendingEvents.clear();
+}
+
+shared_ptr<const OrderSnapshot> OrderManager::snapshot() const {
+    return atomic_load(&published);
+}
+
+const ChangeFeed& OrderManager::changes() const {
+    return feed;
+}
+
+// The *Locked helpers apply one write to the store and the indexes and queue
+// its change events. Callers hold writeMutex and publish() afterwards.
+void OrderManager::insertLocked(const Order& order, bool keepVersion) {
+    auto stored = make_shared<Order>(order);
+    if (!keepVersion) stored->version = ++version;
+    orders.insert(stored);
+    stats.add(order);
+    searchIndex.addOrder(order);
+    if (isOpen(order)) {
+        deadlines.insert(order.orderID, order.deadline);
+    }
+    pendingEvents.push_back({ 0, OrderEventType::Created, order.orderID, order.customerID, stored->version });
+}
+
+// Copy-on-write: the old Order stays valid for readers of older snapshots
+// before must stay alive until this returns
+void OrderManager::replaceLocked(const Order& before, Order after, bool keepVersion) {
+    int orderID = before.orderID;
+    if (!keepVersion) after.version = ++version;
+
+    stats.remove(before);
+    stats.add(after);
+    if (after.orderName != before.orderName || after.reference != before.reference || after.extras != before.extras) {
+        searchIndex.updateOrder(after);
+    }
+    if (isOpen(after)) {
+        deadlines.update(orderID, after.deadline);
+    } else {
+        deadlines.remove(orderID);
+    }
+
+    bool statusChanged = after.status != before.status;
+    bool editorChanged = after.editorAssigned != before.editorAssigned;
+    bool fieldsChanged = after.orderName != before.orderName || after.orderKind != before.orderKind ||
+                         after.deadline != before.deadline || after.reference != before.reference ||
+                         after.extras != before.extras || after.finalLink != before.finalLink ||
+                         after.customerID != before.customerID;
+    int customerID = after.customerID;
+    uint64_t newVersion = after.version;
+
+    orders.replace(make_shared<const Order>(move(after)));
+
+    if (fieldsChanged) pendingEvents.push_back({ 0, OrderEventType::Modified, orderID, customerID, newVersion });
+    if (statusChanged) pendingEvents.push_back({ 0, OrderEventType::StatusChanged, orderID, customerID, newVersion });
+    if (editorChanged) pendingEvents.push_back({ 0, OrderEventType::Assigned, orderID, customerID, newVersion });
+}
+
+void OrderManager::eraseLocked(const Order& order) {
+    int orderID = order.orderID;
+    int customerID = order.customerID;
+    stats.remove(order);
+    orders.erase(orderID);
+    deadlines.remove(orderID);
+    searchIndex.removeOrder(orderID);
+    ++version;
+    pendingEvents.push_back({ 0, OrderEventType::Deleted, orderID, customerID, 0 });
+}
+
+// Applies a recorded change if the order is still in the state it expects
+bool OrderManager::applyLocked(const OrderChange& change) {
+    shared_ptr<const Order> current = orders.find(change.orderID);
+    if (change.kind == OrderChange::Kind::Create) {
+        if (current) return false;
+        insertLocked(change.toOrder());
+        return true;
+    }
+
+    if (!current || !change.inverse().matches(*current)) return false;
+    if (change.kind == OrderChange::Kind::Delete) {
+        eraseLocked(*current);
+        return true;
+    }
+    Order after = *current;
+    if (!change.applyTo(after)) return false;
+    replaceLocked(*current, move(after));
+    return true;
+}
+
+bool OrderManager::addOrder(const Order& order) {
+    unique_lock<shared_mutex> lock(writeMutex);
+    if (orders.find(order.orderID)) return false;
+    insertLocked(order);
+    publish();
+    history.record(OrderChange::created(order));
+    return true;
+}
+
+int OrderManager::addNewOrder(Order order) {
+    unique_lock<shared_mutex> lock(writeMutex);
+    order.orderID = orders.empty() ? 1001 : orders.back()->orderID + 1;
+    insertLocked(order);
+    publish();
+    history.record(OrderChange::created(order));
+    return order.orderID;
+}
+
+size_t OrderManager::applyReplicated(const vector<ReplicatedOrder>& batch, bool overwrite) {
+    unique_lock<shared_mutex> lock(writeMutex);
+    size_t applied = 0;
+    for (const auto& row : batch) {
+        shared_ptr<const Order> current = orders.find(row.order.orderID);
+        if (row.removed) {
+            if (!current) continue;
+            eraseLocked(*current);
+        } else {
+            if (current && !overwrite && current->version >= row.order.version) continue;
+            // Local versions must stay ahead of every replicated one, in case
+            // this replica is later promoted and starts taking writes itself
+            version = max(version, row.order.version);
+            if (!current) {
+                insertLocked(row.order, true);
+            } else {
+                replaceLocked(*current, row.order, true);
+            }
+        }
+        applied++;
+    }
+    // One snapshot for the whole batch instead of one per row
+    if (applied > 0) publish();
+    return applied;
+}
+
+size_t OrderManager::addOrders(const vector<Order>& batch, vector<size_t>& rejected) {
+    // Sort positions by ID, first occurrence first, so repeats are adjacent
+    vector<size_t> byID(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) byID[i] = i;
+    stable_sort(byID.begin(), byID.end(), [&batch](size_t a, size_t b) {
+        return batch[a].orderID < batch[b].orderID;
+    });
+
+    unique_lock<shared_mutex> lock(writeMutex);
+    vector<shared_ptr<const Order>> fresh;
+    fresh.reserve(batch.size());
+    vector<const Order*> indexed;
+    indexed.reserve(batch.size());
+    vector<pair<chrono::system_clock::time_point, int>> open;
+    for (size_t k = 0; k < byID.size(); ++k) {
+        const Order& order = batch[byID[k]];
+        bool repeated = k > 0 && batch[byID[k - 1]].orderID == order.orderID;
+        if (repeated || orders.find(order.orderID)) {
+            rejected.push_back(byID[k]);
+            continue;
+        }
+        auto stored = make_shared<Order>(order);
+        stored->version = ++version;
+        stats.add(order);
+        if (isOpen(order)) open.emplace_back(order.deadline, order.orderID);
+        indexed.push_back(&order);
+        pendingEvents.push_back({ 0, OrderEventType::Created, order.orderID, order.customerID, stored->version });
+        fresh.push_back(move(stored));
+    }
+    if (fresh.empty()) return 0;
+    searchIndex.addOrders(indexed);
+    deadlines.insertAll(move(open));
+
+    // One linear merge instead of an insert per order
+    size_t added = fresh.size();
+    orders.insertSorted(move(fresh));
+    publish();
+    return added;
+}
+
+shared_ptr<const Order> OrderManager::findOrder(int OrderId) const {
+    return snapshot()->find(OrderId);
+}
+
+// The new record and its diff are built from the published snapshot before
+// taking the lock, which is then held only to check that the order is still
+// the one they were built from and to publish. If another write got in
+// between, the record is built again from the newer order.
+UpdateResult OrderManager::updateOrder(int orderID, uint64_t expectedVersion, const function<void(Order&)>& change) {
+    for (;;) {
+        shared_ptr<const Order> base = snapshot()->find(orderID);
+        if (!base) return UpdateResult::NotFound;
+        if (expectedVersion != AnyVersion && base->version != expectedVersion) {
+            return UpdateResult::Conflict;
+        }
+        Order after = *base;
+        change(after);
+
+        OrderChange delta = OrderChange::diff(*base, after);
+        // Nothing changed: keep the version, so no one sees a conflict or an
+        // update that carries no change
+        if (delta.fields.empty()) return UpdateResult::Ok;
+
+        unique_lock<shared_mutex> lock(writeMutex);
+        // Writers publish before unlocking, so the next snapshot has the newer order
+        if (orders.find(orderID) != base) continue;
+        replaceLocked(*base, move(after));
+        publish();
+        history.record(move(delta));
+        return UpdateResult::Ok;
     }
-    return nullptr;
+}
+
+UpdateResult OrderManager::modifyOrder(int orderID,
+                                       const string& newName,
+                                       OrderKind newKind,
+                                       const chrono::system_clock::time_point& newDeadline,
+                                       const string& reference,
+                                       const string& extras,
+                                       uint64_t expectedVersion) {
+    return updateOrder(orderID, expectedVersion, [&](Order& order) {
+        order.orderName = newName;
+        order.orderKind = newKind;
+        order.deadline = newDeadline;
+        order.reference = reference;
+        order.extras = extras;
+    });
+}
+
+UpdateResult OrderManager::updateStatus(int orderID, OrderStatus newStatus, uint64_t expectedVersion) {
+    return updateOrder(orderID, expectedVersion, [&](Order& order) {
+        order.updateStatus(newStatus);
+    });
+}
+
+UpdateResult OrderManager::updateProgress(int orderID, OrderStatus newStatus, const string& finalLink, uint64_t expectedVersion) {
+    return updateOrder(orderID, expectedVersion, [&](Order& order) {
+        order.updateStatus(newStatus);
+        order.finalLink = finalLink;
+    });
+}
+
+UpdateResult OrderManager::assignEditor(int orderID, const string& editorName, uint64_t expectedVersion) {
+    return updateOrder(orderID, expectedVersion, [&](Order& order) {
+        order.assignEditor(editorName);
+    });
+}
+
+UpdateResult OrderManager::unassignEditor(int orderID, uint64_t expectedVersion) {
+    return updateOrder(orderID, expectedVersion, [](Order& order) {
+        order.unassignEditor();
+    });
+}
+
+UpdateResult OrderManager::attachLink(int orderID, const string& link, uint64_t expectedVersion) {
+    return updateOrder(orderID, expectedVersion, [&](Order& order) {
+        order.attachLink(link);
+    });
+}
+
+UpdateResult OrderManager::setFinalLink(int orderID, const string& link, uint64_t expectedVersion) {
+    return updateOrder(orderID, expectedVersion, [&](Order& order) {
+        order.finalLink = link;
+    });
 }
 
 void OrderManager::listOrders() const {
-    std::cout << "Orders (count=" << orders.size() << "):\n";
-    for (const auto &o : orders) {
-        std::cout << " - [" << o.orderID << "] " << o.orderName << "\n";
+    auto view = snapshot();
+    std::cout << "Orders (count=" << view->orders.size() << "):\n";
+    for (const auto &o : view->orders) {
+        std::cout << " - [" << o->orderID << "] " << o->orderName << "\n";
     }
 }
 
 void OrderManager::displayOrders() const {
-    for (const auto &o : orders) {
-        o.displayOrder();
+    auto view = snapshot();
+    for (const auto &o : view->orders) {
+        o->displayOrder();
     }
 }
 
 void OrderManager::deleteOrder(int OrderId) {
-    auto oldSize = orders.size();
-    orders.erase(std::remove_if(orders.begin(), orders.end(), [OrderId](const Order &o) {
-        return o.orderID == OrderId;
-    }), orders.end());
-    if (orders.size() < oldSize) {
+    unique_lock<shared_mutex> lock(writeMutex);
+    shared_ptr<const Order> current = orders.find(OrderId);
+    if (current) {
+        history.record(OrderChange::deleted(*current));
+        eraseLocked(*current);
+        publish();
         std::cout << "Order " << OrderId << " removed.\n";
     } else {
         std::cout << "Order " << OrderId << " not found.\n";
     }
 }
 
-const std::vector<Order>& OrderManager::getOrders() const {
-    return orders;
+bool OrderManager::undo() {
+    unique_lock<shared_mutex> lock(writeMutex);
+    if (!history.canUndo()) return false;
+    if (!applyLocked(history.nextUndo().inverse())) {
+        history.dropUndo();
+        return false;
+    }
+    publish();
+    history.markUndone();
+    return true;
+}
+
+bool OrderManager::redo() {
+    unique_lock<shared_mutex> lock(writeMutex);
+    if (!history.canRedo()) return false;
+    if (!applyLocked(history.nextRedo())) {
+        history.dropRedo();
+        return false;
+    }
+    publish();
+    history.markRedone();
+    return true;
+}
+
+bool OrderManager::canUndo() const {
+    shared_lock<shared_mutex> lock(writeMutex);
+    return history.canUndo();
+}
+
+bool OrderManager::canRedo() const {
+    shared_lock<shared_mutex> lock(writeMutex);
+    return history.canRedo();
+}
+
+void OrderManager::clearHistory() {
+    unique_lock<shared_mutex> lock(writeMutex);
+    history.clear();
+}
+
+vector<int> OrderManager::nextDue(size_t n, const chrono::system_clock::time_point& now) const {
+    shared_lock<shared_mutex> lock(writeMutex);
+    return deadlines.nextDue(n, now);
+}
+
+vector<int> OrderManager::overdueOrders(const chrono::system_clock::time_point& now) const {
+    shared_lock<shared_mutex> lock(writeMutex);
+    return deadlines.overdue(now);
+}
+
+vector<int> OrderManager::dueWithin(const chrono::system_clock::time_point& now, int days) const {
+    shared_lock<shared_mutex> lock(writeMutex);
+    return deadlines.dueWithin(now, days);
+}
+
+size_t OrderManager::countOverdue(const chrono::system_clock::time_point& now) const {
+    shared_lock<shared_mutex> lock(writeMutex);
+    return deadlines.countOverdue(now);
+}
+
+size_t OrderManager::countDueWithin(const chrono::system_clock::time_point& now, int days) const {
+    shared_lock<shared_mutex> lock(writeMutex);
+    return deadlines.countDueWithin(now, days);
+}
+
+void OrderManager::pollOverdue(const chrono::system_clock::time_point& now, const function<void(int)>& onOverdue) {
+    vector<int> fired;
+    {
+        unique_lock<shared_mutex> lock(writeMutex);
+        deadlines.pollOverdue(now, [&fired](int orderID) { fired.push_back(orderID); });
+    }
+    for (int orderID : fired) onOverdue(orderID);
+}
+
+void OrderManager::markOverdueReported(const chrono::system_clock::time_point& now) {
+    unique_lock<shared_mutex> lock(writeMutex);
+    deadlines.markReported(now);
+}
+
+vector<SearchIndex::Result> OrderManager::searchOrders(const string& query, size_t maxResults) const {
+    shared_lock<shared_mutex> lock(writeMutex);
+    return searchIndex.search(query, maxResults);
 }
@@ -1,19 +1,128 @@
 #pragma once
 #include "order.hpp"
+#include "OrderList.hpp"
+#include "DeadlineIndex.hpp"
+#include "SearchIndex.hpp"
+#include "OrderStats.hpp"
+#include "ChangeFeed.hpp"
+#include "OrderHistory.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 using namespace std;
 
+enum class UpdateResult {
+    Ok,
+    NotFound,
+    Conflict,   // the order was written after the caller read expectedVersion
+};
+
+// Immutable view of all orders, published by OrderManager after every write.
+// Readers keep it alive for as long as they hold the pointer. Consecutive
+// snapshots share all order chunks and stats shards a write did not touch.
+struct OrderSnapshot {
+    uint64_t version = 0;   // commit timestamp this view reflects
+    OrderList orders;       // sorted by orderID
+    OrderStats stats;
+
+    shared_ptr<const Order> find(int orderID) const;
+};
+
+// One row of a primary's replication stream: an order's latest state, or
+// its removal (only order.orderID is used then)
+struct ReplicatedOrder {
+    bool removed;
+    Order order;
+};
+
+// Writers are serialized on an internal lock. Readers take snapshot() without
+// locking and never observe a half-applied write.
+// Updates are optimistic: pass the Order::version the edit was based on and
+// the write is rejected with UpdateResult::Conflict if someone got there first.
 class OrderManager {
 private:
-    vector<Order> orders;
+    OrderList orders;
+    DeadlineIndex deadlines;
+    SearchIndex searchIndex;
+    OrderStats stats;
+    ChangeFeed feed;
+    OrderHistory history;
+    uint64_t version = 0;
+    vector<OrderEvent> pendingEvents;
+
+    mutable shared_mutex writeMutex;
+    shared_ptr<const OrderSnapshot> published = make_shared<const OrderSnapshot>();
+
+    static bool isOpen(const Order& order);
+    UpdateResult updateOrder(int orderID, uint64_t expectedVersion, const function<void(Order&)>& change);
+    void insertLocked(const Order& order, bool keepVersion = false);
+    void replaceLocked(const Order& before, Order after, bool keepVersion = false);
+    void eraseLocked(const Order& order);
+    bool applyLocked(const OrderChange& change);
+    void publish();
 
 public:
-    void addOrder(const Order& order);
+    static const uint64_t AnyVersion = 0;
+
+    // Returns false, changing nothing, if the order's ID is already taken
+    bool addOrder(const Order& order);
+    // Assigns the next free order ID (after the highest one in use) and returns it
+    int addNewOrder(Order order);
     void deleteOrder(int orderID);
-    Order* findOrder(int OrderId);
+    // Mirrors a primary's rows on a read replica, in order: each order is
+    // stored as given, keeping its version, unless an equal or newer version
+    // is already held. With overwrite, as for a snapshot, every row is
+    // stored regardless of versions. Not recorded in the undo history.
+    // Returns the number of rows that changed anything.
+    size_t applyReplicated(const vector<ReplicatedOrder>& batch, bool overwrite = false);
+    // Bulk insert for imports: the order list, search and deadline indexes
+    // are each updated and the snapshot published once for the whole batch
+    // instead of once per order. Orders
+    // whose ID is already taken, or repeated in the batch, are skipped and
+    // their positions in batch appended to rejected. Not recorded in the
+    // undo history. Returns the number inserted.
+    size_t addOrders(const vector<Order>& batch, vector<size_t>& rejected);
+    shared_ptr<const Order> findOrder(int OrderId) const;
+    UpdateResult modifyOrder(int orderID,
+        const string& newName,
+        OrderKind newKind,
+        const chrono::system_clock::time_point& newDeadline,
+        const string& reference,
+        const string& extras,
+        uint64_t expectedVersion = AnyVersion);
+    UpdateResult updateStatus(int orderID, OrderStatus newStatus, uint64_t expectedVersion = AnyVersion);
+    UpdateResult updateProgress(int orderID, OrderStatus newStatus, const string& finalLink, uint64_t expectedVersion = AnyVersion);
+    UpdateResult assignEditor(int orderID, const string& editorName, uint64_t expectedVersion = AnyVersion);
+    UpdateResult unassignEditor(int orderID, uint64_t expectedVersion = AnyVersion);
+    UpdateResult attachLink(int orderID, const string& link, uint64_t expectedVersion = AnyVersion);
+    UpdateResult setFinalLink(int orderID, const string& link, uint64_t expectedVersion = AnyVersion);
     void listOrders() const;
     void displayOrders() const;
-    const std::vector<Order>& getOrders() const;
 
-};
\ No newline at end of file
+    // Consistent, lock-free view of every order and the aggregate counters
+    shared_ptr<const OrderSnapshot> snapshot() const;
+    // Events for every write, published after the matching snapshot
+    const ChangeFeed& changes() const;
+
+    // Every write is recorded as a field-level delta. Undo/redo refuse to
+    // run when the order was changed again in the meantime.
+    bool undo();
+    bool redo();
+    bool canUndo() const;
+    bool canRedo() const;
+    void clearHistory();
+
+    vector<int> nextDue(size_t n, const chrono::system_clock::time_point& now) const;
+    vector<int> overdueOrders(const chrono::system_clock::time_point& now) const;
+    vector<int> dueWithin(const chrono::system_clock::time_point& now, int days) const;
+    size_t countOverdue(const chrono::system_clock::time_point& now) const;
+    size_t countDueWithin(const chrono::system_clock::time_point& now, int days) const;
+    void pollOverdue(const chrono::system_clock::time_point& now, const function<void(int)>& onOverdue);
+    // Orders already overdue at now are not reported by later polls
+    void markOverdueReported(const chrono::system_clock::time_point& now);
+    vector<SearchIndex::Result> searchOrders(const string& query, size_t maxResults = 100) const;
+
+};
@@ -0,0 +1,307 @@
+#include "OrderServer.hpp"
+#include "NetCompat.hpp"
+#include <iostream>
+#include <vector>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+static const int PollTimeoutMs = 100;
+
+OrderServer::OrderServer(OrderService& service) : service(service) {}
+
+OrderServer::~OrderServer() {
+    for (auto& entry : connections) netClose((socket_t)entry.first);
+    connections.clear();
+    if (listenSocket != -1) netClose((socket_t)listenSocket);
+#ifdef __linux__
+    if (pollHandle != -1) close(pollHandle);
+#endif
+}
+
+bool OrderServer::start(uint16_t requestedPort) {
+    if (!netStartup()) {
+        cerr << "Error: Could not initialise sockets" << endl;
+        return false;
+    }
+
+    socket_t s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s == NET_INVALID_SOCKET) {
+        cerr << "Error: Could not create listen socket" << endl;
+        return false;
+    }
+    int on = 1;
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&on, sizeof(on));
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(requestedPort);
+    if (bind(s, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(s, SOMAXCONN) != 0 || !netSetNonBlocking(s)) {
+        cerr << "Error: Could not listen on 127.0.0.1:" << requestedPort << endl;
+        netClose(s);
+        return false;
+    }
+
+    socklen_t len = sizeof(addr);
+    getsockname(s, (sockaddr*)&addr, &len);
+    port = ntohs(addr.sin_port);
+    listenSocket = (intptr_t)s;
+
+#ifdef __linux__
+    pollHandle = epoll_create1(0);
+    if (pollHandle == -1) {
+        cerr << "Error: epoll_create1 failed" << endl;
+        return false;
+    }
+    watch(listenSocket, true, false, false);
+#endif
+    running = true;
+    return true;
+}
+
+void OrderServer::stop() {
+    running = false;
+}
+
+uint16_t OrderServer::getPort() const {
+    return port;
+}
+
+uint64_t OrderServer::requestsServed() const {
+    return served.load(memory_order_relaxed);
+}
+
+void OrderServer::watch(intptr_t socket, bool wantRead, bool wantWrite, bool added) {
+#ifdef __linux__
+    epoll_event ev = {};
+    ev.events = (wantRead ? (uint32_t)EPOLLIN : 0u) | (wantWrite ? (uint32_t)EPOLLOUT : 0u);
+    ev.data.fd = (int)socket;
+    epoll_ctl(pollHandle, added ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, (int)socket, &ev);
+#else
+    // poll() rebuilds its descriptor set from connections every iteration
+    (void)socket; (void)wantRead; (void)wantWrite; (void)added;
+#endif
+}
+
+void OrderServer::acceptClients() {
+    for (;;) {
+        socket_t client = accept((socket_t)listenSocket, nullptr, nullptr);
+        if (client == NET_INVALID_SOCKET) return;
+        if (!netSetNonBlocking(client)) {
+            netClose(client);
+            continue;
+        }
+        int on = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, (const char*)&on, sizeof(on));
+        connections[(intptr_t)client];
+        watch((intptr_t)client, true, false, false);
+    }
+}
+
+bool OrderServer::readClient(intptr_t socket, Connection& conn) {
+    char buffer[16 * 1024];
+    while (wantsInput(conn)) {
+        int n = (int)recv((socket_t)socket, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            conn.in.append(buffer, n);
+            continue;
+        }
+        if (n == 0) {
+            // Peer finished sending; answer what arrived, then close
+            conn.closing = true;
+            break;
+        }
+        if (netWouldBlock(netLastError())) break;
+        return false;
+    }
+
+    processLines(conn);
+    return true;
+}
+
+void OrderServer::processLines(Connection& conn) {
+    size_t start = 0;
+    size_t end;
+    while (!conn.deferred.valid() && (end = conn.in.find('\n', start)) != string::npos) {
+        size_t lineEnd = (end > start && conn.in[end - 1] == '\r') ? end - 1 : end;
+        if (lineEnd > start) {
+            string request = conn.in.substr(start, lineEnd - start);
+            if (request.compare(0, 9, "SUBSCRIBE") == 0) {
+                service.subscribe(request, conn.subscription, conn.out);
+                conn.subscriptionBehind = false;
+            } else if (request.compare(0, 9, "REPLICATE") == 0) {
+                service.replicate(request, conn.sessionToken, conn.replica, conn.out);
+            } else if (service.isDeferred(request)) {
+                conn.deferred = service.startDeferred(request);
+                ++deferredCount;
+            } else {
+                service.handle(request, conn.out, conn.sessionToken);
+            }
+            served.fetch_add(1, memory_order_relaxed);
+        }
+        start = end + 1;
+    }
+    conn.in.erase(0, start);
+
+    if (conn.in.size() > MaxLineLength && conn.in.find('\n') == string::npos) {
+        conn.out += "ERR,TOOLONG\n";
+        conn.in.clear();
+        conn.closing = true;
+    }
+}
+
+void OrderServer::finishDeferred() {
+    if (deferredCount == 0) return;
+    vector<intptr_t> dropped;
+    for (auto& entry : connections) {
+        Connection& conn = entry.second;
+        if (!conn.deferred.valid()) continue;
+        if (conn.deferred.wait_for(chrono::seconds(0)) != future_status::ready) continue;
+        DeferredReply reply = conn.deferred.get();
+        --deferredCount;
+        conn.out += reply.response;
+        if (reply.bindsSession) conn.sessionToken = reply.sessionToken;
+        processLines(conn);
+        if (!settle(entry.first, conn)) dropped.push_back(entry.first);
+    }
+    for (intptr_t socket : dropped) closeClient(socket);
+}
+
+int OrderServer::pollTimeout() const {
+    return deferredCount > 0 ? 1 : PollTimeoutMs;
+}
+
+bool OrderServer::flushClient(intptr_t socket, Connection& conn) {
+    while (conn.outOffset < conn.out.size()) {
+        int n = (int)send((socket_t)socket, conn.out.data() + conn.outOffset,
+                          (int)(conn.out.size() - conn.outOffset), MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.outOffset += n;
+            continue;
+        }
+        if (n < 0 && netWouldBlock(netLastError())) return true;
+        return false;
+    }
+    conn.out.clear();
+    conn.outOffset = 0;
+    // A half-closed client still gets the reply it is waiting on
+    return !conn.closing || conn.deferred.valid();
+}
+
+bool OrderServer::wantsInput(const Connection& conn) {
+    return !conn.closing && !(conn.deferred.valid() && conn.in.size() >= MaxParkedInput);
+}
+
+bool OrderServer::settle(intptr_t socket, Connection& conn) {
+    if (!flushClient(socket, conn)) return false;
+    // Ask for EPOLLOUT only while a response is stuck in the buffer
+    bool wantRead = wantsInput(conn);
+    bool wantWrite = !conn.out.empty();
+    if (wantRead != conn.readArmed || wantWrite != conn.writeArmed) {
+        watch(socket, wantRead, wantWrite, true);
+        conn.readArmed = wantRead;
+        conn.writeArmed = wantWrite;
+    }
+    return true;
+}
+
+void OrderServer::pushChanges() {
+    bool changed = service.pollChanges(changedIDs, resync);
+    shared_ptr<const OrderSnapshot> view;
+
+    auto now = chrono::steady_clock::now();
+    bool heartbeat = now - lastHeartbeat >= chrono::milliseconds(HeartbeatMs);
+    if (heartbeat) {
+        lastHeartbeat = now;
+        service.expireSessions();
+    }
+
+    vector<intptr_t> dropped;
+    for (auto& entry : connections) {
+        Connection& conn = entry.second;
+        if (!conn.subscription.active() && !conn.replica.active) continue;
+        // Stalled readers are brought up to date once they drain instead of
+        // having every change buffered for them
+        if (conn.out.size() - conn.outOffset > MaxPendingOutput) {
+            if (changed && conn.subscription.active()) conn.subscriptionBehind = true;
+            continue;
+        }
+        // One coalesced DELTA per subscriber, sent with a single write
+        if ((changed || conn.subscriptionBehind) && conn.subscription.active()) {
+            if (!view) view = service.snapshot();
+            service.writeDelta(conn.subscription, *view, changedIDs, resync || conn.subscriptionBehind, conn.out);
+            conn.subscriptionBehind = false;
+        }
+        if (conn.replica.active) {
+            service.writeLog(conn.replica, conn.out);
+            if (heartbeat) service.writeHeartbeat(conn.out);
+        }
+        if (!conn.out.empty() && !settle(entry.first, conn)) dropped.push_back(entry.first);
+    }
+    for (intptr_t socket : dropped) closeClient(socket);
+}
+
+void OrderServer::closeClient(intptr_t socket) {
+    // Closing the descriptor also removes it from the epoll set
+    netClose((socket_t)socket);
+    auto it = connections.find(socket);
+    if (it == connections.end()) return;
+    // Destroying a pending future does not block; the pool finishes the
+    // work and the reply is dropped
+    if (it->second.deferred.valid()) --deferredCount;
+    connections.erase(it);
+}
+
+void OrderServer::run() {
+#ifdef __linux__
+    vector<epoll_event> events(256);
+    while (running) {
+        int n = epoll_wait(pollHandle, events.data(), (int)events.size(), pollTimeout());
+        for (int i = 0; i < n; ++i) {
+            intptr_t socket = events[i].data.fd;
+            if (socket == listenSocket) {
+                acceptClients();
+                continue;
+            }
+            auto it = connections.find(socket);
+            if (it == connections.end()) continue;
+            Connection& conn = it->second;
+
+            bool alive = true;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) alive = readClient(socket, conn);
+            if (!alive || !settle(socket, conn)) closeClient(socket);
+        }
+        finishDeferred();
+        pushChanges();
+    }
+#else
+    vector<pollfd> fds;
+    while (running) {
+        fds.clear();
+        fds.push_back({ (socket_t)listenSocket, POLLIN, 0 });
+        for (auto& entry : connections) {
+            short events = (wantsInput(entry.second) ? POLLIN : 0) | (entry.second.out.empty() ? 0 : POLLOUT);
+            fds.push_back({ (socket_t)entry.first, events, 0 });
+        }
+        int n = pollSockets(fds.data(), (unsigned long)fds.size(), pollTimeout());
+        if (n <= 0) {
+            finishDeferred();
+            pushChanges();
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN) acceptClients();
+        for (size_t i = 1; i < fds.size(); ++i) {
+            if (!fds[i].revents) continue;
+            intptr_t socket = (intptr_t)fds[i].fd;
+            Connection& conn = connections[socket];
+            bool alive = true;
+            if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) alive = readClient(socket, conn);
+            if (!alive || !settle(socket, conn)) closeClient(socket);
+        }
+        finishDeferred();
+        pushChanges();
+    }
+#endif
+}
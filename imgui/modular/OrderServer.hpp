@@ -0,0 +1,93 @@
+#pragma once
+#include "OrderService.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Single-threaded non-blocking TCP front end for OrderService, bound to
+// 127.0.0.1. Uses epoll on Linux and poll()/WSAPoll() elsewhere. Each
+// readiness event drains the socket, answers every complete line in the
+// input buffer and flushes all responses with one send, so pipelined
+// clients pay one syscall per batch rather than one per request. After every
+// pass the change feed is drained and subscribers get their deltas at once;
+// replicas get new log entries, plus a heartbeat every HeartbeatMs.
+// Password checks run on the service's verifier pool; a connection waiting on
+// one is parked, and its later requests are answered once the reply is in.
+class OrderServer {
+public:
+    // Requests longer than this are answered with ERR,TOOLONG and the
+    // connection is closed
+    static constexpr size_t MaxLineLength = 64 * 1024;
+    // A parked connection stops being read once this much input is queued
+    // behind it, and resumes when its deferred reply is in
+    static constexpr size_t MaxParkedInput = 4 * MaxLineLength;
+    // A subscriber or replica with more unsent output than this is skipped
+    // by pushChanges until it reads it. A replica then resumes from its log
+    // position, or a snapshot once the log moved past it; a subscriber gets
+    // a full resync instead of the DELTAs it missed.
+    static constexpr size_t MaxPendingOutput = 8 * 1024 * 1024;
+    static const int HeartbeatMs = 100;
+
+    explicit OrderServer(OrderService& service);
+    ~OrderServer();
+
+    bool start(uint16_t port);
+    // Blocks until stop() is called from another thread or a signal handler
+    void run();
+    void stop();
+
+    uint16_t getPort() const;
+    uint64_t requestsServed() const;
+
+private:
+    struct Connection {
+        string in;
+        string out;
+        size_t outOffset = 0;
+        bool closing = false;
+        bool readArmed = true;
+        bool writeArmed = false;
+        Subscription subscription;
+        bool subscriptionBehind = false;    // missed DELTAs while over MaxPendingOutput
+        ReplicaStream replica;
+        string sessionToken;
+        future<DeferredReply> deferred;
+    };
+
+    OrderService& service;
+    intptr_t listenSocket = -1;
+    int pollHandle = -1;
+    uint16_t port = 0;
+    atomic<bool> running{ false };
+    atomic<uint64_t> served{ 0 };
+    unordered_map<intptr_t, Connection> connections;
+    vector<int> changedIDs;
+    bool resync = false;
+    size_t deferredCount = 0;
+    chrono::steady_clock::time_point lastHeartbeat;
+
+    void acceptClients();
+    // Returns false when the connection should be dropped
+    bool readClient(intptr_t socket, Connection& conn);
+    // Answers complete lines until the input runs out or one is deferred
+    void processLines(Connection& conn);
+    // Delivers deferred replies that have finished and resumes those connections
+    void finishDeferred();
+    // Short while deferred replies are outstanding, so they go out promptly
+    int pollTimeout() const;
+    bool flushClient(intptr_t socket, Connection& conn);
+    // Read interest: none once the peer finished sending, or while parked
+    // with MaxParkedInput queued, so level-triggered polling does not spin
+    static bool wantsInput(const Connection& conn);
+    // Flushes output and keeps read and write interest in step; false drops the connection
+    bool settle(intptr_t socket, Connection& conn);
+    // Fans changes since the last call out to subscribers and replicas
+    void pushChanges();
+    void watch(intptr_t socket, bool wantRead, bool wantWrite, bool added);
+    void closeClient(intptr_t socket);
+};
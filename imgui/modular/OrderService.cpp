@@ -0,0 +1,431 @@
+#include "OrderService.hpp"
+#include "SaveManager.hpp"
+#include "PasswordHash.hpp"
+#include <algorithm>
+
+OrderService::OrderService(OrderManager& manager, UserManager& userManager)
+    : manager(manager), userManager(userManager), feedCursor(manager.changes().subscribe()),
+      usersLogged(userManager.getAllUsers().size()) {}
+
+bool Subscription::matches(const Order& order) const {
+    switch (filter) {
+        case Filter::All: return true;
+        case Filter::Customer: return order.customerID == customerID;
+        case Filter::Editor: return order.editorAssigned == editor;
+        default: return false;
+    }
+}
+
+static bool needsSession(const string& command) {
+    return command == "ADD" || command == "MODIFY" || command == "STATUS" || command == "ASSIGN" ||
+           command == "UNASSIGN" || command == "LINK" || command == "DELETE";
+}
+
+static bool isWrite(const string& command) {
+    return command == "REGISTER" || command == "ADD" || command == "MODIFY" || command == "STATUS" ||
+           command == "ASSIGN" || command == "UNASSIGN" || command == "LINK" || command == "DELETE";
+}
+
+string OrderService::orderRow(const Order& order) {
+    return SaveManager::orderToCSV(order) + "," + to_string(order.version) + "\n";
+}
+
+void OrderService::writeResult(UpdateResult result, int orderID, string& out) {
+    switch (result) {
+        case UpdateResult::Ok: {
+            auto order = manager.findOrder(orderID);
+            out += "OK," + to_string(order ? order->version : 0) + "\n";
+            break;
+        }
+        case UpdateResult::NotFound: out += "ERR,NOTFOUND\n"; break;
+        case UpdateResult::Conflict: out += "ERR,CONFLICT\n"; break;
+    }
+}
+
+static uint64_t optionalVersion(const vector<string>& fields, size_t index) {
+    if (fields.size() <= index || fields[index].empty()) return OrderManager::AnyVersion;
+    return stoull(fields[index]);
+}
+
+void OrderService::handle(const string& request, string& out, string& sessionToken) {
+    vector<string> fields = SaveManager::parseCSVLine(request);
+    const string& command = fields[0];
+    if (readOnly && isWrite(command)) {
+        out += "ERR,READONLY\n";
+        return;
+    }
+    SessionManager::Session session;
+    if ((needsSession(command) || command == "REVOKE") && !sessions.validate(sessionToken, session)) {
+        out += "ERR,AUTH\n";
+        return;
+    }
+
+    try {
+        // Customers may only change their own orders, editors any order
+        if (needsSession(command) && command != "ADD" && fields.size() >= 2 && session.role != user::Role::Editor) {
+            auto order = manager.findOrder(stoi(fields[1]));
+            if (order && order->customerID != session.userID) {
+                out += "ERR,AUTH\n";
+                return;
+            }
+        }
+
+        if (command == "PING") {
+            out += "OK,PONG\n";
+        }
+        else if (command == "REGISTER" && fields.size() >= 4) {
+            user::Role role = (fields[3] == "Editor") ? user::Role::Editor : user::Role::Customer;
+            if (!userManager.registerUser(fields[1], fields[2], role)) {
+                out += "ERR,EXISTS\n";
+                return;
+            }
+            user* u = userManager.getUserByUsername(fields[1]);
+            out += "OK," + to_string(u ? u->getUserID() : 0) + "\n";
+        }
+        else if (command == "LOGIN" && fields.size() >= 3) {
+            user* u = userManager.loginUser(fields[1], fields[2]);
+            if (!u) {
+                out += "ERR,DENIED\n";
+                return;
+            }
+            sessionToken = sessions.open(*u);
+            out += "OK," + to_string(u->getUserID()) + "," + user::roleToString(u->getRole()) + "," + sessionToken + "\n";
+        }
+        else if (command == "AUTH" && fields.size() >= 2) {
+            if (!sessions.validate(fields[1], session)) {
+                out += "ERR,AUTH\n";
+                return;
+            }
+            sessionToken = fields[1];
+            out += "OK," + to_string(session.userID) + "," + user::roleToString(session.role) + "\n";
+        }
+        else if (command == "LOGOUT") {
+            sessions.close(sessionToken);
+            sessionToken.clear();
+            out += "OK\n";
+        }
+        else if (command == "REVOKE" && fields.size() >= 2) {
+            if (session.role != user::Role::Editor) {
+                out += "ERR,AUTH\n";
+                return;
+            }
+            if (fields[1] == "ALL") {
+                sessions.revokeAll();
+            } else {
+                sessions.revokeUser(stoi(fields[1]));
+            }
+            out += "OK\n";
+        }
+        else if (command == "ADD" && fields.size() >= 7) {
+            Order order(0, fields[2], Order::kindFromString(fields[3]), chrono::system_clock::time_point());
+            if (!Order::deadlineFromString(fields[4], order.deadline)) {
+                out += "ERR,BADDEADLINE\n";
+                return;
+            }
+            // Orders belong to the session's user; the column may only repeat it
+            if (!fields[1].empty() && stoi(fields[1]) != session.userID) {
+                out += "ERR,AUTH\n";
+                return;
+            }
+            order.customerID = session.userID;
+            order.reference = fields[5];
+            order.extras = fields[6];
+            out += "OK," + to_string(manager.addNewOrder(order)) + "\n";
+        }
+        else if (command == "GET" && fields.size() >= 2) {
+            auto order = manager.findOrder(stoi(fields[1]));
+            if (!order) {
+                out += "ERR,NOTFOUND\n";
+                return;
+            }
+            out += "ROWS,1\n" + orderRow(*order);
+        }
+        else if (command == "LIST") {
+            auto view = manager.snapshot();
+            bool filtered = fields.size() >= 2 && !fields[1].empty();
+            int customerID = filtered ? stoi(fields[1]) : 0;
+            string rows;
+            int count = 0;
+            for (const auto& order : view->orders) {
+                if (filtered && order->customerID != customerID) continue;
+                rows += orderRow(*order);
+                count++;
+            }
+            out += "ROWS," + to_string(count) + "\n" + rows;
+        }
+        else if (command == "SEARCH" && fields.size() >= 2) {
+            auto view = manager.snapshot();
+            string rows;
+            int count = 0;
+            for (const auto& result : manager.searchOrders(fields[1])) {
+                if (auto order = view->find(result.orderID)) {
+                    rows += orderRow(*order);
+                    count++;
+                }
+            }
+            out += "ROWS," + to_string(count) + "\n" + rows;
+        }
+        else if (command == "MODIFY" && fields.size() >= 7) {
+            int orderID = stoi(fields[1]);
+            chrono::system_clock::time_point deadline;
+            if (!Order::deadlineFromString(fields[4], deadline)) {
+                out += "ERR,BADDEADLINE\n";
+                return;
+            }
+            writeResult(manager.modifyOrder(orderID, fields[2], Order::kindFromString(fields[3]), deadline,
+                                            fields[5], fields[6], optionalVersion(fields, 7)), orderID, out);
+        }
+        else if (command == "STATUS" && fields.size() >= 3) {
+            int orderID = stoi(fields[1]);
+            writeResult(manager.updateStatus(orderID, Order::statusFromString(fields[2]), optionalVersion(fields, 3)), orderID, out);
+        }
+        else if (command == "ASSIGN" && fields.size() >= 3) {
+            int orderID = stoi(fields[1]);
+            writeResult(manager.assignEditor(orderID, fields[2], optionalVersion(fields, 3)), orderID, out);
+        }
+        else if (command == "UNASSIGN" && fields.size() >= 2) {
+            int orderID = stoi(fields[1]);
+            writeResult(manager.unassignEditor(orderID, optionalVersion(fields, 2)), orderID, out);
+        }
+        else if (command == "LINK" && fields.size() >= 3) {
+            int orderID = stoi(fields[1]);
+            writeResult(manager.setFinalLink(orderID, fields[2], optionalVersion(fields, 3)), orderID, out);
+        }
+        else if (command == "DELETE" && fields.size() >= 2) {
+            int orderID = stoi(fields[1]);
+            if (!manager.findOrder(orderID)) {
+                out += "ERR,NOTFOUND\n";
+                return;
+            }
+            manager.deleteOrder(orderID);
+            out += "OK\n";
+        }
+        else {
+            out += "ERR,BADREQUEST\n";
+        }
+    } catch (const exception&) {
+        // stoi/stoull on a malformed number
+        out += "ERR,BADREQUEST\n";
+    }
+}
+
+void OrderService::subscribe(const string& request, Subscription& subscription, string& out) {
+    vector<string> fields = SaveManager::parseCSVLine(request);
+    Subscription next;
+    try {
+        if (fields.size() >= 2 && fields[1] == "ALL") {
+            next.filter = Subscription::Filter::All;
+        } else if (fields.size() >= 3 && fields[1] == "CUSTOMER") {
+            next.filter = Subscription::Filter::Customer;
+            next.customerID = stoi(fields[2]);
+        } else if (fields.size() >= 3 && fields[1] == "EDITOR" && !fields[2].empty()) {
+            next.filter = Subscription::Filter::Editor;
+            next.editor = fields[2];
+        }
+    } catch (const exception&) {
+        next.filter = Subscription::Filter::None;
+    }
+    if (!next.active()) {
+        out += "ERR,BADREQUEST\n";
+        return;
+    }
+
+    auto view = manager.snapshot();
+    string rows;
+    for (const auto& order : view->orders) {
+        if (!next.matches(*order)) continue;
+        rows += orderRow(*order);
+        next.visible.insert(order->orderID);
+    }
+    out += "ROWS," + to_string(next.visible.size()) + "\n" + rows;
+    subscription = move(next);
+}
+
+bool OrderService::pollChanges(vector<int>& changedIDs, bool& resync) {
+    changedIDs.clear();
+    feedEvents.clear();
+    manager.changes().poll(feedCursor, feedEvents);
+    resync = feedCursor.overrun;
+    feedCursor.overrun = false;
+
+    for (const auto& event : feedEvents) changedIDs.push_back(event.orderID);
+    sort(changedIDs.begin(), changedIDs.end());
+    changedIDs.erase(unique(changedIDs.begin(), changedIDs.end()), changedIDs.end());
+    appendLog(changedIDs, resync);
+    return !changedIDs.empty() || resync;
+}
+
+// Logs the latest state of every changed order rather than the individual
+// events, so applying the log is idempotent and a snapshot taken at any
+// point can be followed by any later suffix of it
+void OrderService::appendLog(const vector<int>& changedIDs, bool resync) {
+    for (const auto& u : userManager.getUsersFrom(usersLogged)) {
+        log.append(SaveManager::userToCSV(u));
+        usersLogged++;
+    }
+    if (resync) {
+        log.truncate();
+        return;
+    }
+    if (changedIDs.empty()) return;
+
+    auto view = manager.snapshot();
+    for (int orderID : changedIDs) {
+        auto order = view->find(orderID);
+        if (order) {
+            string row = orderRow(*order);
+            row.pop_back();
+            log.append(move(row));
+        } else {
+            log.append("REMOVED," + to_string(orderID));
+        }
+    }
+}
+
+void OrderService::writeDelta(Subscription& subscription, const OrderSnapshot& view,
+                              const vector<int>& changedIDs, bool resync, string& out) {
+    string lines;
+    int count = 0;
+    auto reconcile = [&](int orderID) {
+        auto order = view.find(orderID);
+        if (order && subscription.matches(*order)) {
+            lines += orderRow(*order);
+            subscription.visible.insert(orderID);
+            count++;
+        } else if (subscription.visible.erase(orderID)) {
+            lines += "REMOVED," + to_string(orderID) + "\n";
+            count++;
+        }
+    };
+
+    if (resync) {
+        // Events were lost: resend everything that matches and retract the rest
+        vector<int> held(subscription.visible.begin(), subscription.visible.end());
+        for (const auto& order : view.orders) reconcile(order->orderID);
+        for (int orderID : held) {
+            if (!view.find(orderID)) reconcile(orderID);
+        }
+    } else {
+        for (int orderID : changedIDs) reconcile(orderID);
+    }
+    if (count > 0) out += "DELTA," + to_string(count) + "\n" + lines;
+}
+
+shared_ptr<const OrderSnapshot> OrderService::snapshot() const {
+    return manager.snapshot();
+}
+
+void OrderService::setReadOnly(bool value) {
+    readOnly = value;
+}
+
+void OrderService::replicate(const string& request, const string& sessionToken, ReplicaStream& stream, string& out) {
+    SessionManager::Session session;
+    if (!sessions.validate(sessionToken, session) || session.role != user::Role::Editor) {
+        out += "ERR,AUTH\n";
+        return;
+    }
+    vector<string> fields = SaveManager::parseCSVLine(request);
+    try {
+        stream.next = (fields.size() >= 2) ? stoull(fields[1]) : 0;
+        // LSNs from another run of the primary mean nothing here
+        uint64_t epoch = (fields.size() >= 3) ? stoull(fields[2]) : 0;
+        if (epoch != log.epoch()) stream.next = 0;
+    } catch (const exception&) {
+        out += "ERR,BADREQUEST\n";
+        return;
+    }
+    stream.active = true;
+    out += "OK," + to_string(log.head()) + "," + to_string(log.epoch()) + "\n";
+    writeLog(stream, out);
+}
+
+void OrderService::writeSnapshot(ReplicaStream& stream, string& out) {
+    vector<user> users = userManager.getAllUsers();
+    auto view = manager.snapshot();
+    uint64_t lsn = log.head();
+
+    out += "SNAPSHOT," + to_string(lsn) + "," + to_string(users.size()) + "," + to_string(view->orders.size()) + "," +
+           to_string(log.epoch()) + "\n";
+    for (const auto& u : users) out += SaveManager::userToCSV(u) + "\n";
+    for (const auto& order : view->orders) out += orderRow(*order);
+    stream.next = lsn + 1;
+}
+
+void OrderService::writeLog(ReplicaStream& stream, string& out) {
+    // Too far behind, or a fresh copy was asked for (next 0, also after an epoch change)
+    if (stream.next < log.first() || stream.next > log.head() + 1) writeSnapshot(stream, out);
+    for (; stream.next <= log.head(); stream.next++) {
+        const ReplicationLog::Entry& entry = log.at(stream.next);
+        out += "L," + to_string(entry.lsn) + "," + to_string(entry.timestampMicros) + "," + entry.record + "\n";
+    }
+}
+
+void OrderService::writeHeartbeat(string& out) {
+    out += "HB," + to_string(log.head()) + "," + to_string(ReplicationLog::nowMicros()) + "\n";
+}
+
+void OrderService::expireSessions() {
+    sessions.expire();
+}
+
+void OrderService::setVerifier(PasswordVerifier* pool) {
+    verifier = pool;
+}
+
+bool OrderService::isDeferred(const string& request) const {
+    return verifier && (request.compare(0, 6, "LOGIN,") == 0 || request.compare(0, 9, "REGISTER,") == 0);
+}
+
+future<DeferredReply> OrderService::startDeferred(const string& request) {
+    auto reply = make_shared<promise<DeferredReply>>();
+    future<DeferredReply> result = reply->get_future();
+    vector<string> fields = SaveManager::parseCSVLine(request);
+
+    DeferredReply immediate;
+    if (fields[0] == "LOGIN" && fields.size() >= 3) {
+        user* u = userManager.getUserByUsername(fields[1]);
+        if (u) {
+            string password = fields[2];
+            verifier->post([this, reply, u, password]() {
+                DeferredReply done;
+                if (u->verifyPassword(password)) {
+                    done.bindsSession = true;
+                    done.sessionToken = sessions.open(*u);
+                    done.response = "OK," + to_string(u->getUserID()) + "," + user::roleToString(u->getRole()) + "," + done.sessionToken + "\n";
+                } else {
+                    done.response = "ERR,DENIED\n";
+                }
+                reply->set_value(move(done));
+            });
+            return result;
+        }
+        immediate.response = "ERR,DENIED\n";
+    } else if (fields[0] == "REGISTER" && fields.size() >= 4) {
+        if (readOnly) {
+            immediate.response = "ERR,READONLY\n";
+        } else if (userManager.usernameExists(fields[1])) {
+            immediate.response = "ERR,EXISTS\n";
+        } else {
+            string username = fields[1];
+            string password = fields[2];
+            user::Role role = (fields[3] == "Editor") ? user::Role::Editor : user::Role::Customer;
+            verifier->post([this, reply, username, password, role]() {
+                DeferredReply done;
+                // The name may have been taken while the hash was computed
+                if (userManager.restoreUser(username, PasswordHash::hash(password), role)) {
+                    user* u = userManager.getUserByUsername(username);
+                    done.response = "OK," + to_string(u ? u->getUserID() : 0) + "\n";
+                } else {
+                    done.response = "ERR,EXISTS\n";
+                }
+                reply->set_value(move(done));
+            });
+            return result;
+        }
+    } else {
+        immediate.response = "ERR,BADREQUEST\n";
+    }
+    reply->set_value(move(immediate));
+    return result;
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include "OrderManager.hpp"
+#include "UserManager.hpp"
+#include "ReplicationLog.hpp"
+#include "SessionManager.hpp"
+#include "PasswordVerifier.hpp"
+#include <future>
+#include <string>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+// Line-based request/response protocol over OrderManager and UserManager.
+// Requests and responses are CSV lines using the same escaping and column
+// encodings as savedata.txt. Every response is one OK or ERR line, except
+// reads, which answer "ROWS,<n>" followed by n ORDER rows (savedata columns
+// plus the order version).
+//
+//   PING                                              -> OK,PONG
+//   REGISTER,username,password,Customer|Editor        -> OK,userID
+//   LOGIN,username,password                           -> OK,userID,role,token
+//   AUTH,token                                        -> OK,userID,role
+//   LOGOUT                                            -> OK
+//   REVOKE,userID|ALL                                 -> OK
+//   ADD,customerID,name,kind,deadline,reference,extras -> OK,orderID
+//   GET,orderID                                       -> ROWS,1 + row
+//   LIST[,customerID]                                 -> ROWS,n + rows
+//   SEARCH,query                                      -> ROWS,n + rows
+//   MODIFY,orderID,name,kind,deadline,reference,extras[,version]
+//   STATUS,orderID,status[,version]
+//   ASSIGN,orderID,editor[,version]
+//   UNASSIGN,orderID[,version]
+//   LINK,orderID,finalLink[,version]                  -> OK,newVersion
+//   DELETE,orderID                                    -> OK
+//
+// Writes with a version are rejected with ERR,CONFLICT when the order moved on.
+//
+// LOGIN opens a session and binds it to the connection; AUTH binds an
+// existing session token, e.g. on a second connection of the same client.
+// Order writes (ADD through DELETE) need a bound, unexpired session and
+// answer ERR,AUTH otherwise; REVOKE also needs an Editor session. ADD creates
+// the order for the session's user: customerID may be left empty, and any
+// other user's ID is refused with ERR,AUTH. A Customer session may only
+// change its own orders; MODIFY through DELETE on another customer's order
+// answer ERR,AUTH. Editor sessions may change any order.
+//
+// A persistent connection can also register interest in a set of orders:
+//
+//   SUBSCRIBE,ALL | SUBSCRIBE,CUSTOMER,customerID | SUBSCRIBE,EDITOR,editor
+//                                                     -> ROWS,n + matching rows
+//
+// after which the server pushes "DELTA,n" followed by n lines, each either
+// the ORDER row of a changed order or "REMOVED,orderID" for one that was
+// deleted or no longer matches. Changes are coalesced, so an order appears at
+// most once per DELTA, in its latest state.
+//
+// A read replica streams the primary's mutation log:
+//
+//   REPLICATE,fromLSN,epoch                           -> OK,headLSN,epoch
+//
+// The stream carries every USER row, password hashes included, so the
+// connection must first LOGIN or AUTH as an Editor; otherwise REPLICATE
+// answers ERR,AUTH.
+//
+// followed, when fromLSN is no longer retained, or epoch is not the primary's
+// current one (0 asks for a fresh copy), by "SNAPSHOT,lsn,users,orders,epoch"
+// and that many USER and ORDER rows, which replace the replica's state. After that
+// the server pushes "L,lsn,timestampMicros,<record>" for every logged change
+// and "HB,headLSN,timestampMicros" heartbeats while idle.
+struct Subscription {
+    enum class Filter { None, All, Customer, Editor };
+
+    Filter filter = Filter::None;
+    int customerID = 0;
+    string editor;
+    // Orders the subscriber currently holds, so it can be told when one leaves
+    unordered_set<int> visible;
+
+    bool active() const { return filter != Filter::None; }
+    bool matches(const Order& order) const;
+};
+
+// Reply to a request that was finished off the server thread
+struct DeferredReply {
+    string response;
+    bool bindsSession = false;
+    string sessionToken;
+};
+
+struct ReplicaStream {
+    bool active = false;
+    uint64_t next = 0;      // next LSN to send
+};
+
+class OrderService {
+public:
+    OrderService(OrderManager& manager, UserManager& userManager);
+
+    // Handles one request line (without newline) and appends the response,
+    // newline-terminated, to out. sessionToken is the connection's bound
+    // session, updated by LOGIN, AUTH and LOGOUT.
+    void handle(const string& request, string& out, string& sessionToken);
+
+    // Handles a SUBSCRIBE request, replacing any earlier subscription
+    void subscribe(const string& request, Subscription& subscription, string& out);
+    // Collects the IDs of orders changed since the last call, sorted and
+    // deduplicated. resync is set when the change feed overran and every
+    // subscriber has to be reconciled against the full snapshot.
+    bool pollChanges(vector<int>& changedIDs, bool& resync);
+    void writeDelta(Subscription& subscription, const OrderSnapshot& view,
+                    const vector<int>& changedIDs, bool resync, string& out);
+    shared_ptr<const OrderSnapshot> snapshot() const;
+
+    // Replicas refuse every write with ERR,READONLY
+    void setReadOnly(bool readOnly);
+    // Handles a REPLICATE request and starts streaming from the asked LSN.
+    // sessionToken is the connection's bound session, which must be an Editor's.
+    void replicate(const string& request, const string& sessionToken, ReplicaStream& stream, string& out);
+    // Sends the stream everything logged since its position
+    void writeLog(ReplicaStream& stream, string& out);
+    void writeHeartbeat(string& out);
+
+    // Drops expired sessions; call about once a second
+    void expireSessions();
+
+    // LOGIN and REGISTER verify or hash a password, which is slow on purpose.
+    // With a verifier attached, the server hands those requests to
+    // startDeferred() instead of handle() and holds back the connection's
+    // later requests until the reply is ready. The verifier must be
+    // destroyed before the service.
+    void setVerifier(PasswordVerifier* verifier);
+    bool isDeferred(const string& request) const;
+    future<DeferredReply> startDeferred(const string& request);
+
+private:
+    OrderManager& manager;
+    UserManager& userManager;
+    ChangeFeed::Cursor feedCursor;
+    vector<OrderEvent> feedEvents;
+    ReplicationLog log;
+    SessionManager sessions;
+    size_t usersLogged = 0;
+    bool readOnly = false;
+    PasswordVerifier* verifier = nullptr;
+
+    static string orderRow(const Order& order);
+    void writeResult(UpdateResult result, int orderID, string& out);
+    void appendLog(const vector<int>& changedIDs, bool resync);
+    void writeSnapshot(ReplicaStream& stream, string& out);
+};
@@ -0,0 +1,97 @@
+#include "OrderStats.hpp"
+#include <algorithm>
+
+void OrderStats::add(const Order& order) {
+    totalOrders++;
+    byStatus[static_cast<int>(order.status)]++;
+    byKind[static_cast<int>(order.orderKind)]++;
+    if (!order.editorAssigned.empty()) {
+        assignedOrders++;
+        byEditor.edit(order.editorAssigned)++;
+        EditorWork& work = editorWork.edit(order.editorAssigned);
+        if (order.status == OrderStatus::Pending || order.status == OrderStatus::InProgress) {
+            work.open++;
+        } else if (order.status == OrderStatus::Completed) {
+            work.completed++;
+            work.completedByKind[static_cast<int>(order.orderKind)]++;
+        }
+    }
+    byCustomer.edit(order.customerID)++;
+}
+
+void OrderStats::remove(const Order& order) {
+    totalOrders--;
+    byStatus[static_cast<int>(order.status)]--;
+    byKind[static_cast<int>(order.orderKind)]--;
+    if (!order.editorAssigned.empty()) {
+        assignedOrders--;
+        if (byEditor.find(order.editorAssigned) && --byEditor.edit(order.editorAssigned) == 0) {
+            byEditor.erase(order.editorAssigned);
+        }
+        if (editorWork.find(order.editorAssigned)) {
+            EditorWork& work = editorWork.edit(order.editorAssigned);
+            if (order.status == OrderStatus::Pending || order.status == OrderStatus::InProgress) {
+                work.open--;
+            } else if (order.status == OrderStatus::Completed) {
+                work.completed--;
+                work.completedByKind[static_cast<int>(order.orderKind)]--;
+            }
+            if (work.open == 0 && work.completed == 0) editorWork.erase(order.editorAssigned);
+        }
+    }
+    if (byCustomer.find(order.customerID) && --byCustomer.edit(order.customerID) == 0) {
+        byCustomer.erase(order.customerID);
+    }
+}
+
+void OrderStats::clear() {
+    *this = OrderStats();
+}
+
+int OrderStats::total() const {
+    return totalOrders;
+}
+
+int OrderStats::countByStatus(OrderStatus status) const {
+    return byStatus[static_cast<int>(status)];
+}
+
+int OrderStats::countByKind(OrderKind kind) const {
+    return byKind[static_cast<int>(kind)];
+}
+
+int OrderStats::countForEditor(const string& editorName) const {
+    const int* count = byEditor.find(editorName);
+    return count ? *count : 0;
+}
+
+int OrderStats::countForCustomer(int customerID) const {
+    const int* count = byCustomer.find(customerID);
+    return count ? *count : 0;
+}
+
+int OrderStats::unassignedCount() const {
+    return totalOrders - assignedOrders;
+}
+
+vector<pair<string, int>> OrderStats::getEditorCounts() const {
+    vector<pair<string, int>> counts;
+    byEditor.forEach([&counts](const string& editor, int count) { counts.emplace_back(editor, count); });
+    sort(counts.begin(), counts.end());
+    return counts;
+}
+
+int OrderStats::openForEditor(const string& editorName) const {
+    const EditorWork* work = editorWork.find(editorName);
+    return work ? work->open : 0;
+}
+
+int OrderStats::completedForEditor(const string& editorName) const {
+    const EditorWork* work = editorWork.find(editorName);
+    return work ? work->completed : 0;
+}
+
+int OrderStats::completedForEditor(const string& editorName, OrderKind kind) const {
+    const EditorWork* work = editorWork.find(editorName);
+    return work ? work->completedByKind[static_cast<int>(kind)] : 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "order.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Hash map cut into shards that copies of it share. Copying it copies the
+// shard pointers only; a write then copies just the shard it touches, unless
+// no other copy holds that shard anymore.
+template <class Key, class Value, size_t ShardCount>
+class SharedMap {
+public:
+    const Value* find(const Key& key) const {
+        const auto& shard = shards[index(key)];
+        if (!shard) return nullptr;
+        auto it = shard->find(key);
+        return it != shard->end() ? &it->second : nullptr;
+    }
+    Value& edit(const Key& key) { return own(key)[key]; }
+    void erase(const Key& key) {
+        if (shards[index(key)]) own(key).erase(key);
+    }
+    template <class Fn> void forEach(Fn fn) const {
+        for (const auto& shard : shards) {
+            if (!shard) continue;
+            for (const auto& entry : *shard) fn(entry.first, entry.second);
+        }
+    }
+
+private:
+    using Shard = unordered_map<Key, Value>;
+    shared_ptr<Shard> shards[ShardCount];
+
+    static size_t index(const Key& key) { return hash<Key>()(key) % ShardCount; }
+    Shard& own(const Key& key) {
+        shared_ptr<Shard>& shard = shards[index(key)];
+        if (!shard) shard = make_shared<Shard>();
+        else if (shard.use_count() > 1) shard = make_shared<Shard>(*shard);
+        return *shard;
+    }
+};
+
+// Running order counts, kept up to date by OrderManager on every mutation.
+// Cheap to copy: the per-editor and per-customer maps are shared between
+// copies until written.
+class OrderStats {
+public:
+    static const int StatusCount = 4;
+    static const int KindCount = 6;
+
+    void add(const Order& order);
+    void remove(const Order& order);
+    void clear();
+
+    int total() const;
+    int countByStatus(OrderStatus status) const;
+    int countByKind(OrderKind kind) const;
+    int countForEditor(const string& editorName) const;
+    int countForCustomer(int customerID) const;
+    int unassignedCount() const;
+    // (editor, assigned orders) pairs, sorted by editor name
+    vector<pair<string, int>> getEditorCounts() const;
+    // Pending / InProgress orders assigned to the editor, i.e. current load
+    int openForEditor(const string& editorName) const;
+    // Completed orders the editor delivered, in total and of one kind
+    int completedForEditor(const string& editorName) const;
+    int completedForEditor(const string& editorName, OrderKind kind) const;
+
+private:
+    int totalOrders = 0;
+    int assignedOrders = 0;
+    int byStatus[StatusCount] = {};
+    int byKind[KindCount] = {};
+    // Few editors, so one shard each; customers grow with the orders
+    SharedMap<string, int, 1> byEditor;
+    struct EditorWork {
+        int open = 0;
+        int completed = 0;
+        int completedByKind[KindCount] = {};
+    };
+    SharedMap<string, EditorWork, 1> editorWork;
+    SharedMap<int, int, 256> byCustomer;
+};
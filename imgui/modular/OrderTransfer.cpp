@@ -0,0 +1,505 @@
+#include "OrderTransfer.hpp"
+#include "SaveManager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Blocking queue with a fixed capacity between two pipeline stages
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+    void push(T item) {
+        unique_lock<mutex> lock(queueMutex);
+        notFull.wait(lock, [this] { return items.size() < capacity; });
+        items.push_back(move(item));
+        notEmpty.notify_one();
+    }
+
+    // False once the queue is closed and drained
+    bool pop(T& item) {
+        unique_lock<mutex> lock(queueMutex);
+        notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+        item = move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> lock(queueMutex);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    size_t capacity;
+    deque<T> items;
+    bool closed = false;
+    mutex queueMutex;
+    condition_variable notFull;
+    condition_variable notEmpty;
+};
+
+struct RawBatch {
+    vector<size_t> lineNumbers;     // where each row starts
+    vector<string> rows;
+};
+
+struct ParsedBatch {
+    vector<size_t> lineNumbers;
+    vector<Order> orders;
+    vector<ImportError> errors;
+    size_t skipped = 0;
+};
+
+// Column order shared by the CSV rows and the JSON keys
+enum Column { ID, Name, Status, Kind, Deadline, Reference, Extras, Editor, Link, Customer, ColumnCount };
+const char* ColumnKeys[ColumnCount] = {
+    "id", "name", "status", "kind", "deadline", "reference", "extras", "editor", "link", "customer"
+};
+
+bool parseInt(const string& text, int& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    long parsed = strtol(text.c_str(), &end, 10);
+    if (*end != '\0' || parsed < INT_MIN || parsed > INT_MAX) return false;
+    value = (int)parsed;
+    return true;
+}
+
+bool validDate(const string& text) {
+    int year, month, day;
+    char extra;
+    if (sscanf(text.c_str(), "%4d-%2d-%2d%c", &year, &month, &day, &extra) != 3) return false;
+    return year >= 1970 && month >= 1 && month <= 12 && day >= 1 && day <= 31;
+}
+
+// Builds an order from column values; present[c] is false for a missing
+// JSON key, which leaves the default
+bool buildOrder(const string* values, const bool* present, Order& order, string& error) {
+    static const Column required[] = { ID, Name, Kind, Deadline, Customer };
+    for (Column c : required) {
+        if (!present[c]) {
+            error = string("missing ") + ColumnKeys[c];
+            return false;
+        }
+    }
+    if (!parseInt(values[ID], order.orderID) || order.orderID <= 0) {
+        error = "id must be a positive integer, got \"" + values[ID] + "\"";
+        return false;
+    }
+    if (!parseInt(values[Customer], order.customerID) || order.customerID < 0) {
+        error = "customer must be a non-negative integer, got \"" + values[Customer] + "\"";
+        return false;
+    }
+    if (values[Name].empty()) {
+        error = "name is empty";
+        return false;
+    }
+    if (present[Status]) {
+        order.status = Order::statusFromString(values[Status]);
+        if (Order::statusToString(order.status) != values[Status]) {
+            error = "unknown status \"" + values[Status] + "\"";
+            return false;
+        }
+    }
+    order.orderKind = Order::kindFromString(values[Kind]);
+    if (Order::kindToString(order.orderKind) != values[Kind]) {
+        error = "unknown kind \"" + values[Kind] + "\"";
+        return false;
+    }
+    if (!validDate(values[Deadline]) || !Order::deadlineFromString(values[Deadline], order.deadline)) {
+        error = "deadline must be YYYY-MM-DD, got \"" + values[Deadline] + "\"";
+        return false;
+    }
+    order.orderName = values[Name];
+    order.reference = values[Reference];
+    order.extras = values[Extras];
+    order.editorAssigned = values[Editor];
+    order.finalLink = values[Link];
+    return true;
+}
+
+void appendUTF8(string& out, uint32_t code) {
+    if (code < 0x80) {
+        out += (char)code;
+    } else if (code < 0x800) {
+        out += (char)(0xC0 | (code >> 6));
+        out += (char)(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += (char)(0xE0 | (code >> 12));
+        out += (char)(0x80 | ((code >> 6) & 0x3F));
+        out += (char)(0x80 | (code & 0x3F));
+    } else {
+        out += (char)(0xF0 | (code >> 18));
+        out += (char)(0x80 | ((code >> 12) & 0x3F));
+        out += (char)(0x80 | ((code >> 6) & 0x3F));
+        out += (char)(0x80 | (code & 0x3F));
+    }
+}
+
+// Minimal reader for one flat JSON object of string, number and literal values
+class JSONRow {
+public:
+    JSONRow(const string& text) : text(text) {}
+
+    bool parse(string* values, bool* present, string& error) {
+        skipSpace();
+        if (!consume('{')) return fail("expected '{'", error);
+        skipSpace();
+        if (consume('}')) return finish(error);
+        for (;;) {
+            string key, value;
+            skipSpace();
+            if (!readString(key)) return fail("expected a quoted key", error);
+            skipSpace();
+            if (!consume(':')) return fail("expected ':' after \"" + key + "\"", error);
+            skipSpace();
+            if (pos < text.size() && text[pos] == '"') {
+                if (!readString(value)) return fail("unterminated string for \"" + key + "\"", error);
+            } else if (!readBare(value)) {
+                return fail("bad value for \"" + key + "\"", error);
+            }
+            for (int c = 0; c < ColumnCount; ++c) {
+                if (key == ColumnKeys[c]) {
+                    values[c] = value;
+                    present[c] = true;
+                }
+            }
+            skipSpace();
+            if (consume(',')) continue;
+            if (consume('}')) return finish(error);
+            return fail("expected ',' or '}'", error);
+        }
+    }
+
+private:
+    const string& text;
+    size_t pos = 0;
+
+    bool fail(const string& message, string& error) {
+        error = message + " at column " + to_string(pos + 1);
+        return false;
+    }
+
+    bool finish(string& error) {
+        skipSpace();
+        return pos == text.size() || fail("unexpected text after the object", error);
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) pos++;
+    }
+
+    bool consume(char c) {
+        if (pos < text.size() && text[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool readHex4(uint32_t& code) {
+        if (pos + 4 > text.size()) return false;
+        code = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = text[pos++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') code |= c - '0';
+            else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    bool readString(string& out) {
+        if (!consume('"')) return false;
+        while (pos < text.size()) {
+            char c = text[pos++];
+            if (c == '"') return true;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos >= text.size()) return false;
+            char e = text[pos++];
+            switch (e) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t code;
+                    if (!readHex4(code)) return false;
+                    // Surrogate pair for characters outside the BMP
+                    if (code >= 0xD800 && code < 0xDC00 && text.compare(pos, 2, "\\u") == 0) {
+                        pos += 2;
+                        uint32_t low;
+                        if (!readHex4(low) || low < 0xDC00 || low > 0xDFFF) return false;
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUTF8(out, code);
+                    break;
+                }
+                default: return false;
+            }
+        }
+        return false;
+    }
+
+    // Numbers and true/false/null, kept as their text
+    bool readBare(string& out) {
+        size_t start = pos;
+        while (pos < text.size() && text[pos] != ',' && text[pos] != '}' && text[pos] != ' ' && text[pos] != '\t') pos++;
+        out = text.substr(start, pos - start);
+        return !out.empty();
+    }
+};
+
+void appendJSONString(string& out, const string& value) {
+    out += '"';
+    for (unsigned char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += (char)c;
+                }
+        }
+    }
+    out += '"';
+}
+
+void reportError(ImportReport& report, size_t line, const string& message) {
+    report.errorCount++;
+    if (report.errors.size() < OrderTransfer::MaxReportedErrors) report.errors.push_back({ line, message });
+}
+
+} // namespace
+
+bool OrderTransfer::formatFromName(const string& filename, TransferFormat& format) {
+    size_t dot = filename.rfind('.');
+    if (dot == string::npos) return false;
+    string ext = filename.substr(dot + 1);
+    for (auto& c : ext) c = (char)tolower((unsigned char)c);
+    if (ext == "csv" || ext == "txt") format = TransferFormat::CSV;
+    else if (ext == "jsonl" || ext == "json") format = TransferFormat::JSONLines;
+    else return false;
+    return true;
+}
+
+bool OrderTransfer::orderFromCSVRow(const string& line, Order& order, string& error) {
+    vector<string> fields = SaveManager::parseCSVLine(line);
+    if (fields[0] != "ORDER") {
+        error = "expected an ORDER row";
+        return false;
+    }
+    if (fields.size() != ColumnCount + 1) {
+        error = "expected " + to_string(ColumnCount + 1) + " columns, found " + to_string(fields.size());
+        return false;
+    }
+    string values[ColumnCount];
+    bool present[ColumnCount];
+    for (int c = 0; c < ColumnCount; ++c) {
+        values[c] = fields[c + 1];
+        present[c] = true;
+    }
+    return buildOrder(values, present, order, error);
+}
+
+bool OrderTransfer::orderFromJSON(const string& line, Order& order, string& error) {
+    string values[ColumnCount];
+    bool present[ColumnCount] = {};
+    JSONRow row(line);
+    if (!row.parse(values, present, error)) return false;
+    return buildOrder(values, present, order, error);
+}
+
+string OrderTransfer::orderToJSON(const Order& order) {
+    string values[ColumnCount] = {
+        to_string(order.orderID), order.orderName, Order::statusToString(order.status),
+        Order::kindToString(order.orderKind), Order::deadlineToString(order.deadline),
+        order.reference, order.extras, order.editorAssigned, order.finalLink, to_string(order.customerID)
+    };
+    string out = "{";
+    for (int c = 0; c < ColumnCount; ++c) {
+        if (c > 0) out += ',';
+        out += '"';
+        out += ColumnKeys[c];
+        out += "\":";
+        if (c == ID || c == Customer) out += values[c];
+        else appendJSONString(out, values[c]);
+    }
+    out += '}';
+    return out;
+}
+
+ImportReport OrderTransfer::importOrders(istream& in, TransferFormat format, OrderManager& manager) {
+    auto start = chrono::steady_clock::now();
+    ImportReport report;
+    BoundedQueue<RawBatch> raw(QueueDepth);
+    BoundedQueue<ParsedBatch> parsed(QueueDepth);
+
+    thread parser([&raw, &parsed, format]() {
+        RawBatch batch;
+        while (raw.pop(batch)) {
+            ParsedBatch out;
+            out.orders.reserve(batch.rows.size());
+            for (size_t i = 0; i < batch.rows.size(); ++i) {
+                const string& row = batch.rows[i];
+                if (format == TransferFormat::CSV &&
+                    (row[0] == '#' || row.compare(0, 5, "TYPE,") == 0 || row.compare(0, 5, "USER,") == 0)) {
+                    out.skipped++;
+                    continue;
+                }
+                Order order(0, "", OrderKind::Other, chrono::system_clock::time_point());
+                string error;
+                bool ok = format == TransferFormat::CSV ? orderFromCSVRow(row, order, error)
+                                                        : orderFromJSON(row, order, error);
+                if (ok) {
+                    out.orders.push_back(move(order));
+                    out.lineNumbers.push_back(batch.lineNumbers[i]);
+                } else {
+                    out.errors.push_back({ batch.lineNumbers[i], error });
+                }
+            }
+            parsed.push(move(out));
+        }
+        parsed.close();
+    });
+
+    thread inserter([&parsed, &manager, &report]() {
+        ParsedBatch batch;
+        vector<size_t> rejected;
+        while (parsed.pop(batch)) {
+            rejected.clear();
+            report.imported += manager.addOrders(batch.orders, rejected);
+            report.skipped += batch.skipped;
+            for (size_t index : rejected) {
+                batch.errors.push_back({ batch.lineNumbers[index],
+                                         "order " + to_string(batch.orders[index].orderID) + " already exists" });
+            }
+            sort(batch.errors.begin(), batch.errors.end(), [](const ImportError& a, const ImportError& b) {
+                return a.line < b.line;
+            });
+            for (const auto& error : batch.errors) reportError(report, error.line, error.message);
+        }
+    });
+
+    // Reader: split into rows, joining CSV lines while a quoted field is open
+    RawBatch batch;
+    string line;
+    string row;
+    size_t rowStart = 0;
+    bool inQuotes = false;
+    while (getline(in, line)) {
+        report.lines++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (report.lines == 1 && line.compare(0, 3, "\xEF\xBB\xBF") == 0) line.erase(0, 3);
+        if (format == TransferFormat::CSV) {
+            if (!inQuotes) {
+                row.clear();
+                rowStart = report.lines;
+            } else {
+                row += '\n';
+            }
+            row += line;
+            if (count(line.begin(), line.end(), '"') % 2 == 1) inQuotes = !inQuotes;
+            if (inQuotes) continue;
+        } else {
+            row = line;
+            rowStart = report.lines;
+        }
+        if (row.find_first_not_of(" \t") == string::npos) continue;
+
+        batch.lineNumbers.push_back(rowStart);
+        batch.rows.push_back(move(row));
+        row.clear();
+        if (batch.rows.size() == BatchSize) {
+            raw.push(move(batch));
+            batch = RawBatch();
+        }
+    }
+    if (!batch.rows.empty()) raw.push(move(batch));
+    raw.close();
+
+    parser.join();
+    inserter.join();
+    // The open row runs to the end of the file, so this is still in line order
+    if (inQuotes) reportError(report, rowStart, "quoted field is never closed");
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+bool OrderTransfer::importFile(const string& filename, OrderManager& manager, ImportReport& report) {
+    TransferFormat format;
+    if (!formatFromName(filename, format)) {
+        cerr << "Error: Unknown import format (use .csv or .jsonl): " << filename << endl;
+        return false;
+    }
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file for reading: " << filename << endl;
+        return false;
+    }
+    report = importOrders(file, format, manager);
+    return true;
+}
+
+size_t OrderTransfer::exportOrders(ostream& out, TransferFormat format, const OrderSnapshot& view) {
+    if (format == TransferFormat::CSV) {
+        out << "TYPE,ORDERID,ORDERNAME,STATUS,ORDERTYPE,DEADLINE,REFERENCE,EXTRAS,EDITOR_ASSIGNED,FINALLINK,CUSTOMERID\n";
+    }
+    size_t written = 0;
+    for (const auto& order : view.orders) {
+        out << (format == TransferFormat::CSV ? SaveManager::orderToCSV(*order) : orderToJSON(*order)) << '\n';
+        written++;
+    }
+    return written;
+}
+
+bool OrderTransfer::exportFile(const string& filename, const OrderManager& manager, size_t& written) {
+    TransferFormat format;
+    if (!formatFromName(filename, format)) {
+        cerr << "Error: Unknown export format (use .csv or .jsonl): " << filename << endl;
+        return false;
+    }
+    ofstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file for writing: " << filename << endl;
+        return false;
+    }
+    written = exportOrders(file, format, *manager.snapshot());
+    file.flush();
+    if (!file) {
+        cerr << "Error: Could not write " << filename << endl;
+        return false;
+    }
+    return true;
+}
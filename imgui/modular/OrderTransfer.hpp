@@ -0,0 +1,58 @@
+#pragma once
+#include "OrderManager.hpp"
+#include <iosfwd>
+#include <string>
+#include <vector>
+using namespace std;
+
+enum class TransferFormat {
+    CSV,        // ORDER rows as in savedata.txt
+    JSONLines,  // one flat JSON object per line
+};
+
+struct ImportError {
+    size_t line;
+    string message;
+};
+
+struct ImportReport {
+    size_t lines = 0;       // physical lines read
+    size_t imported = 0;
+    size_t skipped = 0;     // headers, comments and USER rows
+    size_t errorCount = 0;
+    vector<ImportError> errors;     // the first MaxReportedErrors, by line
+    double seconds = 0;
+};
+
+// Streaming order import and export. Import runs as a pipeline: the calling
+// thread reads lines, a parser thread turns them into validated orders and an
+// insert thread hands them to OrderManager::addOrders one batch at a time.
+// The stages pass batches through short bounded queues, so memory stays
+// constant however large the file is, and a slow stage holds up the ones
+// before it instead of letting work pile up. Rows that fail validation, or
+// reuse an order ID, are reported with their line number and skipped; the
+// rest are imported.
+//
+// JSON Lines rows use the keys id, name, status, kind, deadline, reference,
+// extras, editor, link and customer, with the same values as the CSV columns.
+class OrderTransfer {
+public:
+    static const size_t BatchSize = 4096;       // rows per queue entry and per addOrders call
+    static const size_t QueueDepth = 4;         // batches waiting between two stages
+    static const size_t MaxReportedErrors = 100;
+
+    // .csv / .txt and .jsonl / .json by extension
+    static bool formatFromName(const string& filename, TransferFormat& format);
+
+    static ImportReport importOrders(istream& in, TransferFormat format, OrderManager& manager);
+    static bool importFile(const string& filename, OrderManager& manager, ImportReport& report);
+
+    // Writes the snapshot row by row; returns the number of orders written
+    static size_t exportOrders(ostream& out, TransferFormat format, const OrderSnapshot& view);
+    static bool exportFile(const string& filename, const OrderManager& manager, size_t& written);
+
+    static string orderToJSON(const Order& order);
+    // Parses and validates one row; on failure error says what was wrong
+    static bool orderFromJSON(const string& line, Order& order, string& error);
+    static bool orderFromCSVRow(const string& line, Order& order, string& error);
+};
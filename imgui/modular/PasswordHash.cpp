@@ -0,0 +1,235 @@
+#include "PasswordHash.hpp"
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const char* Prefix = "pbkdf2-sha256$";
+static const size_t SaltLength = 16;
+static atomic<uint32_t> workFactor{ PasswordHash::DefaultIterations };
+
+// ---- SHA-256 (FIPS 180-4) ----
+
+namespace {
+
+const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+struct Sha256 {
+    uint32_t state[8];
+    uint8_t block[64];
+    size_t blockUsed = 0;
+    uint64_t totalBytes = 0;
+
+    Sha256() { reset(); }
+
+    void reset() {
+        static const uint32_t init[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+        };
+        memcpy(state, init, sizeof(state));
+        blockUsed = 0;
+        totalBytes = 0;
+    }
+
+    static void compress(uint32_t s[8], const uint8_t* data) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (uint32_t)data[i * 4] << 24 | (uint32_t)data[i * 4 + 1] << 16 |
+                   (uint32_t)data[i * 4 + 2] << 8 | (uint32_t)data[i * 4 + 3];
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        s[0] += a; s[1] += b; s[2] += c; s[3] += d; s[4] += e; s[5] += f; s[6] += g; s[7] += h;
+    }
+
+    void update(const uint8_t* data, size_t length) {
+        totalBytes += length;
+        while (length > 0) {
+            size_t take = 64 - blockUsed;
+            if (take > length) take = length;
+            memcpy(block + blockUsed, data, take);
+            blockUsed += take;
+            data += take;
+            length -= take;
+            if (blockUsed == 64) {
+                compress(state, block);
+                blockUsed = 0;
+            }
+        }
+    }
+
+    void finish(uint8_t out[32]) {
+        uint64_t bits = totalBytes * 8;
+        uint8_t pad = 0x80;
+        update(&pad, 1);
+        pad = 0;
+        while (blockUsed != 56) update(&pad, 1);
+        uint8_t length[8];
+        for (int i = 0; i < 8; ++i) length[i] = (uint8_t)(bits >> (56 - 8 * i));
+        update(length, 8);
+        storeState(state, out);
+    }
+
+    static void storeState(const uint32_t s[8], uint8_t out[32]) {
+        for (int i = 0; i < 8; ++i) {
+            out[i * 4] = (uint8_t)(s[i] >> 24);
+            out[i * 4 + 1] = (uint8_t)(s[i] >> 16);
+            out[i * 4 + 2] = (uint8_t)(s[i] >> 8);
+            out[i * 4 + 3] = (uint8_t)s[i];
+        }
+    }
+};
+
+string toHex(const uint8_t* data, size_t length) {
+    static const char digits[] = "0123456789abcdef";
+    string hex;
+    hex.reserve(length * 2);
+    for (size_t i = 0; i < length; ++i) {
+        hex += digits[data[i] >> 4];
+        hex += digits[data[i] & 0xF];
+    }
+    return hex;
+}
+
+bool fromHex(const string& hex, vector<uint8_t>& out) {
+    if (hex.size() % 2 != 0) return false;
+    out.clear();
+    for (size_t i = 0; i < hex.size(); i += 2) {
+        int value = 0;
+        for (int j = 0; j < 2; ++j) {
+            char c = hex[i + j];
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= c - '0';
+            else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+            else return false;
+        }
+        out.push_back((uint8_t)value);
+    }
+    return true;
+}
+
+}
+
+// HMAC keys are padded once into inner and outer states. Every PBKDF2 round
+// hashes a 32-byte message, which fits one block together with its padding,
+// so a round costs exactly two compressions.
+void PasswordHash::pbkdf2(const string& password, const uint8_t* salt, size_t saltLength,
+                          uint32_t iterations, uint8_t out[32]) {
+    uint8_t key[64] = {};
+    if (password.size() > 64) {
+        Sha256 keyHash;
+        keyHash.update((const uint8_t*)password.data(), password.size());
+        keyHash.finish(key);
+    } else {
+        memcpy(key, password.data(), password.size());
+    }
+
+    uint8_t pad[64];
+    Sha256 inner, outer;
+    for (int i = 0; i < 64; ++i) pad[i] = key[i] ^ 0x36;
+    inner.update(pad, 64);
+    for (int i = 0; i < 64; ++i) pad[i] = key[i] ^ 0x5c;
+    outer.update(pad, 64);
+
+    // U1 = HMAC(password, salt || INT(1))
+    uint8_t u[32];
+    {
+        Sha256 h = inner;
+        static const uint8_t blockIndex[4] = { 0, 0, 0, 1 };
+        h.update(salt, saltLength);
+        h.update(blockIndex, 4);
+        h.finish(u);
+        Sha256 o = outer;
+        o.update(u, 32);
+        o.finish(u);
+    }
+    memcpy(out, u, 32);
+
+    // Single-block message: 32 bytes of data, then padding for 64 + 32 bytes
+    uint8_t message[64] = {};
+    message[32] = 0x80;
+    message[62] = 0x03;     // 768 bits, big-endian
+    uint32_t state[8];
+    for (uint32_t round = 1; round < iterations; ++round) {
+        memcpy(message, u, 32);
+        memcpy(state, inner.state, sizeof(state));
+        Sha256::compress(state, message);
+        Sha256::storeState(state, message);
+        memcpy(state, outer.state, sizeof(state));
+        Sha256::compress(state, message);
+        Sha256::storeState(state, u);
+        for (int i = 0; i < 32; ++i) out[i] ^= u[i];
+    }
+}
+
+string PasswordHash::hash(const string& password) {
+    return hash(password, iterations());
+}
+
+string PasswordHash::hash(const string& password, uint32_t rounds) {
+    if (rounds == 0) rounds = 1;
+    uint8_t salt[SaltLength];
+    random_device source;
+    for (size_t i = 0; i < SaltLength; i += 4) {
+        uint32_t bits = source();
+        memcpy(salt + i, &bits, 4);
+    }
+    uint8_t derived[32];
+    pbkdf2(password, salt, SaltLength, rounds, derived);
+    return Prefix + to_string(rounds) + "$" + toHex(salt, SaltLength) + "$" + toHex(derived, 32);
+}
+
+bool PasswordHash::isHashed(const string& stored) {
+    return stored.compare(0, strlen(Prefix), Prefix) == 0;
+}
+
+bool PasswordHash::verify(const string& password, const string& stored) {
+    if (!isHashed(stored)) return password == stored;
+
+    size_t first = strlen(Prefix);
+    size_t second = stored.find('$', first);
+    size_t third = (second == string::npos) ? string::npos : stored.find('$', second + 1);
+    if (third == string::npos) return false;
+
+    uint32_t rounds = (uint32_t)strtoul(stored.c_str() + first, nullptr, 10);
+    vector<uint8_t> salt, expected;
+    if (rounds == 0 || !fromHex(stored.substr(second + 1, third - second - 1), salt) ||
+        !fromHex(stored.substr(third + 1), expected) || expected.size() != 32) {
+        return false;
+    }
+
+    uint8_t derived[32];
+    pbkdf2(password, salt.data(), salt.size(), rounds, derived);
+    uint8_t diff = 0;
+    for (int i = 0; i < 32; ++i) diff |= derived[i] ^ expected[i];
+    return diff == 0;
+}
+
+void PasswordHash::setIterations(uint32_t rounds) {
+    workFactor = rounds ? rounds : 1;
+}
+
+uint32_t PasswordHash::iterations() {
+    return workFactor;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+using namespace std;
+
+// Salted PBKDF2-HMAC-SHA256 password hashes, stored as
+//
+//   pbkdf2-sha256$<iterations>$<salt hex>$<hash hex>
+//
+// The iteration count is the work factor. It is kept in each hash, so raising
+// it only affects passwords hashed afterwards. Anything not in this format
+// is treated as a legacy plaintext password.
+class PasswordHash {
+public:
+    static const uint32_t DefaultIterations = 100000;
+
+    static string hash(const string& password);
+    static string hash(const string& password, uint32_t iterations);
+    // Constant-time for hashed values; falls back to plain comparison for
+    // legacy plaintext
+    static bool verify(const string& password, const string& stored);
+    static bool isHashed(const string& stored);
+
+    // Work factor for new hashes
+    static void setIterations(uint32_t iterations);
+    static uint32_t iterations();
+
+    // Raw PBKDF2-HMAC-SHA256 with a 32-byte output
+    static void pbkdf2(const string& password, const uint8_t* salt, size_t saltLength,
+                       uint32_t iterations, uint8_t out[32]);
+};
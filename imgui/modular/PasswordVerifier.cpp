@@ -0,0 +1,75 @@
+#include "PasswordVerifier.hpp"
+#include "PasswordHash.hpp"
+#include <memory>
+
+PasswordVerifier::PasswordVerifier(unsigned threads) {
+    if (threads == 0) threads = thread::hardware_concurrency();
+    if (threads == 0) threads = 2;
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(&PasswordVerifier::work, this);
+    }
+}
+
+PasswordVerifier::~PasswordVerifier() {
+    {
+        lock_guard<mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void PasswordVerifier::work() {
+    for (;;) {
+        function<void()> job;
+        {
+            unique_lock<mutex> lock(jobMutex);
+            jobReady.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return;
+            job = move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+void PasswordVerifier::post(function<void()> job) {
+    {
+        lock_guard<mutex> lock(jobMutex);
+        jobs.push_back(move(job));
+    }
+    jobReady.notify_one();
+}
+
+future<bool> PasswordVerifier::verify(const string& password, const string& stored) {
+    auto task = make_shared<packaged_task<bool()>>([password, stored]() {
+        return PasswordHash::verify(password, stored);
+    });
+    future<bool> result = task->get_future();
+    post([task]() { (*task)(); });
+    return result;
+}
+
+future<string> PasswordVerifier::hash(const string& password) {
+    auto task = make_shared<packaged_task<string()>>([password]() {
+        return PasswordHash::hash(password);
+    });
+    future<string> result = task->get_future();
+    post([task]() { (*task)(); });
+    return result;
+}
+
+vector<string> PasswordVerifier::hashAll(const vector<string>& passwords) {
+    vector<future<string>> pending;
+    pending.reserve(passwords.size());
+    for (const auto& password : passwords) pending.push_back(hash(password));
+
+    vector<string> hashes;
+    hashes.reserve(passwords.size());
+    for (auto& result : pending) hashes.push_back(result.get());
+    return hashes;
+}
+
+unsigned PasswordVerifier::threadCount() const {
+    return (unsigned)workers.size();
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Fixed pool of threads for slow password work, so a server can keep
+// answering other requests while logins are checked, and bulk jobs like
+// migrating a whole user file use every core.
+class PasswordVerifier {
+public:
+    // 0 picks one thread per hardware thread
+    explicit PasswordVerifier(unsigned threads = 0);
+    ~PasswordVerifier();
+
+    future<bool> verify(const string& password, const string& stored);
+    future<string> hash(const string& password);
+    // Runs any job on the pool
+    void post(function<void()> job);
+
+    // Hashes every password, in parallel, keeping the order
+    vector<string> hashAll(const vector<string>& passwords);
+
+    unsigned threadCount() const;
+
+private:
+    vector<thread> workers;
+    deque<function<void()>> jobs;
+    mutex jobMutex;
+    condition_variable jobReady;
+    bool stopping = false;
+
+    void work();
+};
@@ -0,0 +1,199 @@
+#include "ReplicaFollower.hpp"
+#include "ReplicationLog.hpp"
+#include "SaveManager.hpp"
+#include <chrono>
+#include <iostream>
+#include <unordered_set>
+
+static const int ReadTimeoutMs = 100;
+static const int ReconnectDelayMs = 500;
+// The primary sends a heartbeat every 100 ms; this much silence means it is gone
+static const int IdleTimeoutMs = 2000;
+// Log entries applied under one OrderManager lock and snapshot
+static const size_t MaxBatch = 4096;
+
+ReplicaFollower::ReplicaFollower(OrderManager& manager, UserManager& userManager)
+    : manager(manager), userManager(userManager) {}
+
+ReplicaFollower::~ReplicaFollower() {
+    stop();
+}
+
+void ReplicaFollower::start(const string& primaryHost, uint16_t primaryPort, const string& user,
+                            const string& userPassword) {
+    stop();
+    host = primaryHost;
+    port = primaryPort;
+    username = user;
+    password = userPassword;
+    running = true;
+    worker = thread(&ReplicaFollower::run, this);
+}
+
+void ReplicaFollower::stop() {
+    running = false;
+    if (worker.joinable()) worker.join();
+}
+
+ReplicaFollower::Status ReplicaFollower::takeStatus() {
+    lock_guard<mutex> lock(statusMutex);
+    Status copy = status;
+    status.lag.clear();
+    return copy;
+}
+
+void ReplicaFollower::run() {
+    while (running) {
+        OrderClient client;
+        if (client.connect(host, port)) {
+            follow(client);
+            lock_guard<mutex> lock(statusMutex);
+            status.connected = false;
+        }
+        for (int waited = 0; running && waited < ReconnectDelayMs; waited += ReadTimeoutMs) {
+            this_thread::sleep_for(chrono::milliseconds(ReadTimeoutMs));
+        }
+    }
+}
+
+bool ReplicaFollower::follow(OrderClient& client) {
+    uint64_t applied;
+    uint64_t epoch;
+    {
+        lock_guard<mutex> lock(statusMutex);
+        applied = status.appliedLSN;
+        epoch = status.epoch;
+    }
+    // The primary streams only to an Editor session
+    string line;
+    if (!client.send("LOGIN," + SaveManager::escapeCSV(username) + "," + SaveManager::escapeCSV(password))) return false;
+    if (!client.readLine(line, IdleTimeoutMs)) return false;
+    if (line.compare(0, 3, "OK,") != 0) {
+        cerr << "Replica: primary refused login as " << username << ": " << line << endl;
+        return false;
+    }
+
+    // LSN 0 asks for a snapshot; so does an epoch the primary no longer has
+    if (!client.send("REPLICATE," + to_string(applied ? applied + 1 : 0) + "," + to_string(epoch))) return false;
+
+    if (!client.readLine(line, IdleTimeoutMs) || line.compare(0, 3, "OK,") != 0) {
+        if (line == "ERR,AUTH") cerr << "Replica: " << username << " may not replicate; it needs the Editor role" << endl;
+        return false;
+    }
+    vector<string> handshake = SaveManager::parseCSVLine(line);
+    if (handshake.size() < 3) return false;
+    // A restarted primary numbers its log from 1 again; nothing but a
+    // snapshot may be applied until we are in its epoch
+    bool sameEpoch;
+    try {
+        sameEpoch = stoull(handshake[2]) == epoch;
+        lock_guard<mutex> lock(statusMutex);
+        status.connected = true;
+        status.primaryLSN = stoull(handshake[1]);
+    } catch (const exception&) {
+        return false;
+    }
+
+    vector<ReplicatedOrder> batch;
+    vector<int64_t> stamps;
+    auto lastHeard = chrono::steady_clock::now();
+    while (running) {
+        if (!client.readLine(line, ReadTimeoutMs)) {
+            if (!client.isConnected()) return false;
+            if (chrono::steady_clock::now() - lastHeard > chrono::milliseconds(IdleTimeoutMs)) return false;
+            continue;
+        }
+        lastHeard = chrono::steady_clock::now();
+
+        // Gather every log line already received, then apply them together
+        batch.clear();
+        stamps.clear();
+        uint64_t batchEnd = applied;
+        uint64_t announced = 0;
+        do {
+            vector<string> fields = SaveManager::parseCSVLine(line);
+            try {
+                if (fields[0] == "L" && fields.size() >= 4) {
+                    if (!sameEpoch) return false;
+                    uint64_t lsn = stoull(fields[1]);
+                    if (lsn != batchEnd + 1) return false;   // gap: reconnect and resume
+                    applyRecord(fields, 3, batch);
+                    stamps.push_back(stoll(fields[2]));
+                    batchEnd = lsn;
+                } else if (fields[0] == "HB" && fields.size() >= 2) {
+                    announced = stoull(fields[1]);
+                } else if (fields[0] == "SNAPSHOT" && fields.size() >= 5) {
+                    if (!batch.empty()) manager.applyReplicated(batch);
+                    batch.clear();
+                    if (!bootstrap(client, fields)) return false;
+                    applied = batchEnd = stoull(fields[1]);
+                    sameEpoch = true;
+                    stamps.clear();
+                }
+            } catch (const exception&) {
+                cerr << "Replica: bad line from primary: " << line << endl;
+                return false;
+            }
+        } while (stamps.size() < MaxBatch && client.hasLine() && client.readLine(line, 0));
+
+        if (!batch.empty()) manager.applyReplicated(batch);
+        applied = batchEnd;
+
+        int64_t now = ReplicationLog::nowMicros();
+        lock_guard<mutex> lock(statusMutex);
+        status.appliedLSN = applied;
+        status.primaryLSN = max(status.primaryLSN, max(announced, applied));
+        for (int64_t stamp : stamps) {
+            status.lag.record(now > stamp ? (uint64_t)(now - stamp) * 1000 : 0);
+        }
+    }
+    return true;
+}
+
+// Replaces local state with the snapshot that follows a SNAPSHOT header.
+// Rows overwrite local orders whatever their versions: those may come from
+// an earlier run of the primary, whose versions started over.
+bool ReplicaFollower::bootstrap(OrderClient& client, const vector<string>& header) {
+    uint64_t lsn = stoull(header[1]);
+    int users = stoi(header[2]);
+    int orders = stoi(header[3]);
+    uint64_t epoch = stoull(header[4]);
+
+    vector<ReplicatedOrder> batch;
+    string line;
+    for (int i = 0; i < users + orders; ++i) {
+        if (!client.readLine(line, IdleTimeoutMs)) return false;
+        applyRecord(SaveManager::parseCSVLine(line), 0, batch);
+    }
+    // Orders deleted on the primary while we were away
+    unordered_set<int> present;
+    for (const auto& row : batch) present.insert(row.order.orderID);
+    for (const auto& order : manager.snapshot()->orders) {
+        if (!present.count(order->orderID)) batch.push_back({ true, *order });
+    }
+    manager.applyReplicated(batch, true);
+
+    lock_guard<mutex> lock(statusMutex);
+    status.appliedLSN = lsn;
+    status.epoch = epoch;
+    status.bootstraps++;
+    return true;
+}
+
+// Users are registered straight away; order rows are queued on batch
+void ReplicaFollower::applyRecord(const vector<string>& fields, size_t first, vector<ReplicatedOrder>& batch) {
+    vector<string> record(fields.begin() + first, fields.end());
+    if (record[0] == "ORDER" && record.size() >= 12) {
+        Order order(0, "", OrderKind::Other, chrono::system_clock::time_point());
+        if (SaveManager::orderFromCSV(record, order)) {
+            order.version = stoull(record[11]);
+            batch.push_back({ false, move(order) });
+        }
+    } else if (record[0] == "REMOVED" && record.size() >= 2) {
+        Order order(stoi(record[1]), "", OrderKind::Other, chrono::system_clock::time_point());
+        batch.push_back({ true, move(order) });
+    } else if (record[0] == "USER" && record.size() >= 5) {
+        user::Role role = (record[4] == "Editor") ? user::Role::Editor : user::Role::Customer;
+        userManager.restoreUser(SaveManager::unescapeCSV(record[2]), SaveManager::unescapeCSV(record[3]), role);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "OrderManager.hpp"
+#include "UserManager.hpp"
+#include "OrderClient.hpp"
+#include "LatencyHistogram.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+using namespace std;
+
+// Keeps a local OrderManager/UserManager in step with a primary
+// desainin-server over REPLICATE (see OrderService). Starts from a snapshot,
+// then applies the primary's log, a batch of already-received entries at a
+// time so each batch costs one snapshot; after a dropped connection it reconnects
+// and resumes from the last applied LSN, as long as the primary is still in
+// the same epoch (has not restarted). The primary only streams to an Editor,
+// so every connection logs in with the given account first. The managers
+// should start empty and only be written by the follower, e.g. behind a
+// read-only OrderService.
+class ReplicaFollower {
+public:
+    struct Status {
+        bool connected = false;
+        uint64_t appliedLSN = 0;
+        uint64_t primaryLSN = 0;    // newest LSN the primary has announced
+        uint64_t epoch = 0;         // primary run appliedLSN belongs to, 0 before the first snapshot
+        uint64_t bootstraps = 0;
+        // Primary log append to local apply, per entry, since the last report
+        LatencyHistogram lag;
+    };
+
+    ReplicaFollower(OrderManager& manager, UserManager& userManager);
+    ~ReplicaFollower();
+
+    void start(const string& host, uint16_t port, const string& username, const string& password);
+    void stop();
+
+    // Current status; clears the lag histogram for the next interval
+    Status takeStatus();
+
+private:
+    OrderManager& manager;
+    UserManager& userManager;
+    string host;
+    uint16_t port = 0;
+    string username;
+    string password;
+    atomic<bool> running{ false };
+    thread worker;
+
+    mutable mutex statusMutex;
+    Status status;
+
+    void run();
+    // Returns false when the stream broke and has to be reopened
+    bool follow(OrderClient& client);
+    bool bootstrap(OrderClient& client, const vector<string>& header);
+    void applyRecord(const vector<string>& fields, size_t first, vector<ReplicatedOrder>& batch);
+};
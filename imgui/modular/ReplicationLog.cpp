@@ -0,0 +1,44 @@
+#include "ReplicationLog.hpp"
+#include <chrono>
+#include <random>
+
+// Never 0, which followers send before their first handshake
+ReplicationLog::ReplicationLog(size_t capacity) : capacity(capacity) {
+    random_device seed;
+    mt19937_64 rng(((uint64_t)seed() << 32) ^ seed() ^ (uint64_t)nowMicros());
+    do {
+        runEpoch = rng();
+    } while (runEpoch == 0);
+}
+
+uint64_t ReplicationLog::append(string record) {
+    entries.push_back({ ++headLSN, nowMicros(), move(record) });
+    if (entries.size() > capacity) entries.pop_front();
+    return headLSN;
+}
+
+void ReplicationLog::truncate() {
+    entries.clear();
+    headLSN++;
+}
+
+uint64_t ReplicationLog::epoch() const {
+    return runEpoch;
+}
+
+uint64_t ReplicationLog::head() const {
+    return headLSN;
+}
+
+uint64_t ReplicationLog::first() const {
+    return entries.empty() ? headLSN + 1 : entries.front().lsn;
+}
+
+const ReplicationLog::Entry& ReplicationLog::at(uint64_t lsn) const {
+    return entries[(size_t)(lsn - entries.front().lsn)];
+}
+
+int64_t ReplicationLog::nowMicros() {
+    return chrono::duration_cast<chrono::microseconds>(
+        chrono::system_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+using namespace std;
+
+// Bounded in-memory log of replicated records (savedata-style USER/ORDER
+// rows and REMOVED,orderID), numbered by log sequence number (LSN) from 1.
+// Followers resume from any LSN still retained; one that falls further
+// behind, or asks after truncate(), is bootstrapped from a snapshot instead.
+// LSNs and order versions start over when the primary restarts, so every log
+// also carries a random epoch, and a follower that last saw another epoch is
+// bootstrapped too.
+class ReplicationLog {
+public:
+    struct Entry {
+        uint64_t lsn;
+        int64_t timestampMicros;    // system clock at append, for lag measurement
+        string record;
+    };
+
+    explicit ReplicationLog(size_t capacity = 65536);
+
+    uint64_t append(string record);
+    // Drops every retained entry and skips one LSN, so that every follower,
+    // including ones fully caught up, re-bootstraps. Used when changes went
+    // unrecorded.
+    void truncate();
+
+    uint64_t epoch() const;
+    // LSN of the newest entry, 0 before the first append
+    uint64_t head() const;
+    // Oldest retained LSN; head() + 1 when nothing is retained
+    uint64_t first() const;
+    // lsn must lie in [first(), head()]
+    const Entry& at(uint64_t lsn) const;
+
+    static int64_t nowMicros();
+
+private:
+    deque<Entry> entries;
+    size_t capacity;
+    uint64_t headLSN = 0;
+    uint64_t runEpoch;
+};
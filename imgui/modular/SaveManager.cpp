@@ -1,4 +1,7 @@
 #include "SaveManager.hpp"
+#include "PasswordHash.hpp"
+#include "PasswordVerifier.hpp"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <chrono>
@@ -77,6 +80,48 @@ vector<string> SaveManager::parseCSVLine(const string& line) {
 }
 
 
+string SaveManager::orderToCSV(const Order& order) {
+    return "ORDER," + to_string(order.orderID) + ","
+         + escapeCSV(order.orderName) + ","
+         + Order::statusToString(order.status) + ","
+         + Order::kindToString(order.orderKind) + ","
+         + Order::deadlineToString(order.deadline) + ","
+         + escapeCSV(order.reference) + ","
+         + escapeCSV(order.extras) + ","
+         + escapeCSV(order.editorAssigned) + ","
+         + escapeCSV(order.finalLink) + ","
+         + to_string(order.customerID);
+}
+
+string SaveManager::userToCSV(const user& u) {
+    string roleStr = (u.getRole() == user::Role::Customer) ? "Customer" : "Editor";
+    return "USER," + to_string(u.getUserID()) + ","
+         + escapeCSV(u.getUsername()) + ","
+         + escapeCSV(u.getPassword()) + ","
+         + roleStr;
+}
+
+bool SaveManager::orderFromCSV(const vector<string>& fields, Order& order) {
+    if (fields.size() < 11 || fields[0] != "ORDER") return false;
+    try {
+        order.orderID = stoi(fields[1]);
+        order.customerID = stoi(fields[10]);
+    } catch (const exception&) {
+        return false;
+    }
+    if (!Order::deadlineFromString(fields[5], order.deadline)) return false;
+
+    order.orderName = unescapeCSV(fields[2]);
+    order.status = Order::statusFromString(fields[3]);
+    order.orderKind = Order::kindFromString(fields[4]);
+    order.reference = unescapeCSV(fields[6]);
+    order.extras = unescapeCSV(fields[7]);
+    order.editorAssigned = unescapeCSV(fields[8]);
+    order.finalLink = unescapeCSV(fields[9]);
+    return true;
+}
+
+
 bool SaveManager::saveToFile(const string& filename, const OrderManager& manager, const UserManager& userManager) {
     try {
         ofstream file(filename);
@@ -92,11 +137,7 @@ bool SaveManager::saveToFile(const string& filename, const OrderManager& manager
        
         const auto& users = userManager.getAllUsers();
         for (const auto& user : users) {
-            string roleStr = (user.getRole() == user::Role::Customer) ? "Customer" : "Editor";
-            file << "USER," << user.getUserID() << "," 
-                 << escapeCSV(user.getUsername()) << "," 
-                 << escapeCSV(user.getPassword()) << "," 
-                 << roleStr << "\n";
+            file << userToCSV(user) << "\n";
         }
         
     
@@ -104,43 +145,9 @@ bool SaveManager::saveToFile(const string& filename, const OrderManager& manager
         file << "TYPE,ORDERID,ORDERNAME,STATUS,ORDERTYPE,DEADLINE,REFERENCE,EXTRAS,EDITOR_ASSIGNED,FINALLINK,CUSTOMERID\n";
         
      
-        const auto& orders = manager.getOrders();
-        for (const auto& order : orders) {
-            string statusStr;
-            switch (order.status) {
-                case OrderStatus::Pending: statusStr = "Pending"; break;
-                case OrderStatus::InProgress: statusStr = "InProgress"; break;
-                case OrderStatus::Completed: statusStr = "Completed"; break;
-                case OrderStatus::Cancelled: statusStr = "Cancelled"; break;
-                default: statusStr = "Pending";
-            }
-            
-            string kindStr;
-            switch (order.orderKind) {
-                case OrderKind::Logo: kindStr = "Logo"; break;
-                case OrderKind::Status: kindStr = "Status"; break;
-                case OrderKind::Feed: kindStr = "Feed"; break;
-                case OrderKind::Asset: kindStr = "Asset"; break;
-                case OrderKind::Document: kindStr = "Document"; break;
-                case OrderKind::Other: kindStr = "Other"; break;
-                default: kindStr = "Other";
-            }
-            
-         
-            auto deadline_time = chrono::system_clock::to_time_t(order.deadline);
-            char deadline_str[20];
-            strftime(deadline_str, sizeof(deadline_str), "%Y-%m-%d", localtime(&deadline_time));
-            
-            file << "ORDER," << order.orderID << "," 
-                 << escapeCSV(order.orderName) << "," 
-                 << statusStr << "," 
-                 << kindStr << "," 
-                 << deadline_str << "," 
-                 << escapeCSV(order.reference) << "," 
-                 << escapeCSV(order.extras) << "," 
-                 << escapeCSV(order.editorAssigned) << "," 
-                 << escapeCSV(order.finalLink) << "," 
-                 << order.customerID << "\n";
+        auto view = manager.snapshot();
+        for (const auto& order : view->orders) {
+            file << orderToCSV(*order) << "\n";
         }
         
         file.close();
@@ -163,10 +170,26 @@ bool SaveManager::loadFromFile(const string& filename, OrderManager& manager, Us
         }
         
         string line;
+        vector<string> usernames;
+        vector<string> passwords;
+        vector<user::Role> roles;
+        // Orders go in through addOrders, a batch at a time, so loading is
+        // not one snapshot copy per order
+        const size_t OrderBatch = 4096;
+        vector<Order> orders;
+        vector<size_t> duplicates;
         bool readingUsers = false;
         bool readingOrders = false;
         
         while (getline(file, line)) {
+            // Files saved on Windows end their lines in \r\n
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            // escapeCSV keeps newlines inside quotes; read on until they close
+            string more;
+            while (count(line.begin(), line.end(), '"') % 2 == 1 && getline(file, more)) {
+                if (!more.empty() && more.back() == '\r') more.pop_back();
+                line += '\n' + more;
+            }
            
             if (line.empty() || line[0] == '#') continue;
             
@@ -197,62 +220,51 @@ bool SaveManager::loadFromFile(const string& filename, OrderManager& manager, Us
                 user::Role role = (roleStr == "Editor") ? user::Role::Editor : user::Role::Customer;
                 
         
-                userManager.registerUser(username, password, role);
+                usernames.push_back(username);
+                passwords.push_back(password);
+                roles.push_back(role);
             } 
             else if (fields[0] == "ORDER" && fields.size() >= 11) {
-                int orderID = stoi(fields[1]);
-                string orderName = unescapeCSV(fields[2]);
-                string statusStr = fields[3];
-                string kindStr = fields[4];
-                string deadlineStr = fields[5];
-                string reference = unescapeCSV(fields[6]);
-                string extras = unescapeCSV(fields[7]);
-                string editorAssigned = unescapeCSV(fields[8]);
-                string finalLink = unescapeCSV(fields[9]);
-                int customerID = stoi(fields[10]);
-                
-        
-                OrderStatus status = OrderStatus::Pending;
-                if (statusStr == "InProgress") status = OrderStatus::InProgress;
-                else if (statusStr == "Completed") status = OrderStatus::Completed;
-                else if (statusStr == "Cancelled") status = OrderStatus::Cancelled;
-                
-       
-                OrderKind kind = OrderKind::Other;
-                if (kindStr == "Logo") kind = OrderKind::Logo;
-                else if (kindStr == "Status") kind = OrderKind::Status;
-                else if (kindStr == "Feed") kind = OrderKind::Feed;
-                else if (kindStr == "Asset") kind = OrderKind::Asset;
-                else if (kindStr == "Document") kind = OrderKind::Document;
-                
-           
-                int year, month, day;
-                if (sscanf(deadlineStr.c_str(), "%d-%d-%d", &year, &month, &day) == 3) {
-                    struct tm deadline_tm = {};
-                    deadline_tm.tm_year = year - 1900;
-                    deadline_tm.tm_mon = month - 1;
-                    deadline_tm.tm_mday = day;
-                    deadline_tm.tm_hour = 0;
-                    deadline_tm.tm_min = 0;
-                    deadline_tm.tm_sec = 0;
-                    time_t deadline_time = mktime(&deadline_tm);
-                    auto deadline = chrono::system_clock::from_time_t(deadline_time);
-                    
-               
-                    Order newOrder(orderID, orderName, kind, deadline);
-                    newOrder.status = status;
-                    newOrder.reference = reference;
-                    newOrder.extras = extras;
-                    newOrder.editorAssigned = editorAssigned;
-                    newOrder.finalLink = finalLink;
-                    newOrder.customerID = customerID;
-                    
-                    manager.addOrder(newOrder);
+                Order newOrder(0, "", OrderKind::Other, chrono::system_clock::time_point());
+                if (orderFromCSV(fields, newOrder)) {
+                    orders.push_back(move(newOrder));
+                    if (orders.size() == OrderBatch) {
+                        manager.addOrders(orders, duplicates);
+                        orders.clear();
+                    }
                 }
             }
         }
         
         file.close();
+        manager.addOrders(orders, duplicates);
+        if (!duplicates.empty()) {
+            cerr << "Warning: Skipped " << duplicates.size() << " order(s) with a duplicate ID" << endl;
+        }
+
+        // Files written before passwords were hashed hold plaintext; hash
+        // those now, spread over all cores since each hash is slow
+        vector<string> plaintext;
+        for (const auto& password : passwords) {
+            if (!PasswordHash::isHashed(password)) plaintext.push_back(password);
+        }
+        if (!plaintext.empty()) {
+            PasswordVerifier pool;
+            vector<string> hashed = pool.hashAll(plaintext);
+            size_t next = 0;
+            for (auto& password : passwords) {
+                if (!PasswordHash::isHashed(password)) password = hashed[next++];
+            }
+            cout << "Migrated " << plaintext.size() << " plaintext password(s) to hashes" << endl;
+        }
+        for (size_t i = 0; i < usernames.size(); ++i) {
+            userManager.restoreUser(usernames[i], passwords[i], roles[i]);
+        }
+
+        // Loaded orders are the starting point, not something to undo, and
+        // the ones already overdue are not news
+        manager.clearHistory();
+        manager.markOverdueReported(chrono::system_clock::now());
         cout << "Data loaded successfully from " << filename << endl;
         return true;
         
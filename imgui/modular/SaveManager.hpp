@@ -12,9 +12,15 @@ public:
     // Load all data from CSV file
     static bool loadFromFile(const std::string& filename, OrderManager& manager, UserManager& userManager);
     
-private:
     // Helper functions for CSV operations
     static std::string escapeCSV(const std::string& field);
     static std::string unescapeCSV(const std::string& field);
     static std::vector<std::string> parseCSVLine(const std::string& line);
+
+    // One ORDER row as written to the save file (no trailing newline)
+    static std::string orderToCSV(const Order& order);
+    // USER row in the same layout, also without a trailing newline
+    static std::string userToCSV(const user& u);
+    // Parses the fields of an ORDER row, false if the row is malformed
+    static bool orderFromCSV(const std::vector<std::string>& fields, Order& order);
 };
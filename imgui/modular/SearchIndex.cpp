@@ -0,0 +1,438 @@
+#include "SearchIndex.hpp"
+#include <algorithm>
+#include <climits>
+
+static const int FieldWeights[] = { 3, 2, 1 };
+
+// A whole-word hit in a field scores 2 * weight, any hit (also inside a
+// longer word) another weight
+static const int WordHitFactor = 3;
+
+static bool isWordByte(unsigned char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c >= 0x80;
+}
+
+string SearchIndex::toLower(const string& text) {
+    string result = text;
+    for (auto& c : result) {
+        if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
+    }
+    return result;
+}
+
+uint32_t SearchIndex::trigramKey(const char* p) {
+    return ((uint32_t)(unsigned char)p[0] << 16) | ((uint32_t)(unsigned char)p[1] << 8) | (uint32_t)(unsigned char)p[2];
+}
+
+// Splits on anything that is not a letter or digit; bytes >= 0x80 are kept
+// so UTF-8 names stay searchable.
+vector<string> SearchIndex::tokenize(const string& text) {
+    vector<string> tokens;
+    string current;
+    for (char ch : text) {
+        unsigned char c = (unsigned char)ch;
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c >= 0x80) {
+            current += ch;
+        } else if (c >= 'A' && c <= 'Z') {
+            current += (char)(c - 'A' + 'a');
+        } else if (!current.empty()) {
+            tokens.push_back(current);
+            current.clear();
+        }
+    }
+    if (!current.empty()) tokens.push_back(current);
+    return tokens;
+}
+
+void SearchIndex::fieldTerms(const string& text, FieldTerms& terms) {
+    terms.words = tokenize(text);
+    terms.trigrams.clear();
+    for (auto& word : terms.words) {
+        for (size_t i = 0; i + 3 <= word.size(); i++) {
+            terms.trigrams.push_back(trigramKey(word.data() + i));
+        }
+    }
+    sort(terms.words.begin(), terms.words.end());
+    terms.words.erase(unique(terms.words.begin(), terms.words.end()), terms.words.end());
+    sort(terms.trigrams.begin(), terms.trigrams.end());
+    terms.trigrams.erase(unique(terms.trigrams.begin(), terms.trigrams.end()), terms.trigrams.end());
+}
+
+// Order IDs mostly arrive in increasing order, so this is usually a push_back
+void SearchIndex::insertID(Posting& posting, int orderID) {
+    if (posting.empty() || posting.back() < orderID) {
+        posting.push_back(orderID);
+        return;
+    }
+    auto it = lower_bound(posting.begin(), posting.end(), orderID);
+    if (*it != orderID) posting.insert(it, orderID);
+}
+
+void SearchIndex::eraseID(Posting& posting, int orderID) {
+    auto it = lower_bound(posting.begin(), posting.end(), orderID);
+    if (it != posting.end() && *it == orderID) posting.erase(it);
+}
+
+// Appends sorted, unique IDs of orders not in the posting yet
+static void appendIDs(vector<int>& posting, const int* ids, size_t count) {
+    size_t old = posting.size();
+    posting.insert(posting.end(), ids, ids + count);
+    if (old > 0 && posting[old - 1] > ids[0]) {
+        inplace_merge(posting.begin(), posting.begin() + old, posting.end());
+    }
+}
+
+void SearchIndex::indexField(int orderID, int field, const FieldTerms& terms) {
+    for (auto& word : terms.words) insertID(wordPostings[field][word], orderID);
+    for (auto key : terms.trigrams) insertID(trigramPostings[field][key], orderID);
+}
+
+void SearchIndex::unindexField(int orderID, int field, const FieldTerms& terms) {
+    for (auto& word : terms.words) {
+        auto posting = wordPostings[field].find(word);
+        if (posting == wordPostings[field].end()) continue;
+        eraseID(posting->second, orderID);
+        if (posting->second.empty()) wordPostings[field].erase(posting);
+    }
+    for (auto key : terms.trigrams) {
+        auto posting = trigramPostings[field].find(key);
+        if (posting == trigramPostings[field].end()) continue;
+        eraseID(posting->second, orderID);
+        if (posting->second.empty()) trigramPostings[field].erase(posting);
+    }
+}
+
+void SearchIndex::addOrder(const Order& order) {
+    if (documents.count(order.orderID)) {
+        updateOrder(order);
+        return;
+    }
+
+    purgeRemoved(order.orderID);
+    Document& doc = documents[order.orderID];
+    const string* fields[FieldCount] = { &order.orderName, &order.reference, &order.extras };
+    FieldTerms terms;
+    for (int f = 0; f < FieldCount; f++) {
+        doc.text[f] = toLower(*fields[f]);
+        fieldTerms(doc.text[f], terms);
+        indexField(order.orderID, f, terms);
+    }
+}
+
+void SearchIndex::addOrders(const vector<const Order*>& batch) {
+    documents.reserve(documents.size() + batch.size());
+    unordered_map<string, vector<int>> words[FieldCount];
+    vector<pair<uint32_t, int>> trigrams[FieldCount];
+    FieldTerms terms;
+    for (const Order* order : batch) {
+        if (documents.count(order->orderID)) {
+            updateOrder(*order);
+            continue;
+        }
+        purgeRemoved(order->orderID);
+        Document& doc = documents[order->orderID];
+        const string* fields[FieldCount] = { &order->orderName, &order->reference, &order->extras };
+        for (int f = 0; f < FieldCount; f++) {
+            doc.text[f] = toLower(*fields[f]);
+            fieldTerms(doc.text[f], terms);
+            for (auto& word : terms.words) words[f][word].push_back(order->orderID);
+            for (auto key : terms.trigrams) trigrams[f].emplace_back(key, order->orderID);
+        }
+    }
+
+    for (int f = 0; f < FieldCount; f++) {
+        for (auto& entry : words[f]) {
+            vector<int>& ids = entry.second;
+            if (!is_sorted(ids.begin(), ids.end())) sort(ids.begin(), ids.end());
+            appendIDs(wordPostings[f][entry.first], ids.data(), ids.size());
+        }
+        // Sorted by trigram, then order ID: each run is one posting's new IDs
+        vector<pair<uint32_t, int>>& pairs = trigrams[f];
+        sort(pairs.begin(), pairs.end());
+        vector<int> ids;
+        for (size_t i = 0; i < pairs.size();) {
+            size_t end = i;
+            ids.clear();
+            while (end < pairs.size() && pairs[end].first == pairs[i].first) ids.push_back(pairs[end++].second);
+            appendIDs(trigramPostings[f][pairs[i].first], ids.data(), ids.size());
+            i = end;
+        }
+    }
+}
+
+// Erasing from the middle of the long postings of common words and
+// trigrams is slow, so the order is only marked removed here
+void SearchIndex::removeOrder(int orderID) {
+    auto it = documents.find(orderID);
+    if (it == documents.end()) return;
+
+    removedDocuments[orderID] = move(it->second);
+    documents.erase(it);
+    insertID(removedIDs, orderID);
+    if (removedIDs.size() >= 1024 && removedIDs.size() * 16 >= documents.size()) compact();
+}
+
+// An order added again must not be found through its old words
+void SearchIndex::purgeRemoved(int orderID) {
+    auto it = removedDocuments.find(orderID);
+    if (it == removedDocuments.end()) return;
+
+    FieldTerms terms;
+    for (int f = 0; f < FieldCount; f++) {
+        fieldTerms(it->second.text[f], terms);
+        unindexField(orderID, f, terms);
+    }
+    eraseID(removedIDs, orderID);
+    removedDocuments.erase(it);
+}
+
+// Sweeps every removed order out of all postings in one pass
+void SearchIndex::compact() {
+    auto sweep = [this](Posting& posting) {
+        size_t kept = 0;
+        auto removed = removedIDs.begin();
+        for (int id : posting) {
+            removed = lower_bound(removed, removedIDs.end(), id);
+            if (removed != removedIDs.end() && *removed == id) continue;
+            posting[kept++] = id;
+        }
+        posting.resize(kept);
+    };
+    for (int f = 0; f < FieldCount; f++) {
+        for (auto it = wordPostings[f].begin(); it != wordPostings[f].end();) {
+            sweep(it->second);
+            it = it->second.empty() ? wordPostings[f].erase(it) : next(it);
+        }
+        for (auto it = trigramPostings[f].begin(); it != trigramPostings[f].end();) {
+            sweep(it->second);
+            it = it->second.empty() ? trigramPostings[f].erase(it) : next(it);
+        }
+    }
+    removedIDs.clear();
+    removedDocuments.clear();
+}
+
+// Only the words and trigrams that differ between the old and new text are
+// touched, so editing a name leaves the long postings of common words alone
+void SearchIndex::updateOrder(const Order& order) {
+    auto it = documents.find(order.orderID);
+    if (it == documents.end()) {
+        addOrder(order);
+        return;
+    }
+
+    Document& doc = it->second;
+    const string* fields[FieldCount] = { &order.orderName, &order.reference, &order.extras };
+    FieldTerms before, after, removed, added;
+    for (int f = 0; f < FieldCount; f++) {
+        string text = toLower(*fields[f]);
+        if (text == doc.text[f]) continue;
+        fieldTerms(doc.text[f], before);
+        fieldTerms(text, after);
+        removed.words.clear();
+        removed.trigrams.clear();
+        added.words.clear();
+        added.trigrams.clear();
+        set_difference(before.words.begin(), before.words.end(), after.words.begin(), after.words.end(), back_inserter(removed.words));
+        set_difference(before.trigrams.begin(), before.trigrams.end(), after.trigrams.begin(), after.trigrams.end(), back_inserter(removed.trigrams));
+        set_difference(after.words.begin(), after.words.end(), before.words.begin(), before.words.end(), back_inserter(added.words));
+        set_difference(after.trigrams.begin(), after.trigrams.end(), before.trigrams.begin(), before.trigrams.end(), back_inserter(added.trigrams));
+        unindexField(order.orderID, f, removed);
+        indexField(order.orderID, f, added);
+        doc.text[f] = move(text);
+    }
+}
+
+void SearchIndex::clear() {
+    documents.clear();
+    removedDocuments.clear();
+    removedIDs.clear();
+    for (int f = 0; f < FieldCount; f++) {
+        wordPostings[f].clear();
+        trigramPostings[f].clear();
+    }
+}
+
+int SearchIndex::scoreTerm(const Document& doc, const string& term) const {
+    int score = 0;
+    for (int f = 0; f < FieldCount; f++) {
+        const string& text = doc.text[f];
+        size_t pos = text.find(term);
+        if (pos == string::npos) continue;
+        score += FieldWeights[f];
+        for (; pos != string::npos; pos = text.find(term, pos + 1)) {
+            size_t end = pos + term.size();
+            if ((pos == 0 || !isWordByte((unsigned char)text[pos - 1])) && (end == text.size() || !isWordByte((unsigned char)text[end]))) {
+                score += FieldWeights[f] * 2;
+                break;
+            }
+        }
+    }
+    return score;
+}
+
+// Position in one posting, only ever moved forward
+struct ListCursor {
+    const vector<int>* list;
+    size_t pos;
+
+    // First ID >= id, or INT_MAX past the end. Gallops, so skipping far
+    // ahead in a long posting takes a logarithmic number of steps.
+    int seek(int id) {
+        const vector<int>& l = *list;
+        if (pos < l.size() && l[pos] >= id) return l[pos];
+        size_t lo = pos, step = 1;
+        while (lo + step < l.size() && l[lo + step] < id) {
+            lo += step;
+            step *= 2;
+        }
+        pos = lower_bound(l.begin() + lo, l.begin() + min(lo + step + 1, l.size()), id) - l.begin();
+        return pos < l.size() ? l[pos] : INT_MAX;
+    }
+};
+
+// One query term. Per field: its whole-word posting, and the postings of its
+// trigrams, whose intersection holds every order that may contain the term
+// inside a longer word. Terms under 3 characters only match whole words,
+// but may still also appear inside words of the other fields.
+struct SearchIndex::TermCursor {
+    bool trigramsKnown;
+    bool hasWord[FieldCount];
+    ListCursor word[FieldCount];
+    vector<ListCursor> trigrams[FieldCount];   // rarest first; empty if the field cannot match
+    int maxScore;
+
+    int nextInField(int f, int id) {
+        if (!trigramsKnown) return hasWord[f] ? word[f].seek(id) : INT_MAX;
+        vector<ListCursor>& lists = trigrams[f];
+        if (lists.empty()) return INT_MAX;
+        for (;;) {
+            bool agree = true;
+            for (auto& list : lists) {
+                int at = list.seek(id);
+                if (at == INT_MAX) return INT_MAX;
+                if (at != id) {
+                    id = at;
+                    agree = false;
+                }
+            }
+            if (agree) return id;
+        }
+    }
+
+    // First order >= id that may match the term in some field
+    int next(int id) {
+        int best = INT_MAX;
+        for (int f = 0; f < FieldCount; f++) best = min(best, nextInField(f, id));
+        return best;
+    }
+
+    // Score bounds for an order the term may match; low == high when exact
+    void bounds(int id, int& low, int& high) {
+        for (int f = 0; f < FieldCount; f++) {
+            if (hasWord[f] && word[f].seek(id) == id) {
+                low += FieldWeights[f] * WordHitFactor;
+                high += FieldWeights[f] * WordHitFactor;
+            } else if (!trigramsKnown || nextInField(f, id) == id) {
+                high += FieldWeights[f];
+            }
+        }
+    }
+};
+
+vector<SearchIndex::Result> SearchIndex::search(const string& query, size_t maxResults) const {
+    vector<Result> results;
+    vector<string> terms = tokenize(query);
+    if (terms.empty() || maxResults == 0) return results;
+
+    vector<TermCursor> cursors(terms.size());
+    int maxPossible = 0;
+    for (size_t t = 0; t < terms.size(); t++) {
+        const string& term = terms[t];
+        TermCursor& cursor = cursors[t];
+        cursor.trigramsKnown = term.size() >= 3;
+        cursor.maxScore = 0;
+        bool anyWord = false;
+        for (int f = 0; f < FieldCount; f++) {
+            auto word = wordPostings[f].find(term);
+            cursor.hasWord[f] = word != wordPostings[f].end();
+            cursor.word[f] = { cursor.hasWord[f] ? &word->second : nullptr, 0 };
+            anyWord |= cursor.hasWord[f];
+            if (cursor.trigramsKnown) {
+                for (size_t i = 0; i + 3 <= term.size(); i++) {
+                    auto it = trigramPostings[f].find(trigramKey(term.data() + i));
+                    if (it == trigramPostings[f].end()) {
+                        cursor.trigrams[f].clear();
+                        break;
+                    }
+                    cursor.trigrams[f].push_back({ &it->second, 0 });
+                }
+                sort(cursor.trigrams[f].begin(), cursor.trigrams[f].end(), [](const ListCursor& a, const ListCursor& b) {
+                    return a.list->size() < b.list->size();
+                });
+            }
+            if (cursor.hasWord[f]) cursor.maxScore += FieldWeights[f] * WordHitFactor;
+            else if (!cursor.trigramsKnown || !cursor.trigrams[f].empty()) cursor.maxScore += FieldWeights[f];
+        }
+        if (cursor.trigramsKnown ? cursor.maxScore == 0 : !anyWord) return results;
+        maxPossible += cursor.maxScore;
+    }
+
+    // Best maxResults on a heap whose front is the worst kept result. Orders
+    // come in increasing ID order, so a later one only gets in with a higher
+    // score than that.
+    auto better = [](const Result& a, const Result& b) {
+        return a.score != b.score ? a.score > b.score : a.orderID < b.orderID;
+    };
+    ListCursor removed = { &removedIDs, 0 };
+    int id = INT_MIN;
+    for (;;) {
+        // Leapfrog to the next order every term may match
+        size_t agreed = 0;
+        for (size_t t = 0; agreed < cursors.size(); t = (t + 1) % cursors.size()) {
+            int at = cursors[t].next(id);
+            if (at == INT_MAX) break;
+            if (at == id) {
+                agreed++;
+            } else {
+                id = at;
+                agreed = 1;
+            }
+        }
+        if (agreed < cursors.size()) break;
+
+        if (removed.seek(id) != id) {
+            int low = 0, high = 0;
+            for (auto& cursor : cursors) cursor.bounds(id, low, high);
+            bool full = results.size() == maxResults;
+            if (!full || high > results.front().score) {
+                // Hits inside longer words are only candidates: check the text
+                int score = low;
+                if (low != high) {
+                    const Document& doc = documents.at(id);
+                    score = 0;
+                    for (auto& term : terms) {
+                        int termScore = scoreTerm(doc, term);
+                        if (termScore == 0) { score = 0; break; }
+                        score += termScore;
+                    }
+                }
+                if (score > 0 && !full) {
+                    results.push_back({ id, score });
+                    push_heap(results.begin(), results.end(), better);
+                } else if (score > 0 && score > results.front().score) {
+                    pop_heap(results.begin(), results.end(), better);
+                    results.back() = { id, score };
+                    push_heap(results.begin(), results.end(), better);
+                }
+            }
+            // Nothing later can beat what is kept
+            if (results.size() == maxResults && results.front().score >= maxPossible) break;
+        }
+        if (id == INT_MAX - 1) break;
+        id++;
+    }
+
+    sort_heap(results.begin(), results.end(), better);
+    return results;
+}
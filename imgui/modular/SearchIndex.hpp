@@ -0,0 +1,75 @@
+#pragma once
+#include "order.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Incremental inverted index over orderName, reference and extras.
+// Whole words are looked up directly, longer query terms also match
+// inside words through a trigram index.
+//
+// Postings are sorted vectors of order IDs, kept per field. A query walks
+// them together in ID order, leapfrogging between terms, and most scores
+// follow from which lists an order is in; only hits inside longer words are
+// checked against the text. The walk stops once the kept results can no
+// longer be beaten, so common terms cost about as much as rare ones.
+// Removed orders stay in the postings, skipped, until enough piled up to
+// sweep them out in one pass.
+class SearchIndex {
+public:
+    struct Result {
+        int orderID;
+        int score;
+    };
+
+    void addOrder(const Order& order);
+    // Bulk addOrder for orders not indexed yet: postings are gathered per
+    // word first, so each posting list grows once per batch
+    void addOrders(const vector<const Order*>& batch);
+    void removeOrder(int orderID);
+    void updateOrder(const Order& order);
+    void clear();
+
+    // Orders matching every term of the query, best matches first
+    vector<Result> search(const string& query, size_t maxResults = 100) const;
+
+    static vector<string> tokenize(const string& text);
+
+private:
+    enum Field { Name, Reference, Extras, FieldCount };
+
+    // Lowercased field text, used to verify substring matches. Words and
+    // trigrams are derived from it again when the order is removed.
+    struct Document {
+        string text[FieldCount];
+    };
+
+    // Sorted, unique words and trigrams of one field
+    struct FieldTerms {
+        vector<string> words;
+        vector<uint32_t> trigrams;
+    };
+
+    using Posting = vector<int>;
+    struct TermCursor;
+
+    unordered_map<int, Document> documents;
+    unordered_map<string, Posting> wordPostings[FieldCount];
+    unordered_map<uint32_t, Posting> trigramPostings[FieldCount];
+    // Removed orders still listed in the postings, until compact()
+    unordered_map<int, Document> removedDocuments;
+    Posting removedIDs;
+
+    static string toLower(const string& text);
+    static uint32_t trigramKey(const char* p);
+    static void fieldTerms(const string& text, FieldTerms& terms);
+    static void insertID(Posting& posting, int orderID);
+    static void eraseID(Posting& posting, int orderID);
+    void indexField(int orderID, int field, const FieldTerms& terms);
+    void unindexField(int orderID, int field, const FieldTerms& terms);
+    void purgeRemoved(int orderID);
+    void compact();
+    int scoreTerm(const Document& doc, const string& term) const;
+};
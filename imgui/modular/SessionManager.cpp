@@ -0,0 +1,116 @@
+#include "SessionManager.hpp"
+#include <random>
+
+SessionManager::SessionManager(chrono::seconds idleTimeout)
+    : idleTimeout(idleTimeout), wheel(WheelSlots), wheelTick(tickOf(Clock::now())) {}
+
+int64_t SessionManager::tickOf(Clock::time_point t) {
+    return chrono::duration_cast<chrono::seconds>(t.time_since_epoch()).count();
+}
+
+// 128 bits from the system's random source, as hex
+string SessionManager::newToken() {
+    static const char digits[] = "0123456789abcdef";
+    random_device source;
+    string token;
+    token.reserve(32);
+    for (int i = 0; i < 4; ++i) {
+        uint32_t bits = source();
+        for (int j = 0; j < 8; ++j) {
+            token += digits[bits & 0xF];
+            bits >>= 4;
+        }
+    }
+    return token;
+}
+
+bool SessionManager::isLiveLocked(const Entry& entry, Clock::time_point now) const {
+    if (entry.expiresAt <= now || entry.globalEpoch != globalEpoch) return false;
+    auto it = userEpochs.find(entry.session.userID);
+    return entry.userEpoch == (it == userEpochs.end() ? 0 : it->second);
+}
+
+// Files the token under the tick it expires in. Expiries further out than
+// the wheel spans, and sessions extended since, are refiled when their slot
+// comes round.
+void SessionManager::scheduleLocked(const string& token, Clock::time_point expiresAt) {
+    int64_t tick = tickOf(expiresAt) + 1;
+    if (tick <= wheelTick) tick = wheelTick + 1;
+    if (tick > wheelTick + (int64_t)WheelSlots) tick = wheelTick + WheelSlots;
+    wheel[(size_t)(tick % WheelSlots)].push_back(token);
+}
+
+string SessionManager::open(const user& u, Clock::time_point now) {
+    lock_guard<mutex> lock(sessionMutex);
+    string token = newToken();
+    Entry entry;
+    entry.session.userID = u.getUserID();
+    entry.session.username = u.getUsername();
+    entry.session.role = u.getRole();
+    entry.expiresAt = now + idleTimeout;
+    entry.globalEpoch = globalEpoch;
+    entry.userEpoch = userEpochs[u.getUserID()];
+    sessions[token] = move(entry);
+    scheduleLocked(token, now + idleTimeout);
+    return token;
+}
+
+bool SessionManager::validate(const string& token, Session& session, Clock::time_point now) {
+    lock_guard<mutex> lock(sessionMutex);
+    auto it = sessions.find(token);
+    if (it == sessions.end()) return false;
+    if (!isLiveLocked(it->second, now)) {
+        sessions.erase(it);
+        return false;
+    }
+    // The wheel entry stays where it is and is refiled when it fires
+    it->second.expiresAt = now + idleTimeout;
+    session = it->second.session;
+    return true;
+}
+
+void SessionManager::close(const string& token) {
+    lock_guard<mutex> lock(sessionMutex);
+    sessions.erase(token);
+}
+
+void SessionManager::revokeUser(int userID) {
+    lock_guard<mutex> lock(sessionMutex);
+    userEpochs[userID]++;
+}
+
+void SessionManager::revokeAll() {
+    lock_guard<mutex> lock(sessionMutex);
+    globalEpoch++;
+}
+
+size_t SessionManager::expire(Clock::time_point now) {
+    lock_guard<mutex> lock(sessionMutex);
+    int64_t nowTick = tickOf(now);
+    // After a long pause every slot is due; visiting each once is enough
+    if (nowTick - wheelTick > (int64_t)WheelSlots) wheelTick = nowTick - WheelSlots;
+
+    size_t dropped = 0;
+    vector<string> due;
+    while (wheelTick < nowTick) {
+        wheelTick++;
+        due.clear();
+        due.swap(wheel[(size_t)(wheelTick % WheelSlots)]);
+        for (const auto& token : due) {
+            auto it = sessions.find(token);
+            if (it == sessions.end()) continue;     // closed, or already dropped
+            if (isLiveLocked(it->second, now)) {
+                scheduleLocked(token, it->second.expiresAt);
+            } else {
+                sessions.erase(it);
+                dropped++;
+            }
+        }
+    }
+    return dropped;
+}
+
+size_t SessionManager::size() const {
+    lock_guard<mutex> lock(sessionMutex);
+    return sessions.size();
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "user.hpp"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Opaque session tokens for logged-in users. A token maps straight to the
+// user's ID, name and role, so authenticated requests never go back to
+// UserManager. Sessions expire after idleTimeout without use; expiry runs on
+// a timer wheel, so it costs O(1) per session rather than a scan. Revoking
+// every session of a user, or all of them, is O(1) too: it bumps an epoch
+// and stale sessions are dropped the next time they are looked up or their
+// wheel slot comes round. Safe to share between threads.
+class SessionManager {
+public:
+    using Clock = chrono::steady_clock;
+
+    struct Session {
+        int userID = 0;
+        string username;
+        user::Role role = user::Role::Customer;
+    };
+
+    explicit SessionManager(chrono::seconds idleTimeout = chrono::minutes(30));
+
+    string open(const user& u, Clock::time_point now = Clock::now());
+    // Looks the token up and, if it is still valid, extends it
+    bool validate(const string& token, Session& session, Clock::time_point now = Clock::now());
+    void close(const string& token);
+
+    void revokeUser(int userID);
+    void revokeAll();
+
+    // Advances the wheel to now and drops expired or revoked sessions;
+    // returns how many were dropped
+    size_t expire(Clock::time_point now = Clock::now());
+    // Includes revoked sessions that have not been collected yet
+    size_t size() const;
+
+private:
+    static const size_t WheelSlots = 512;   // one-second ticks
+
+    struct Entry {
+        Session session;
+        Clock::time_point expiresAt;
+        uint32_t globalEpoch;
+        uint32_t userEpoch;
+    };
+
+    chrono::seconds idleTimeout;
+    unordered_map<string, Entry> sessions;
+    unordered_map<int, uint32_t> userEpochs;
+    uint32_t globalEpoch = 0;
+    vector<vector<string>> wheel;
+    int64_t wheelTick;                     // last tick the wheel has processed
+    mutable mutex sessionMutex;
+
+    static int64_t tickOf(Clock::time_point t);
+    static string newToken();
+    bool isLiveLocked(const Entry& entry, Clock::time_point now) const;
+    void scheduleLocked(const string& token, Clock::time_point expiresAt);
+};
@@ -1,4 +1,5 @@
 #include "UserManager.hpp"
+#include "PasswordHash.hpp"
 
 UserManager::UserManager() : nextUserID(1001) {}
 
@@ -6,31 +7,48 @@ bool UserManager::registerUser(const std::string& username, const std::string& p
     if (usernameExists(username)) {
         return false;
     }
+    return restoreUser(username, PasswordHash::hash(password), role);
+}
+
+bool UserManager::restoreUser(const std::string& username, const std::string& passwordHash, user::Role role) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (usernameExistsLocked(username)) {
+        return false;
+    }
     
-    users.emplace_back(nextUserID, username, password, role);
+    byUsername[username] = users.size();
+    users.emplace_back(nextUserID, username, passwordHash, role);
     nextUserID++;
     return true;
 }
 
 user* UserManager::loginUser(const std::string& username, const std::string& password) {
-    for (auto& u : users) {
-        if (u.getUsername() == username && u.verifyPassword(password)) {
-            return &u;
-        }
+    user* u = getUserByUsername(username);
+    // A user's password never changes after registration, so it is safe to
+    // verify without holding the lock
+    if (u && u->verifyPassword(password)) {
+        return u;
     }
     return nullptr;
 }
 
 bool UserManager::usernameExists(const std::string& username) const {
-    for (const auto& u : users) {
-        if (u.getUsername() == username) {
-            return true;
-        }
-    }
-    return false;
+    std::lock_guard<std::mutex> lock(mutex);
+    return usernameExistsLocked(username);
+}
+
+bool UserManager::usernameExistsLocked(const std::string& username) const {
+    return byUsername.count(username) > 0;
+}
+
+user* UserManager::getUserByUsername(const std::string& username) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byUsername.find(username);
+    return it == byUsername.end() ? nullptr : &users[it->second];
 }
 
 user* UserManager::getUserByID(int userID) {
+    std::lock_guard<std::mutex> lock(mutex);
     for (auto& u : users) {
         if (u.getUserID() == userID) {
             return &u;
@@ -39,6 +57,13 @@ user* UserManager::getUserByID(int userID) {
     return nullptr;
 }
 
-const std::vector<user>& UserManager::getAllUsers() const {
-    return users;
+std::vector<user> UserManager::getAllUsers() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::vector<user>(users.begin(), users.end());
+}
+
+std::vector<user> UserManager::getUsersFrom(size_t first) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (first >= users.size()) return {};
+    return std::vector<user>(users.begin() + first, users.end());
 }
@@ -1,17 +1,36 @@
 #pragma once
 #include "user.hpp"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
+// Safe to share between threads. Users live in a deque so pointers handed
+// out by loginUser/getUserByID stay valid while new users register.
+// Passwords are stored as PasswordHash values; hashing and verifying run
+// outside the lock since they are deliberately slow.
 class UserManager {
 private:
-    std::vector<user> users;
+    std::deque<user> users;
+    std::unordered_map<std::string, size_t> byUsername;   // index into users
     int nextUserID = 1;
+    mutable std::mutex mutex;
+
+    bool usernameExistsLocked(const std::string& username) const;
 
 public:
     UserManager();
+    // Hashes the plaintext password with the current work factor
     bool registerUser(const std::string& username, const std::string& password, user::Role role);
+    // Adds a user whose password is already a PasswordHash value, e.g. from
+    // savedata.txt or a replication primary
+    bool restoreUser(const std::string& username, const std::string& passwordHash, user::Role role);
     user* loginUser(const std::string& username, const std::string& password);
     bool usernameExists(const std::string& username) const;
     user* getUserByID(int userID);
-    const std::vector<user>& getAllUsers() const;
+    user* getUserByUsername(const std::string& username);
+    std::vector<user> getAllUsers() const;
+    // Users are only ever appended, so this returns the ones registered
+    // after the first `first`
+    std::vector<user> getUsersFrom(size_t first) const;
 };
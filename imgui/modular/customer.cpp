@@ -1,50 +1,48 @@
-#include "Customer.hpp"
+#include "customer.hpp"
 #include <iostream>
 using namespace std;
 
 Customer::Customer(int id, const string& name)
     : user(id, name, user::Role::Customer), CustomerID(id) {}
 
-void Customer::createOrder(OrderManager& manager,
-                           int orderID,
-                           const string& orderName,
-                           OrderKind kind,
-                           chrono::system_clock::time_point deadline,
-                           const string& reference,
-                           const string& extras) {
-    Order newOrder(orderID, orderName, kind, deadline);
+int Customer::createOrder(OrderManager& manager,
+                          const string& orderName,
+                          OrderKind kind,
+                          chrono::system_clock::time_point deadline,
+                          const string& reference,
+                          const string& extras) {
+    Order newOrder(0, orderName, kind, deadline);
     newOrder.reference = reference;
     newOrder.extras = extras;
     newOrder.customerID = CustomerID;
-    manager.addOrder(newOrder);
+    int orderID = manager.addNewOrder(newOrder);
 
     cout << "Customer " << username << " created Order " << orderID
          << " (" << orderName << ") with reference: " << reference
          << " and extras: " << extras << endl;
+    return orderID;
 }
 
-void Customer::modifyOrder(OrderManager& manager,
-                           int orderID,
-                           const string& newName,
-                           OrderKind newKind,
-                           chrono::system_clock::time_point newDeadline,
-                           const string& reference,
-                           const string& extras) {
-    Order* order = manager.findOrder(orderID);
-    if (order) {
-        order->orderName = newName;
-        order->orderKind = newKind;
-        order->deadline = newDeadline;
-        order->reference = reference;
-        order->extras = extras;
-
+UpdateResult Customer::modifyOrder(OrderManager& manager,
+                                   int orderID,
+                                   const string& newName,
+                                   OrderKind newKind,
+                                   chrono::system_clock::time_point newDeadline,
+                                   const string& reference,
+                                   const string& extras,
+                                   uint64_t expectedVersion) {
+    UpdateResult result = manager.modifyOrder(orderID, newName, newKind, newDeadline, reference, extras, expectedVersion);
+    if (result == UpdateResult::Ok) {
         cout << "Customer " << username << " modified Order " << orderID
              << " → Name: " << newName
              << ", Kind updated, Deadline adjusted, Reference: " << reference
              << ", Extras: " << extras << endl;
+    } else if (result == UpdateResult::Conflict) {
+        cout << "Order " << orderID << " was changed by someone else, update rejected.\n";
     } else {
         cout << "Order " << orderID << " not found.\n";
     }
+    return result;
 }
 
 void Customer::displayInfo() const {
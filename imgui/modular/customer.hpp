@@ -14,21 +14,22 @@ class Customer : public user {
     public:
     Customer(int id, const string& name);
 
-    void createOrder(OrderManager& manager,
-        int orderID,
+    // The manager assigns the order ID; returns it
+    int createOrder(OrderManager& manager,
         const string& orderName,
         OrderKind kind,
         chrono::system_clock::time_point deadline,
         const string& reference,
         const string& extras); 
     
-    void modifyOrder(OrderManager& manager,
+    UpdateResult modifyOrder(OrderManager& manager,
         int orderID,
         const string& newName,
         OrderKind newKind,
         chrono::system_clock::time_point newDeadline,
         const string& reference,
-        const string& extras);
+        const string& extras,
+        uint64_t expectedVersion = OrderManager::AnyVersion);
     
     void displayInfo() const override;
 };
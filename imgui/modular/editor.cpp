@@ -6,10 +6,8 @@ Editor::Editor(int id, const string& name)
     : user(id, name, user::Role::Editor), editorID(id) {}
 
 void Editor::assignOrder(OrderManager& manager, int orderID) {
-    Order* order = manager.findOrder(orderID);
-    if (order) {
-        order->editorAssigned = username;
-        order->updateStatus(OrderStatus::InProgress);
+    if (manager.assignEditor(orderID, username) == UpdateResult::Ok) {
+        manager.updateStatus(orderID, OrderStatus::InProgress);
         cout << "Editor " << username << " assigned to order " << orderID << "\n";
     } else {
         cout << "Order " << orderID << " not found.\n";
@@ -17,9 +15,7 @@ void Editor::assignOrder(OrderManager& manager, int orderID) {
 }
 
 void Editor::completeOrder(OrderManager& manager, int orderID) const {
-    Order* order = manager.findOrder(orderID);
-    if (order) {
-        order->updateStatus(OrderStatus::Completed);
+    if (manager.updateStatus(orderID, OrderStatus::Completed) == UpdateResult::Ok) {
         cout << "Editor " << username << " completed order " << orderID << "\n";
     } else {
         cout << "Order " << orderID << " not found.\n";
@@ -27,9 +23,7 @@ void Editor::completeOrder(OrderManager& manager, int orderID) const {
 }
 
 void Editor::attachLink(OrderManager& manager, int orderID, const string& link) {
-    Order* order = manager.findOrder(orderID);
-    if (order) {
-        order->attachLink(link);
+    if (manager.attachLink(orderID, link) == UpdateResult::Ok) {
         cout << "Editor " << username << " attached link to order " << orderID << "\n";
     } else {
         cout << "Order " << orderID << " not found.\n";
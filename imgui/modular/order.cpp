@@ -1,6 +1,7 @@
 #include "order.hpp"
 #include <iostream>
 #include <ctime>
+#include <cstdio>
 using namespace std;
 
 Order::Order(int id, const string& name, OrderKind kind, const chrono::system_clock::time_point& deadline)
@@ -33,4 +34,120 @@ void Order::displayOrder() const {
          << "Reference: " << reference << "\n"
          << "Extras: " << extras << "\n"
          << "Editor Assigned: " << editorAssigned << "\n";
-}
\ No newline at end of file
+}
+
+string Order::getField(OrderField field) const {
+    switch (field) {
+        case OrderField::Name: return orderName;
+        case OrderField::Status: return statusToString(status);
+        case OrderField::Kind: return kindToString(orderKind);
+        case OrderField::Deadline: return deadlineToTicks(deadline);
+        case OrderField::Reference: return reference;
+        case OrderField::Extras: return extras;
+        case OrderField::EditorAssigned: return editorAssigned;
+        case OrderField::FinalLink: return finalLink;
+        case OrderField::CustomerID: return to_string(customerID);
+    }
+    return string();
+}
+
+bool Order::setField(OrderField field, const string& value) {
+    switch (field) {
+        case OrderField::Name: orderName = value; return true;
+        case OrderField::Status: status = statusFromString(value); return true;
+        case OrderField::Kind: orderKind = kindFromString(value); return true;
+        case OrderField::Deadline: return deadlineFromTicks(value, deadline);
+        case OrderField::Reference: reference = value; return true;
+        case OrderField::Extras: extras = value; return true;
+        case OrderField::EditorAssigned: editorAssigned = value; return true;
+        case OrderField::FinalLink: finalLink = value; return true;
+        case OrderField::CustomerID:
+            try { customerID = stoi(value); } catch (const exception&) { return false; }
+            return true;
+    }
+    return false;
+}
+
+// Compares without encoding, so diffing two orders stays cheap
+bool Order::sameField(const Order& other, OrderField field) const {
+    switch (field) {
+        case OrderField::Name: return orderName == other.orderName;
+        case OrderField::Status: return status == other.status;
+        case OrderField::Kind: return orderKind == other.orderKind;
+        case OrderField::Deadline: return deadline == other.deadline;
+        case OrderField::Reference: return reference == other.reference;
+        case OrderField::Extras: return extras == other.extras;
+        case OrderField::EditorAssigned: return editorAssigned == other.editorAssigned;
+        case OrderField::FinalLink: return finalLink == other.finalLink;
+        case OrderField::CustomerID: return customerID == other.customerID;
+    }
+    return true;
+}
+
+string Order::statusToString(OrderStatus s) {
+    switch (s) {
+        case OrderStatus::Pending: return "Pending";
+        case OrderStatus::InProgress: return "InProgress";
+        case OrderStatus::Completed: return "Completed";
+        case OrderStatus::Cancelled: return "Cancelled";
+    }
+    return "Pending";
+}
+
+OrderStatus Order::statusFromString(const string& s) {
+    if (s == "InProgress") return OrderStatus::InProgress;
+    if (s == "Completed") return OrderStatus::Completed;
+    if (s == "Cancelled") return OrderStatus::Cancelled;
+    return OrderStatus::Pending;
+}
+
+string Order::kindToString(OrderKind k) {
+    switch (k) {
+        case OrderKind::Logo: return "Logo";
+        case OrderKind::Status: return "Status";
+        case OrderKind::Feed: return "Feed";
+        case OrderKind::Asset: return "Asset";
+        case OrderKind::Document: return "Document";
+        case OrderKind::Other: return "Other";
+    }
+    return "Other";
+}
+
+OrderKind Order::kindFromString(const string& s) {
+    if (s == "Logo") return OrderKind::Logo;
+    if (s == "Status") return OrderKind::Status;
+    if (s == "Feed") return OrderKind::Feed;
+    if (s == "Asset") return OrderKind::Asset;
+    if (s == "Document") return OrderKind::Document;
+    return OrderKind::Other;
+}
+
+string Order::deadlineToString(const chrono::system_clock::time_point& deadline) {
+    time_t deadline_time = chrono::system_clock::to_time_t(deadline);
+    char deadline_str[20];
+    strftime(deadline_str, sizeof(deadline_str), "%Y-%m-%d", localtime(&deadline_time));
+    return deadline_str;
+}
+
+bool Order::deadlineFromString(const string& s, chrono::system_clock::time_point& deadline) {
+    int year, month, day;
+    if (sscanf(s.c_str(), "%d-%d-%d", &year, &month, &day) != 3) return false;
+
+    struct tm deadline_tm = {};
+    deadline_tm.tm_year = year - 1900;
+    deadline_tm.tm_mon = month - 1;
+    deadline_tm.tm_mday = day;
+    deadline = chrono::system_clock::from_time_t(mktime(&deadline_tm));
+    return true;
+}
+
+string Order::deadlineToTicks(const chrono::system_clock::time_point& deadline) {
+    return to_string((long long)deadline.time_since_epoch().count());
+}
+
+bool Order::deadlineFromTicks(const string& s, chrono::system_clock::time_point& deadline) {
+    long long ticks;
+    try { ticks = stoll(s); } catch (const exception&) { return false; }
+    deadline = chrono::system_clock::time_point(chrono::system_clock::duration(ticks));
+    return true;
+}
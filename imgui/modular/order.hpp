@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <chrono>
+#include <cstdint>
 using namespace std;
 
 enum class OrderStatus {
@@ -19,6 +20,22 @@ enum class OrderKind {
     Other,
 };
 
+// Every persisted column of an order. Values are exchanged as the same text
+// SaveManager writes to savedata.txt, except the deadline: savedata.txt keeps
+// only its date, field values keep the exact time point (clock ticks since
+// the epoch) so undo/redo restores it unchanged.
+enum class OrderField : uint8_t {
+    Name,
+    Status,
+    Kind,
+    Deadline,
+    Reference,
+    Extras,
+    EditorAssigned,
+    FinalLink,
+    CustomerID,
+};
+
 class Order {
 public:
     int orderID;
@@ -31,6 +48,7 @@ public:
     string editorAssigned;
     string finalLink;
     int customerID = 0;
+    uint64_t version = 0;   // commit timestamp of the last write, set by OrderManager
 
     Order(int id, const string& name, OrderKind kind, const chrono::system_clock::time_point& deadline);
 
@@ -39,4 +57,18 @@ public:
     void assignEditor(const string& editorName);
     void unassignEditor();
     void displayOrder() const;
+
+    string getField(OrderField field) const;
+    bool setField(OrderField field, const string& value);
+    bool sameField(const Order& other, OrderField field) const;
+
+    static const int FieldCount = 9;
+    static string statusToString(OrderStatus s);
+    static OrderStatus statusFromString(const string& s);
+    static string kindToString(OrderKind k);
+    static OrderKind kindFromString(const string& s);
+    static string deadlineToString(const chrono::system_clock::time_point& deadline);
+    static bool deadlineFromString(const string& s, chrono::system_clock::time_point& deadline);
+    static string deadlineToTicks(const chrono::system_clock::time_point& deadline);
+    static bool deadlineFromTicks(const string& s, chrono::system_clock::time_point& deadline);
 };
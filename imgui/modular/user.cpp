@@ -1,4 +1,5 @@
 #include "user.hpp"
+#include "PasswordHash.hpp"
 #include <iostream>
 using namespace std;
 
@@ -22,7 +23,7 @@ user::Role user::getRole() const {
 }
 
 bool user::verifyPassword(const string& pwd) const {
-    return password == pwd;
+    return PasswordHash::verify(pwd, password);
 }
 
 string user::roleToString(user::Role r) {
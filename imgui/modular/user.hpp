@@ -9,7 +9,7 @@ class user {
     protected:
     int userID;
     string username;
-    string password;
+    string password;    // PasswordHash value
     Role role;
 
     public:
@@ -0,0 +1,287 @@
+// Discrete-event simulator for EditorScheduler. Replays the same stream of
+// orders against a real OrderManager under three policies and reports
+// throughput, deadline-miss rate and waiting time for each:
+//
+//   manual      every editor checks the list every --check hours and claims
+//               the oldest unassigned orders up to --capacity ("Assign to Me")
+//   scheduler   plan() on every arrival and completion, no stealing
+//   stealing    plan() plus rebalance() whenever an editor frees up
+//
+//   g++ -std=c++17 -O2 -pthread scheduler_sim_main.cpp modular/*.cpp -o desainin-schedsim
+//   (add -lws2_32 on Windows)
+//
+//   desainin-schedsim [--editors 6] [--hours 2000] [--rate 1.2] [--capacity 5]
+//                     [--check 4] [--seed 1]
+//
+// Each editor specializes in two kinds, which they finish in 0.6x the usual
+// time; anything else takes 1.4x. Editors start with a short history of
+// completed orders in their kinds, which is all the scheduler knows about
+// them. Times are simulated hours; --rate is orders per hour.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "modular/OrderManager.hpp"
+#include "modular/EditorScheduler.hpp"
+
+using namespace std;
+using TimePoint = chrono::system_clock::time_point;
+
+enum class Policy { Manual, Scheduler, Stealing };
+static const char* PolicyNames[] = { "manual", "scheduler", "stealing" };
+
+// Hours of work per kind for an editor without the specialty
+static const double KindHours[OrderStats::KindCount] = { 6, 2, 3, 4, 5, 3 };
+static const double SpecialistFactor = 0.6;
+static const double GeneralistFactor = 1.4;
+
+struct Options {
+    int editors = 6;
+    double hours = 2000;
+    double rate = 1.2;
+    int capacity = 5;
+    double checkHours = 4;
+    unsigned seed = 1;
+};
+
+struct Arrival {
+    double at;
+    OrderKind kind;
+    double deadline;
+    double work;    // hours before the editor's speed factor
+};
+
+struct Event {
+    double at;
+    int type;       // Arrive, Finish, Check
+    int index;      // arrival index or editor
+    bool operator<(const Event& other) const { return at > other.at; }
+};
+enum { Arrive, Finish, Check };
+
+struct Report {
+    int arrived = 0;
+    int completed = 0;
+    int late = 0;           // completed after the deadline
+    int overdueOpen = 0;    // still open and past the deadline at the end
+    double waitHours = 0;   // arrival to start, over started orders
+    int started = 0;
+    double busyHours = 0;
+};
+
+static TimePoint simTime(double hours) {
+    static const TimePoint base = TimePoint() + chrono::hours(24 * 365 * 56);
+    return base + chrono::duration_cast<TimePoint::duration>(chrono::duration<double, ratio<3600>>(hours));
+}
+
+static bool specializes(int editor, OrderKind kind) {
+    int k = static_cast<int>(kind);
+    return k == editor % OrderStats::KindCount || k == (editor + 2) % OrderStats::KindCount;
+}
+
+static vector<Arrival> makeArrivals(const Options& options) {
+    mt19937 rng(options.seed);
+    exponential_distribution<double> gap(options.rate);
+    uniform_int_distribution<int> kind(0, OrderStats::KindCount - 1);
+    uniform_real_distribution<double> slack(12, 72);
+    exponential_distribution<double> effort(1.0);
+
+    vector<Arrival> arrivals;
+    for (double t = gap(rng); t < options.hours; t += gap(rng)) {
+        OrderKind k = static_cast<OrderKind>(kind(rng));
+        double work = KindHours[static_cast<int>(k)] * (0.5 + 0.5 * effort(rng));
+        arrivals.push_back({ t, k, t + slack(rng), work });
+    }
+    return arrivals;
+}
+
+class Simulation {
+public:
+    Simulation(const Options& options, Policy policy, const vector<Arrival>& arrivals)
+        : options(options), policy(policy), arrivals(arrivals) {
+        for (int e = 0; e < options.editors; ++e) editors.push_back("editor" + to_string(e + 1));
+        busyWith.assign(options.editors, 0);
+        busySince.assign(options.editors, 0);
+
+        EditorScheduler::Settings settings;
+        settings.capacity = options.capacity;
+        if (policy != Policy::Stealing) settings.stealBelow = -1;
+        scheduler.setSettings(settings);
+
+        // A little history, so the scheduler can tell who does what
+        int id = 1;
+        for (int e = 0; e < options.editors; ++e) {
+            for (int k = 0; k < OrderStats::KindCount; ++k) {
+                if (!specializes(e, static_cast<OrderKind>(k))) continue;
+                for (int i = 0; i < 5; ++i) {
+                    Order past(id++, "history", static_cast<OrderKind>(k), simTime(0));
+                    past.status = OrderStatus::Completed;
+                    past.editorAssigned = editors[e];
+                    manager.addOrder(past);
+                }
+            }
+        }
+        firstArrivalID = id;
+    }
+
+    Report run() {
+        for (size_t i = 0; i < arrivals.size(); ++i) events.push({ arrivals[i].at, Arrive, (int)i });
+        if (policy == Policy::Manual) {
+            for (int e = 0; e < options.editors; ++e) {
+                events.push({ options.checkHours * e / options.editors, Check, e });
+            }
+        }
+
+        while (!events.empty() && events.top().at < options.hours) {
+            Event event = events.top();
+            events.pop();
+            now = event.at;
+            if (event.type == Arrive) {
+                const Arrival& a = arrivals[event.index];
+                Order order(firstArrivalID + event.index, "sim", a.kind, simTime(a.deadline));
+                manager.addOrder(order);
+                report.arrived++;
+                schedule(false);
+            } else if (event.type == Finish) {
+                finish(event.index);
+                schedule(true);
+            } else {
+                claimOldest(event.index);
+                startIdle();
+                events.push({ now + options.checkHours, Check, event.index });
+            }
+        }
+
+        now = options.hours;
+        for (int e = 0; e < options.editors; ++e) {
+            if (busyWith[e]) report.busyHours += now - busySince[e];
+        }
+        auto view = manager.snapshot();
+        for (const auto& order : view->orders) {
+            bool open = order->status == OrderStatus::Pending || order->status == OrderStatus::InProgress;
+            if (open && order->deadline < simTime(now)) report.overdueOpen++;
+        }
+        return report;
+    }
+
+private:
+    const Options& options;
+    Policy policy;
+    const vector<Arrival>& arrivals;
+    vector<string> editors;
+    OrderManager manager;
+    EditorScheduler scheduler;
+    priority_queue<Event> events;
+    vector<int> busyWith;
+    vector<double> busySince;
+    int firstArrivalID = 1;
+    double now = 0;
+    Report report;
+
+    void schedule(bool editorFreed) {
+        if (policy != Policy::Manual) {
+            auto view = manager.snapshot();
+            EditorScheduler::apply(manager, scheduler.plan(*view, editors, simTime(now)));
+            if (editorFreed && policy == Policy::Stealing) {
+                view = manager.snapshot();
+                EditorScheduler::apply(manager, scheduler.rebalance(*view, editors));
+            }
+        }
+        startIdle();
+    }
+
+    // What an editor scrolling the list would do: take the oldest first
+    void claimOldest(int editor) {
+        auto view = manager.snapshot();
+        int room = options.capacity - view->stats.openForEditor(editors[editor]);
+        for (const auto& order : view->orders) {
+            if (room <= 0) break;
+            if (order->status != OrderStatus::Pending || !order->editorAssigned.empty()) continue;
+            if (manager.assignEditor(order->orderID, editors[editor], order->version) == UpdateResult::Ok) room--;
+        }
+    }
+
+    void startIdle() {
+        shared_ptr<const OrderSnapshot> view;
+        for (int e = 0; e < options.editors; ++e) {
+            if (busyWith[e]) continue;
+            if (!view) view = manager.snapshot();
+            if (view->stats.openForEditor(editors[e]) == 0) continue;
+
+            // Own queue, earliest deadline first
+            shared_ptr<const Order> next;
+            for (const auto& order : view->orders) {
+                if (order->status != OrderStatus::Pending || order->editorAssigned != editors[e]) continue;
+                if (!next || order->deadline < next->deadline) next = order;
+            }
+            if (!next) continue;
+
+            manager.updateStatus(next->orderID, OrderStatus::InProgress);
+            view.reset();
+            const Arrival& a = arrivals[next->orderID - firstArrivalID];
+            double factor = specializes(e, a.kind) ? SpecialistFactor : GeneralistFactor;
+            busyWith[e] = next->orderID;
+            busySince[e] = now;
+            report.waitHours += now - a.at;
+            report.started++;
+            events.push({ now + a.work * factor, Finish, e });
+        }
+    }
+
+    void finish(int editor) {
+        int orderID = busyWith[editor];
+        busyWith[editor] = 0;
+        report.busyHours += now - busySince[editor];
+        manager.updateStatus(orderID, OrderStatus::Completed);
+        report.completed++;
+        if (now > arrivals[orderID - firstArrivalID].deadline) report.late++;
+    }
+};
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        const char* value = argv[i + 1];
+        if (flag == "--editors") options.editors = atoi(value);
+        else if (flag == "--hours") options.hours = atof(value);
+        else if (flag == "--rate") options.rate = atof(value);
+        else if (flag == "--capacity") options.capacity = atoi(value);
+        else if (flag == "--check") options.checkHours = atof(value);
+        else if (flag == "--seed") options.seed = (unsigned)atoi(value);
+        else return false;
+    }
+    return argc % 2 == 1 && options.editors > 0 && options.hours > 0 && options.rate > 0 &&
+           options.capacity > 0 && options.checkHours > 0;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        cerr << "Usage: desainin-schedsim [--editors n] [--hours h] [--rate r] [--capacity c] [--check h] [--seed s]" << endl;
+        return 1;
+    }
+
+    vector<Arrival> arrivals = makeArrivals(options);
+    cout << options.editors << " editors, " << arrivals.size() << " orders over " << options.hours
+         << " h (" << options.rate << "/h), capacity " << options.capacity << endl;
+    cout << "policy      done/day  missed  wait(h)  busy" << endl;
+
+    for (Policy policy : { Policy::Manual, Policy::Scheduler, Policy::Stealing }) {
+        Simulation sim(options, policy, arrivals);
+        Report r = sim.run();
+        int due = r.completed + r.overdueOpen;
+        double missRate = due ? 100.0 * (r.late + r.overdueOpen) / due : 0;
+        string name = PolicyNames[static_cast<int>(policy)];
+        printf("%-10s  %8.2f  %5.1f%%  %7.1f  %3.0f%%\n", name.c_str(),
+               r.completed / (options.hours / 24), missRate,
+               r.started ? r.waitHours / r.started : 0,
+               100.0 * r.busyHours / (options.hours * options.editors));
+    }
+    return 0;
+}
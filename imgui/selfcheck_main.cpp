@@ -0,0 +1,234 @@
+// Headless end-to-end checks for the order back end. Each check runs
+// in-process against fresh managers and scratch files in the working
+// directory, prints PASS or FAIL, and the program exits with 1 if any
+// failed:
+//
+//   import     a bulk import reports how many orders it added, and they
+//              survive a save and reload of the data file
+//   ownership  a customer session cannot change another customer's order
+//              over the server protocol; an editor session can
+//   replicate  REPLICATE streams users and orders only to an editor session
+//   crlf       a data file saved with Windows line endings loads with its
+//              roles and order fields intact
+//   deadlines  the overdue and at-risk counts agree with the lists they
+//              count through random inserts, moves and removals
+//
+//   g++ -std=c++17 -O2 -pthread selfcheck_main.cpp modular/*.cpp -o desainin-selfcheck
+//   (add -lws2_32 on Windows)
+//
+//   desainin-selfcheck [check ...]      all checks when none is named
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "modular/OrderManager.hpp"
+#include "modular/UserManager.hpp"
+#include "modular/SaveManager.hpp"
+#include "modular/OrderTransfer.hpp"
+#include "modular/OrderService.hpp"
+#include "modular/DeadlineIndex.hpp"
+
+using namespace std;
+
+static int failures = 0;
+
+static void expect(bool condition, const string& what) {
+    cout << (condition ? "  PASS  " : "  FAIL  ") << what << endl;
+    if (!condition) failures++;
+}
+
+static Order sampleOrder(int orderID, int customerID) {
+    Order order(orderID, "check order " + to_string(orderID), OrderKind::Logo,
+                chrono::system_clock::now() + chrono::hours(24 * 7));
+    order.customerID = customerID;
+    order.reference = "ref-" + to_string(orderID);
+    return order;
+}
+
+static void checkImport() {
+    const char* importPath = "selfcheck-import.csv";
+    const char* dataPath = "selfcheck-data.txt";
+    {
+        ofstream out(importPath);
+        for (int id = 5001; id <= 5100; ++id) out << SaveManager::orderToCSV(sampleOrder(id, 7)) << "\n";
+        // Taken by the order already in the manager, so rejected
+        out << SaveManager::orderToCSV(sampleOrder(1001, 7)) << "\n";
+    }
+
+    OrderManager manager;
+    UserManager userManager;
+    manager.addOrder(sampleOrder(1001, 7));
+    ImportReport report;
+    bool opened = OrderTransfer::importFile(importPath, manager, report);
+    expect(opened, "import file opened");
+    expect(report.imported == 100, "import reports 100 orders added (got " + to_string(report.imported) + ")");
+    expect(report.errorCount == 1, "import rejects the taken ID");
+    expect(manager.snapshot()->orders.size() == 101, "imported orders are in the snapshot");
+
+    expect(SaveManager::saveToFile(dataPath, manager, userManager), "data file saved");
+    OrderManager reloaded;
+    UserManager reloadedUsers;
+    SaveManager::loadFromFile(dataPath, reloaded, reloadedUsers);
+    auto view = reloaded.snapshot();
+    expect(view->orders.size() == 101, "reload finds all 101 orders (got " + to_string(view->orders.size()) + ")");
+    auto order = view->find(5050);
+    expect(order && order->reference == "ref-5050" && order->customerID == 7, "imported order saved with its fields");
+
+    remove(importPath);
+    remove(dataPath);
+}
+
+// One request on a connection holding sessionToken; returns the first line
+static string call(OrderService& service, const string& request, string& sessionToken) {
+    string out;
+    service.handle(request, out, sessionToken);
+    return out.substr(0, out.find('\n'));
+}
+
+// Registers and logs in a user, returning its ID
+static int signIn(OrderService& service, const string& username, const string& role, string& sessionToken) {
+    call(service, "REGISTER," + username + ",pw," + role, sessionToken);
+    string reply = call(service, "LOGIN," + username + ",pw", sessionToken);
+    return reply.compare(0, 3, "OK,") == 0 ? atoi(reply.c_str() + 3) : 0;
+}
+
+static void checkOwnership() {
+    OrderManager manager;
+    UserManager userManager;
+    OrderService service(manager, userManager);
+    string owner, other, editor;
+    int ownerID = signIn(service, "selfcheck-owner", "Customer", owner);
+    int otherID = signIn(service, "selfcheck-other", "Customer", other);
+    expect(ownerID > 0 && otherID > 0 && signIn(service, "selfcheck-editor", "Editor", editor) > 0, "users signed in");
+
+    string added = call(service, "ADD,,mine,Logo,2030-01-01,ref,extras", owner);
+    string orderID = added.compare(0, 3, "OK,") == 0 ? added.substr(3) : "0";
+    expect(orderID != "0", "owner adds an order");
+
+    const string foreign[] = {
+        "MODIFY," + orderID + ",taken,Logo,2030-01-01,ref,extras",
+        "STATUS," + orderID + ",Completed",
+        "ASSIGN," + orderID + ",selfcheck-other",
+        "UNASSIGN," + orderID,
+        "LINK," + orderID + ",http://example.invalid",
+        "DELETE," + orderID,
+    };
+    for (const string& request : foreign) {
+        string reply = call(service, request, other);
+        expect(reply == "ERR,AUTH", "foreign customer refused: " + request.substr(0, request.find(',')) + " (got " + reply + ")");
+    }
+    auto order = manager.findOrder(stoi(orderID));
+    expect(order && order->orderName == "mine" && order->status == OrderStatus::Pending, "order unchanged by the foreign customer");
+
+    expect(call(service, "STATUS," + orderID + ",InProgress", owner).compare(0, 3, "OK,") == 0, "owner changes its own order");
+    expect(call(service, "ASSIGN," + orderID + ",selfcheck-editor", editor).compare(0, 3, "OK,") == 0, "editor changes any order");
+    expect(call(service, "DELETE," + orderID, owner) == "OK", "owner deletes its own order");
+}
+
+static void checkReplicate() {
+    OrderManager manager;
+    UserManager userManager;
+    OrderService service(manager, userManager);
+    string customer, editor;
+    signIn(service, "selfcheck-customer", "Customer", customer);
+    signIn(service, "selfcheck-editor", "Editor", editor);
+
+    string anonymous;
+    const string* refused[] = { &anonymous, &customer };
+    for (const string* token : refused) {
+        ReplicaStream stream;
+        string out;
+        service.replicate("REPLICATE,0,0", *token, stream, out);
+        bool sentRows = out.find("USER,") != string::npos;
+        expect(out == "ERR,AUTH\n" && !stream.active && !sentRows,
+               string(token == &anonymous ? "unauthenticated" : "customer") + " REPLICATE refused");
+    }
+
+    ReplicaStream stream;
+    string out;
+    service.replicate("REPLICATE,0,0", editor, stream, out);
+    expect(stream.active && out.find("\nSNAPSHOT,") != string::npos, "editor REPLICATE gets a snapshot");
+}
+
+static void checkCRLF() {
+    const char* dataPath = "selfcheck-crlf.txt";
+    {
+        ofstream out(dataPath, ios::binary);
+        out << "# Users\r\nTYPE,ID,USERNAME,PASSWORD,ROLE\r\n"
+            << "USER,1001,selfcheck-editor,pw,Editor\r\nUSER,1002,selfcheck-customer,pw,Customer\r\n\r\n"
+            << "# Orders\r\n" << SaveManager::orderToCSV(sampleOrder(1001, 1002)) << "\r\n";
+    }
+    OrderManager manager;
+    UserManager userManager;
+    SaveManager::loadFromFile(dataPath, manager, userManager);
+    user* editor = userManager.getUserByUsername("selfcheck-editor");
+    user* customer = userManager.getUserByUsername("selfcheck-customer");
+    expect(editor && editor->getRole() == user::Role::Editor, "editor keeps the Editor role");
+    expect(customer && customer->getRole() == user::Role::Customer, "customer keeps the Customer role");
+    auto order = manager.findOrder(1001);
+    expect(order && order->customerID == 1002, "order's last column read without the \\r");
+    remove(dataPath);
+}
+
+static void checkDeadlines() {
+    using TimePoint = DeadlineIndex::TimePoint;
+    const TimePoint base = chrono::system_clock::now();
+    mt19937 rng(7);
+    auto randomDeadline = [&]() { return base + chrono::hours((int)(rng() % (24 * 60)) - 24 * 30); };
+
+    DeadlineIndex index;
+    vector<pair<TimePoint, int>> batch;
+    for (int id = 1; id <= 3000; ++id) batch.push_back({ randomDeadline(), id });
+    index.insertAll(batch);
+
+    bool agreed = true;
+    for (int round = 0; round < 20000; ++round) {
+        int orderID = 1 + (int)(rng() % 4000);
+        int op = rng() % 3;
+        if (op == 0) index.insert(orderID, randomDeadline());
+        else if (op == 1) index.update(orderID, randomDeadline());
+        else index.remove(orderID);
+
+        if (round % 50 == 0) {
+            TimePoint now = base + chrono::hours((int)(rng() % (24 * 20)));
+            int days = 1 + (int)(rng() % 7);
+            agreed = agreed && index.countOverdue(now) == index.overdue(now).size() &&
+                     index.countDueWithin(now, days) == index.dueWithin(now, days).size();
+        }
+    }
+    expect(agreed, "counts match the lists");
+    expect(index.countOverdue(base + chrono::hours(24 * 365)) == index.size(), "everything counts as overdue eventually");
+    index.clear();
+    expect(index.countOverdue(base) == 0 && index.countDueWithin(base, 3) == 0, "cleared index counts nothing");
+}
+
+struct Check {
+    const char* name;
+    void (*run)();
+};
+
+static const Check Checks[] = {
+    { "import", checkImport },
+    { "ownership", checkOwnership },
+    { "replicate", checkReplicate },
+    { "crlf", checkCRLF },
+    { "deadlines", checkDeadlines },
+};
+
+int main(int argc, char** argv) {
+    for (const Check& check : Checks) {
+        bool wanted = argc == 1;
+        for (int i = 1; i < argc; ++i) wanted |= strcmp(argv[i], check.name) == 0;
+        if (!wanted) continue;
+        cout << check.name << endl;
+        check.run();
+    }
+    cout << (failures ? "FAILED: " + to_string(failures) + " check(s)" : string("all checks passed")) << endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+// Headless order server: serves savedata.txt over the OrderService protocol
+// on 127.0.0.1 and writes it back on Ctrl+C.
+//
+//   g++ -std=c++17 -O2 -pthread server_main.cpp modular/*.cpp -o desainin-server
+//   (add -lws2_32 on Windows)
+//
+//   desainin-server [port]                        primary, default port 7070
+//   desainin-server [port] --follow primaryPort --user editor --password pw
+//                                                 read-only replica
+//   ... --cost iterations                         PBKDF2 work factor for new hashes
+//
+// A replica starts empty, copies the primary's state over REPLICATE, serves
+// reads from it, and prints its replication lag once a second. It never
+// touches savedata.txt. The primary only replicates to an Editor account,
+// which --user and --password name.
+//
+// LOGIN and REGISTER hash on a worker pool, so a slow password check never
+// stalls other connections. Stored hashes keep the cost they were made with;
+// raising --cost only affects passwords hashed from then on.
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "modular/OrderManager.hpp"
+#include "modular/UserManager.hpp"
+#include "modular/SaveManager.hpp"
+#include "modular/OrderService.hpp"
+#include "modular/OrderServer.hpp"
+#include "modular/ReplicaFollower.hpp"
+#include "modular/PasswordHash.hpp"
+#include "modular/PasswordVerifier.hpp"
+
+static OrderServer* g_server = nullptr;
+
+static void onSignal(int) {
+    if (g_server) g_server->stop();
+}
+
+static void reportLag(ReplicaFollower& follower, const atomic<bool>& running) {
+    while (running) {
+        this_thread::sleep_for(chrono::seconds(1));
+        ReplicaFollower::Status status = follower.takeStatus();
+        cout << (status.connected ? "replica: applied " : "replica (disconnected): applied ")
+             << status.appliedLSN << " of " << status.primaryLSN
+             << " (" << (status.primaryLSN - status.appliedLSN) << " behind)";
+        if (status.lag.count() > 0) cout << ", lag " << status.lag.summary();
+        cout << endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = 7070;
+    uint16_t primaryPort = 0;
+    string replicaUser;
+    string replicaPassword;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--follow") == 0 && i + 1 < argc) {
+            primaryPort = (uint16_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--user") == 0 && i + 1 < argc) {
+            replicaUser = argv[++i];
+        } else if (strcmp(argv[i], "--password") == 0 && i + 1 < argc) {
+            replicaPassword = argv[++i];
+        } else if (strcmp(argv[i], "--cost") == 0 && i + 1 < argc) {
+            PasswordHash::setIterations((uint32_t)atoi(argv[++i]));
+        } else {
+            port = (uint16_t)atoi(argv[i]);
+        }
+    }
+    if (primaryPort && replicaUser.empty()) {
+        cerr << "A replica needs --user and --password of an Editor on the primary" << endl;
+        return 1;
+    }
+
+    OrderManager manager;
+    UserManager userManager;
+    if (!primaryPort) SaveManager::loadFromFile("savedata.txt", manager, userManager);
+
+    OrderService service(manager, userManager);
+    // Declared after the service so its workers are joined before the
+    // service they report into goes away
+    PasswordVerifier verifier;
+    service.setVerifier(&verifier);
+    OrderServer server(service);
+    if (!server.start(port)) return 1;
+
+    g_server = &server;
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    ReplicaFollower follower(manager, userManager);
+    atomic<bool> reporting{ primaryPort != 0 };
+    thread reporter;
+    if (primaryPort) {
+        service.setReadOnly(true);
+        follower.start("127.0.0.1", primaryPort, replicaUser, replicaPassword);
+        reporter = thread(reportLag, ref(follower), cref(reporting));
+        cout << "Following 127.0.0.1:" << primaryPort << endl;
+    }
+
+    cout << "Listening on 127.0.0.1:" << server.getPort() << endl;
+    server.run();
+    g_server = nullptr;
+
+    cout << "Served " << server.requestsServed() << " requests" << endl;
+    if (primaryPort) {
+        reporting = false;
+        reporter.join();
+        follower.stop();
+    } else {
+        SaveManager::saveToFile("savedata.txt", manager, userManager);
+    }
+    return 0;
+}
@@ -0,0 +1,225 @@
+// Stress test for OrderManager snapshots. One writer thread hammers a
+// manager with adds, edits, assignments, deletes and bulk imports while
+// reader threads take snapshot() in a loop and check that each one is
+// complete and consistent:
+//
+//   - orders are sorted by ID and size() matches what iteration yields
+//   - the stats (total, per status, per editor, per customer) match the orders
+//   - no order is newer than the snapshot's version
+//   - a bulk import is either fully visible or not at all
+//   - a snapshot held across later writes never changes underneath
+//
+//   g++ -std=c++17 -O2 -pthread snapshot_stress_main.cpp modular/*.cpp -o desainin-snapstress
+//   (add -lws2_32 on Windows)
+//
+//   desainin-snapstress [--orders 100000] [--readers 3] [--seconds 10] [--seed 1]
+//
+// Exits with 1 if any reader saw an inconsistent snapshot. Also reports
+// write latency at the given --orders size, which is what publishing a
+// snapshot per write costs.
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modular/OrderManager.hpp"
+#include "modular/LatencyHistogram.hpp"
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static const int EditorCount = 8;
+static const int CustomerCount = 64;
+static const int BatchBase = 100000000;     // bulk imports use IDs from here
+static const int BatchSize = 50;
+
+struct Options {
+    int orders = 100000;
+    int readers = 3;
+    double seconds = 10;
+    unsigned seed = 1;
+};
+
+static string editorName(int e) {
+    return "editor-" + to_string(e);
+}
+
+static Order makeOrder(int orderID, mt19937& rng) {
+    Order order(orderID, "stress order " + to_string(orderID), (OrderKind)(rng() % OrderStats::KindCount),
+                chrono::system_clock::now() + chrono::hours(1 + rng() % 500));
+    order.customerID = 1 + (int)(rng() % CustomerCount);
+    order.status = (OrderStatus)(rng() % OrderStats::StatusCount);
+    if (rng() % 2) order.editorAssigned = editorName(rng() % EditorCount);
+    return order;
+}
+
+// Checks one snapshot; returns a description of the first problem, or ""
+static string checkSnapshot(const OrderSnapshot& view) {
+    size_t count = 0;
+    int lastID = 0;
+    int byStatus[OrderStats::StatusCount] = {};
+    int byEditor[EditorCount] = {};
+    int openByEditor[EditorCount] = {};
+    int byCustomer[CustomerCount + 1] = {};
+    map<int, int> batches;
+    for (const auto& order : view.orders) {
+        if (count > 0 && order->orderID <= lastID) return "orders out of order at " + to_string(order->orderID);
+        if (order->version > view.version) return "order " + to_string(order->orderID) + " newer than its snapshot";
+        lastID = order->orderID;
+        count++;
+        byStatus[(int)order->status]++;
+        if (!order->editorAssigned.empty()) {
+            int e = atoi(order->editorAssigned.c_str() + 7);
+            byEditor[e]++;
+            if (order->status == OrderStatus::Pending || order->status == OrderStatus::InProgress) openByEditor[e]++;
+        }
+        byCustomer[order->customerID]++;
+        if (order->orderID >= BatchBase) batches[(order->orderID - BatchBase) / BatchSize]++;
+    }
+
+    const OrderStats& stats = view.stats;
+    if (count != view.orders.size()) return "size() disagrees with iteration";
+    if (stats.total() != (int)count) return "stats total " + to_string(stats.total()) + " for " + to_string(count) + " orders";
+    for (int s = 0; s < OrderStats::StatusCount; ++s) {
+        if (stats.countByStatus((OrderStatus)s) != byStatus[s]) return "status count mismatch";
+    }
+    for (int e = 0; e < EditorCount; ++e) {
+        if (stats.countForEditor(editorName(e)) != byEditor[e]) return "editor count mismatch for " + editorName(e);
+        if (stats.openForEditor(editorName(e)) != openByEditor[e]) return "open count mismatch for " + editorName(e);
+    }
+    for (int c = 1; c <= CustomerCount; ++c) {
+        if (stats.countForCustomer(c) != byCustomer[c]) return "customer count mismatch for " + to_string(c);
+    }
+    for (const auto& batch : batches) {
+        if (batch.second != BatchSize) return "bulk import " + to_string(batch.first) + " partly visible";
+    }
+    return "";
+}
+
+static uint64_t fingerprint(const OrderSnapshot& view) {
+    uint64_t hash = view.version;
+    for (const auto& order : view.orders) {
+        hash = hash * 1000003 + (uint64_t)order->orderID;
+        hash = hash * 1000003 + order->version;
+        hash = hash * 1000003 + (uint64_t)order->status;
+    }
+    return hash;
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        const char* value = argv[i + 1];
+        if (flag == "--orders") options.orders = atoi(value);
+        else if (flag == "--readers") options.readers = atoi(value);
+        else if (flag == "--seconds") options.seconds = atof(value);
+        else if (flag == "--seed") options.seed = (unsigned)atoi(value);
+        else return false;
+    }
+    return argc % 2 == 1 && options.orders >= 0 && options.readers > 0 && options.seconds > 0;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        cerr << "Usage: desainin-snapstress [--orders n] [--readers n] [--seconds s] [--seed s]" << endl;
+        return 1;
+    }
+
+    OrderManager manager;
+    mt19937 rng(options.seed);
+    vector<int> live;   // single orders the writer may edit or delete
+    {
+        vector<Order> initial;
+        vector<size_t> rejected;
+        for (int id = 1; id <= options.orders; ++id) {
+            initial.push_back(makeOrder(id, rng));
+            live.push_back(id);
+        }
+        manager.addOrders(initial, rejected);
+    }
+    cout << options.orders << " orders, " << options.readers << " readers, " << options.seconds << " s" << endl;
+
+    atomic<bool> finished{ false };
+    atomic<long> checked{ 0 };
+    atomic<long> failures{ 0 };
+    mutex reportMutex;
+    vector<thread> readers;
+    for (int r = 0; r < options.readers; ++r) {
+        readers.emplace_back([&]() {
+            // Every few rounds, hold on to a snapshot and make sure the
+            // writes since then left it untouched
+            shared_ptr<const OrderSnapshot> held;
+            uint64_t heldPrint = 0;
+            for (long round = 0; !finished; ++round) {
+                shared_ptr<const OrderSnapshot> view = manager.snapshot();
+                string problem = checkSnapshot(*view);
+                if (problem.empty() && held && fingerprint(*held) != heldPrint) problem = "held snapshot changed";
+                if (!problem.empty()) {
+                    lock_guard<mutex> lock(reportMutex);
+                    if (failures++ < 10) cerr << "version " << view->version << ": " << problem << endl;
+                }
+                if (round % 8 == 0) {
+                    held = view;
+                    heldPrint = fingerprint(*held);
+                }
+                checked++;
+            }
+        });
+    }
+
+    LatencyHistogram writes;
+    long batches = 0;
+    int nextID = options.orders + 1;
+    Clock::time_point start = Clock::now();
+    Clock::time_point stopAt = start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(options.seconds));
+    while (Clock::now() < stopAt) {
+        int op = rng() % 100;
+        size_t pick = live.empty() ? 0 : rng() % live.size();
+        int orderID = live.empty() ? 0 : live[pick];
+        Clock::time_point began = Clock::now();
+        if (op < 25 || live.empty()) {
+            manager.addOrder(makeOrder(nextID, rng));
+            live.push_back(nextID++);
+        } else if (op < 50) {
+            manager.updateStatus(orderID, (OrderStatus)(rng() % OrderStats::StatusCount));
+        } else if (op < 70) {
+            manager.assignEditor(orderID, editorName(rng() % EditorCount));
+        } else if (op < 80) {
+            manager.modifyOrder(orderID, "renamed " + to_string(rng() % 1000), OrderKind::Other,
+                                chrono::system_clock::now() + chrono::hours(24), "ref", "extras");
+        } else if (op < 95) {
+            // Replicated removals take the same path as deletes, without the console output
+            ReplicatedOrder removal{ true, Order(orderID, "", OrderKind::Other, chrono::system_clock::time_point()) };
+            manager.applyReplicated({ removal });
+            swap(live[pick], live.back());
+            live.pop_back();
+        } else {
+            vector<Order> batch;
+            vector<size_t> rejected;
+            for (int i = 0; i < BatchSize; ++i) batch.push_back(makeOrder(BatchBase + (int)batches * BatchSize + i, rng));
+            manager.addOrders(batch, rejected);
+            batches++;
+        }
+        writes.record((uint64_t)chrono::duration_cast<chrono::nanoseconds>(Clock::now() - began).count());
+    }
+    double elapsed = chrono::duration<double>(Clock::now() - start).count();
+    finished = true;
+    for (auto& reader : readers) reader.join();
+
+    string problem = checkSnapshot(*manager.snapshot());
+    if (!problem.empty()) {
+        cerr << "final snapshot: " << problem << endl;
+        failures++;
+    }
+    cout << (long)(writes.count() / elapsed) << " writes/s (" << batches << " bulk imports)  " << writes.summary() << endl;
+    cout << checked.load() << " snapshots checked, " << failures.load() << " inconsistent" << endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+// Bulk order import and export for savedata.txt, so migrating data no longer
+// means editing the save file by hand.
+//
+//   g++ -std=c++17 -O2 -pthread transfer_main.cpp modular/*.cpp -o desainin-transfer
+//   (add -lws2_32 on Windows)
+//
+//   desainin-transfer import orders.csv|orders.jsonl [--data savedata.txt]
+//   desainin-transfer export orders.csv|orders.jsonl [--data savedata.txt]
+//
+// The format follows the extension. CSV files hold ORDER rows exactly as
+// savedata.txt does; JSON Lines files hold one object per order (see
+// OrderTransfer.hpp). Import keeps every valid row, lists the rejected ones
+// by line number and saves the result back to the data file.
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "modular/OrderManager.hpp"
+#include "modular/UserManager.hpp"
+#include "modular/SaveManager.hpp"
+#include "modular/OrderTransfer.hpp"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    string dataFile = "savedata.txt";
+    if (argc == 5 && strcmp(argv[3], "--data") == 0) dataFile = argv[4];
+    bool importing = argc >= 3 && strcmp(argv[1], "import") == 0;
+    bool exporting = argc >= 3 && strcmp(argv[1], "export") == 0;
+    if ((argc != 3 && argc != 5) || (!importing && !exporting)) {
+        cerr << "Usage: desainin-transfer import|export file.csv|file.jsonl [--data savedata.txt]" << endl;
+        return 1;
+    }
+    string path = argv[2];
+
+    OrderManager manager;
+    UserManager userManager;
+    SaveManager::loadFromFile(dataFile, manager, userManager);
+
+    if (exporting) {
+        size_t written = 0;
+        if (!OrderTransfer::exportFile(path, manager, written)) return 1;
+        cout << "Exported " << written << " order(s) to " << path << endl;
+        return 0;
+    }
+
+    ImportReport report;
+    if (!OrderTransfer::importFile(path, manager, report)) return 1;
+    for (const auto& error : report.errors) {
+        cerr << path << ":" << error.line << ": " << error.message << endl;
+    }
+    if (report.errorCount > report.errors.size()) {
+        cerr << "... and " << (report.errorCount - report.errors.size()) << " more error(s)" << endl;
+    }
+    cout << "Imported " << report.imported << " order(s) from " << report.lines << " line(s) in "
+         << report.seconds << " s, " << report.errorCount << " rejected, " << report.skipped << " skipped" << endl;
+    if (report.imported > 0 && !SaveManager::saveToFile(dataFile, manager, userManager)) return 1;
+    return report.errorCount ? 2 : 0;
+}